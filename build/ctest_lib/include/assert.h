@@ -0,0 +1,374 @@
+#ifndef _CTEST_ASSERT_H
+#define _CTEST_ASSERT_H
+//Includes: 
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "globals.h"
+#include "alloc_hooks.h"
+#include "std_assert_macros.h"
+
+//Constants:
+#define MAX_CHARS 4096 //The maximum number of chars for a message.
+#define CTEST_BATCH_SIZE 1024 //Expectations buffered by a batch before they are evaluated (see batch_assert.c).
+#define MAX_DIGEST_HEX_SIZE 65 //Chars of the hexadecimal string of a digest, with the '\0' (see digest_assert.c).
+#define STREAM_NO_MISMATCH ((size_t) -1) //Returned by ctest_stream_get_mismatch_offset() if the stream matches so far.
+#define MAX_MATRIX_MISMATCHES 8 //Mismatches of a matrix assertion listed in the details of its fail (see matrix_assert.c).
+
+
+//Declarations of structs:
+struct assert_result_struct
+{
+	bool was_successful;
+	int line_number;
+	char *result_details; //Buffer of MAX_CHARS chars returned by get_result_details_buffer().
+	char *assert_name;
+	char *std_message;
+	char *custom_message;
+};
+
+
+typedef struct assert_result_struct assert_result_struct;
+
+
+typedef struct
+{
+	const char *assert_name; //NULL if the slot is free.
+	int line_number;
+	unsigned long long num_of_hits;
+	unsigned long long num_of_passes;
+	unsigned long long num_of_fails;
+	unsigned long long num_of_ignored;
+	unsigned long long total_ns; //Time spent inside the assertions of the site (see assert_stats.c).
+} assert_site_stats;
+
+
+typedef enum
+{
+	WITH_STDOUT_EQUAL,
+	WITH_STDERR_EQUAL,
+	WITH_STREAM_OUT_EQUAL,
+	WITH_EXIT_STATUS_EQUAL,
+	WITH_EXIT_STATUS_NOT_EQUAL,
+	WITH_SIGNAL_EQUAL,
+	WITH_MAX_ALLOCATIONS,
+	WITH_MAX_BYTES_ALLOCATED
+} with_assert_type;
+
+struct with_assert_struct
+{
+	with_assert_type type;
+	bool is_open;            //true between the begin and the end of the block.
+	bool is_capturing;       //false if the block is ignored.
+	int line_number;
+	char *custom_message;
+	char *expected_content;
+	FILE **stream_address;   //Address of the variable with the captured stream.
+	FILE *original_stream;   //Stream replaced by the open_memstream stream.
+	int target_fd;           //Captured file descriptor (-1 if open_memstream is used).
+	int saved_fd;            //Copy of the original 'target_fd'.
+	int capture_fd;          //memfd that receives the captured bytes.
+	char *memstream_buffer;
+	size_t memstream_size;
+	int reference_value;     //Exit status or signal number of the block.
+	bool is_child;           //true in the process that executes the body of the block.
+	pid_t child_pid;
+	int results_fd;          //Pipe used to send the results of the child to the parent.
+	size_t max_value;        //Maximum number of allocations or bytes of the block.
+	alloc_counters_struct initial_alloc_counters; //Counters of the thread at the beginning of the block.
+};
+
+typedef struct with_assert_struct with_assert_struct;
+
+
+typedef enum
+{
+	BATCH_UNSIGNED_INTEGER_EQUAL,
+	BATCH_UNSIGNED_INTEGER_NOT_EQUAL,
+	BATCH_UNSIGNED_INTEGER_GREATER,
+	BATCH_UNSIGNED_INTEGER_GREATER_EQUAL,
+	BATCH_UNSIGNED_INTEGER_LESS,
+	BATCH_UNSIGNED_INTEGER_LESS_EQUAL,
+	BATCH_INTEGER_EQUAL,                 //The BATCH_INTEGER_* operations are in the same order.
+	BATCH_INTEGER_NOT_EQUAL,
+	BATCH_INTEGER_GREATER,
+	BATCH_INTEGER_GREATER_EQUAL,
+	BATCH_INTEGER_LESS,
+	BATCH_INTEGER_LESS_EQUAL,
+	NUM_OF_BATCH_OPS
+} batch_op;
+
+typedef enum
+{
+	DIGEST_FAST128, //128-bit tree of MurmurHash3 leaves (32 hexadecimal digits).
+	DIGEST_SHA256   //SHA-256 (64 hexadecimal digits).
+} digest_algorithm;
+
+typedef struct
+{
+	digest_algorithm algorithm;
+	unsigned long long num_of_bytes; //Bytes given to digest_update().
+	unsigned char block[64];         //Bytes of the last block, not hashed yet.
+	size_t block_size;
+	uint64_t leaf_hash[2];           //DIGEST_FAST128: hash of the current leaf.
+	uint64_t root_hash[2];           //DIGEST_FAST128: hash of the digests of the complete leaves.
+	uint32_t sha256_state[8];        //DIGEST_SHA256.
+} ctest_digest;
+
+typedef enum
+{
+	STREAM_SOURCE_MEMORY,
+	STREAM_SOURCE_FILE,
+	STREAM_SOURCE_GENERATOR
+} stream_source_type;
+
+typedef struct
+{
+	stream_source_type type;
+	const void *reference; //STREAM_SOURCE_MEMORY: the reference bytes.
+	size_t reference_size; //STREAM_SOURCE_MEMORY: the number of reference bytes.
+	const char *path;      //STREAM_SOURCE_FILE: the reference file, mapped by ctest_stream_begin().
+	size_t (*generate)(void *buffer, size_t size, size_t offset, void *arg); //STREAM_SOURCE_GENERATOR (see stream_source_generator).
+	void *arg;             //STREAM_SOURCE_GENERATOR: the argument of 'generate'.
+} ctest_stream_source;
+
+typedef struct
+{
+	const void *data;   //Element (0, 0).
+	size_t num_of_rows;
+	size_t num_of_cols;
+	size_t row_stride;  //Elements from (i, j) to (i + 1, j): the leading dimension of a row-major matrix.
+	size_t col_stride;  //Elements from (i, j) to (i, j + 1): the leading dimension of a column-major matrix.
+} ctest_matrix_view;
+
+
+
+//Declaration of auxiliary functions:
+char *get_result_details_buffer();
+void print_assert_result(const assert_result_struct *assert_result);
+bool failure_details_are_needed(const assert_result_struct *assert_result);
+void reset_failure_sites();
+void report_suppressed_failures();
+void merge_assert_results(char results[], size_t num_of_results);
+void assert_stats_start_suite();
+void assert_stats_mark_start();
+void assert_stats_record(const char assert_name[], int line_number, char status);
+void assert_stats_end_suite();
+size_t parallel_find_first(size_t begin, size_t end, size_t (*find)(size_t begin, size_t end, const void *arg), const void *arg);
+void parallel_for(size_t begin, size_t end, size_t min_chunk_size, void (*run)(size_t begin, size_t end, const void *arg), const void *arg);
+
+
+//Declaration of functions:
+/*WITH assert blocks (see std_assert_macros.h)*/
+bool with_assert_stdout_equal_begin         (with_assert_struct *with_assert, char expected_content[], int line_number, char custom_message[]);
+bool with_assert_stderr_equal_begin         (with_assert_struct *with_assert, char expected_content[], int line_number, char custom_message[]);
+bool with_assert_stream_out_equal_begin     (with_assert_struct *with_assert, FILE **stream_address, char expected_content[], int line_number, char custom_message[]);
+bool with_assert_exit_status_equal_begin    (with_assert_struct *with_assert, int expected_status, int line_number, char custom_message[]);
+bool with_assert_exit_status_notEqual_begin (with_assert_struct *with_assert, int unexpected_status, int line_number, char custom_message[]);
+bool with_assert_signal_equal_begin         (with_assert_struct *with_assert, int expected_signal, int line_number, char custom_message[]);
+bool with_assert_max_allocations_begin      (with_assert_struct *with_assert, size_t max_allocations, int line_number, char custom_message[]);
+bool with_assert_max_bytesAllocated_begin   (with_assert_struct *with_assert, size_t max_bytes, int line_number, char custom_message[]);
+void with_assert_end                        (with_assert_struct *with_assert);
+void with_assert_cleanup                    (with_assert_struct *with_assert);
+void with_assert_abort_captures             ();
+
+/*Batched assertions (see std_assert_macros.h)*/
+void batch_begin  ();
+void batch_expect (batch_op op, unsigned_integer target, unsigned_integer reference, int line_number);
+void batch_end    (int line_number, char custom_message[]);
+void batch_abort  ();
+
+/*Digests (see digest_assert.c)*/
+void digest_init   (ctest_digest *digest, digest_algorithm algorithm);
+void digest_update (ctest_digest *digest, const void *data, size_t size);
+void digest_final  (ctest_digest *digest, char hex_digest[MAX_DIGEST_HEX_SIZE]);
+void assert_digest_equal                      (ctest_digest *digest, const char expected_digest[], int line_number, char custom_message[]);
+void assert_buffer_digestEqual                (const void *target, size_t target_size, const char expected_digest[], int line_number, char custom_message[]);
+void assert_unsigned_integerArray_digestEqual (unsigned_integer target[], size_t target_size, const char expected_digest[], int line_number, char custom_message[]);
+
+/*Streaming assertions (see stream_assert.c)*/
+ctest_stream_source stream_source_memory    (const void *reference, size_t reference_size);
+ctest_stream_source stream_source_file      (const char path[]);
+ctest_stream_source stream_source_generator (size_t (*generate)(void *buffer, size_t size, size_t offset, void *arg), void *arg);
+void   ctest_stream_begin               (ctest_stream_source source);
+void   ctest_stream_feed                (const void *chunk, size_t chunk_size);
+size_t ctest_stream_get_mismatch_offset ();
+void   ctest_stream_end                 (int line_number, char custom_message[]);
+void   ctest_stream_abort               ();
+
+/*Matrices (see std_assert_macros.h for the views)*/
+void assert_unsigned_integerMatrix_equal     (ctest_matrix_view target, ctest_matrix_view reference, int line_number, char custom_message[]);
+void assert_integerMatrix_equal              (ctest_matrix_view target, ctest_matrix_view reference, int line_number, char custom_message[]);
+void assert_floating_pointMatrix_almostEqual (ctest_matrix_view target, ctest_matrix_view reference, floating_point max_diff, int line_number, char custom_message[]);
+
+/*Single data type*/
+/*STD assert functions for unsigned_integer type*/
+void assert_unsigned_integer_equal        (unsigned_integer target, unsigned_integer reference, int line_number, char custom_message[]);
+void assert_unsigned_integer_notEqual     (unsigned_integer target, unsigned_integer reference, int line_number, char custom_message[]);
+void assert_unsigned_integer_greater      (unsigned_integer target, unsigned_integer reference, int line_number, char custom_message[]);
+void assert_unsigned_integer_greaterEqual (unsigned_integer target, unsigned_integer reference, int line_number, char custom_message[]);
+void assert_unsigned_integer_less         (unsigned_integer target, unsigned_integer reference, int line_number, char custom_message[]);
+void assert_unsigned_integer_lessEqual    (unsigned_integer target, unsigned_integer reference, int line_number, char custom_message[]);
+void assert_unsigned_integer_bitMaskEqual (unsigned_integer target, unsigned_integer reference, unsigned_integer mask, int line_number, char custom_message[]);
+
+/*STD assert functions for integer type*/
+void assert_integer_equal        (integer target, integer reference, int line_number, char custom_message[]);
+void assert_integer_notEqual     (integer target, integer reference, int line_number, char custom_message[]);
+void assert_integer_greater      (integer target, integer reference, int line_number, char custom_message[]);
+void assert_integer_greaterEqual (integer target, integer reference, int line_number, char custom_message[]);
+void assert_integer_less         (integer target, integer reference, int line_number, char custom_message[]);
+void assert_integer_lessEqual    (integer target, integer reference, int line_number, char custom_message[]);
+
+/*STD assert functions for floating_point type*/
+void assert_floating_point_almostEqual    (floating_point target, floating_point reference, floating_point max_diff, int line_number, char custom_message[]);
+void assert_floating_point_notAlmostEqual (floating_point target, floating_point reference, floating_point min_diff, int line_number, char custom_message[]);
+void assert_floating_point_greater        (floating_point target, floating_point reference, int line_number, char custom_message[]);
+void assert_floating_point_greaterEqual   (floating_point target, floating_point reference, int line_number, char custom_message[]);
+void assert_floating_point_less           (floating_point target, floating_point reference, int line_number, char custom_message[]);
+void assert_floating_point_lessEqual      (floating_point target, floating_point reference, int line_number, char custom_message[]);
+
+/*STD assert functions for bool type*/
+void assert_bool_equal    (bool target, bool reference, int line_number, char custom_message[]);
+void assert_bool_notEqual (bool target, bool reference, int line_number, char custom_message[]);
+void assert_bool_true     (bool target, int line_number, char custom_message[]);
+void assert_bool_false    (bool target, int line_number, char custom_message[]);
+
+/*STD assert functions for char type*/
+void assert_char_equal        (char target, char reference, bool ingnore_case, int line_number, char custom_message[]);
+void assert_char_notEqual     (char target, char reference, bool ingnore_case, int line_number, char custom_message[]);
+void assert_char_greater      (char target, char reference, bool ingnore_case, int line_number, char custom_message[]);
+void assert_char_greaterEqual (char target, char reference, bool ingnore_case, int line_number, char custom_message[]);
+void assert_char_less         (char target, char reference, bool ingnore_case, int line_number, char custom_message[]);
+void assert_char_lessEqual    (char target, char reference, bool ingnore_case, int line_number, char custom_message[]);
+
+
+/*STD assert functions for files*/
+void assert_files_binaryContentEqual           (char target_file_path[], char reference_file_path[], int line_number, char custom_message[]);
+void assert_files_contentEqual                 (char target_file_path[], char reference_file_path[], bool ignore_case, int line_number, char custom_message[]);
+void assert_file_path_contentEqual             (char target_file_path[], char reference_content[], bool ignore_case, int line_number, char custom_message[]);
+
+/*STD assert functions for void pointers*/
+void assert_pointer_isNULL    (void *target, int line_number, char custom_message[]);
+void assert_pointer_notIsNULL (void *target, int line_number, char custom_message[]);
+
+/*Arrays data type*/
+/*STD assert functions for unsigned_integerArray type*/
+void assert_unsigned_integerArray_equal                    (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notEqual                 (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_sorted                   (unsigned_integer target[], size_t target_size, bool ascending_order,  int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notSorted                (unsigned_integer target[], size_t target_size, bool ascending_order,  int line_number, char custom_message[]);
+void assert_unsigned_integerArray_permutation              (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notPermutation           (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_isPartialPermutation     (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notIsPartialPermutation  (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_hasPartialPermutation    (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notHasPartialPermutation (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_setEqual                 (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_setIn                    (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notSetIn                 (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_setHas                   (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notSetHas                (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_isSubarray               (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notIsSubarray            (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_hasSubarray              (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_unsigned_integerArray_notHasSubarray           (unsigned_integer target[], size_t target_size, unsigned_integer reference[], size_t reference_size, int line_number, char custom_message[]);
+
+
+/*STD assert functions for integerArray type*/
+void assert_integerArray_equal                    (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_notEqual                 (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_sorted                   (integer target[], size_t target_size, bool ascending_order,  int line_number, char custom_message[]);
+void assert_integerArray_notSorted                (integer target[], size_t target_size, bool ascending_order,  int line_number, char custom_message[]);
+void assert_integerArray_permutation              (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_notPermutation           (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_isPartialPermutation     (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_notIsPartialPermutation  (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_hasPartialPermutation    (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_notHasPartialPermutation (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_setEqual                 (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_setIn                    (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_notSetIn                 (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_setHas                   (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_notSetHas                (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_isSubarray               (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_notIsSubarray            (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_hasSubarray              (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_integerArray_notHasSubarray           (integer target[], size_t target_size, integer reference[], size_t reference_size, int line_number, char custom_message[]);
+
+
+/*STD assert functions for boolArray type*/
+void assert_boolArray_equal                    (bool target[], size_t target_size, bool reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_boolArray_notEqual                 (bool target[], size_t target_size, bool reference[], size_t reference_size, int line_number, char custom_message[]);
+void assert_boolArray_allTrue                  (bool target[], size_t target_size, int line_number, char custom_message[]);
+void assert_boolArray_anyFalse                 (bool target[], size_t target_size, int line_number, char custom_message[]);
+void assert_boolArray_allFalse                 (bool target[], size_t target_size, int line_number, char custom_message[]);
+void assert_boolArray_anyTrue                  (bool target[], size_t target_size, int line_number, char custom_message[]);
+
+
+
+
+/*STD assert functions for charArray type*/
+void assert_charArray_equal                    (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notEqual                 (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_sorted                   (char target[], size_t target_size, bool ascending_order,  bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notSorted                (char target[], size_t target_size, bool ascending_order,  bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_permutation              (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notPermutation           (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_isPartialPermutation     (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notIsPartialPermutation  (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_hasPartialPermutation    (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notHasPartialPermutation (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_setEqual                 (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_setIn                    (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notSetIn                 (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_setHas                   (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notSetHas                (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_isSubarray               (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notIsSubarray            (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_hasSubarray              (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+void assert_charArray_notHasSubarray           (char target[], size_t target_size, char reference[], size_t reference_size, bool ingnore_case, int line_number, char custom_message[]);
+
+
+/*STD assert functions for string type*/
+void assert_string_equal                    (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notEqual                 (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_greater                  (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_greaterEqual             (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_less                     (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_lessEqual                (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_sizeEqual                (char target[], size_t reference_size, int line_number, char custom_message[]);
+void assert_string_notSizeEqual             (char target[], size_t reference_size, int line_number, char custom_message[]);
+void assert_string_sizeGreater              (char target[], size_t reference_size, int line_number, char custom_message[]);
+void assert_string_sizeGreaterEqual         (char target[], size_t reference_size, int line_number, char custom_message[]);
+void assert_string_sizeLess                 (char target[], size_t reference_size, int line_number, char custom_message[]);
+void assert_string_sizeLessEqual            (char target[], size_t reference_size, int line_number, char custom_message[]);
+void assert_string_hasChar                  (char target[], char reference_char, bool ignore_case, int line_number, char custom_message[]);
+void assert_string_notHasChar               (char target[], char reference_char, bool ignore_case, int line_number, char custom_message[]);
+void assert_string_sameSize                 (char target[], char reference[], int line_number, char custom_message[]);
+void assert_string_equal                    (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notEqual                 (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_sorted                   (char target[], bool ascending_order,  bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notSorted                (char target[], bool ascending_order,  bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_permutation              (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notPermutation           (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_isPartialPermutation     (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notIsPartialPermutation  (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_hasPartialPermutation    (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notHasPartialPermutation (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_setEqual                 (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_setIn                    (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notSetIn                 (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_setHas                   (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notSetHas                (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_isSubarray               (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notIsSubarray            (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_hasSubarray              (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_notHasSubarray           (char target[], char reference[], bool ingnore_case, int line_number, char custom_message[]);
+void assert_string_empty                    (char target[], int line_number, char custom_message[]);
+void assert_string_notEmpty                 (char target[], int line_number, char custom_message[]);
+
+
+
+#endif
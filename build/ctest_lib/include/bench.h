@@ -0,0 +1,278 @@
+#ifndef _CTEST_BENCH_H
+#define _CTEST_BENCH_H
+
+//Includes:
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "globals.h"
+
+//Macros:
+#define MAX_BENCH_NAME 64        //Maximum number of chars per benchmark name.
+#define MAX_BENCH_SAMPLES 1000   //Maximum number of samples per benchmark.
+#define MAX_COMPLEXITY_SIZES 64  //Maximum number of sizes per ASSERT_COMPLEXITY.
+#define MAX_LATENCY_THREADS 64   //Threads alive at once with their own histogram per latency recorder (the others share one).
+
+/**
+ * Description: This macro executes its body many times and prints the time per
+ * iteration. The number of iterations per sample is calibrated, so each sample
+ * takes at least 'bench_config.min_sample_time' seconds. After the calibration,
+ * the body is warmed up for 'bench_config.warmup_time' seconds and then
+ * 'bench_config.num_of_samples' samples are measured. The min, median, mean,
+ * MAD (median absolute deviation) and p99 of the time per iteration are printed.
+ * It must be used inside a module:
+ *
+ * 	CTEST_BENCH("Sum of the array")
+ * 	{
+ * 		CTEST_BENCH_SET_BYTES(sizeof array); //Optional: prints bytes/s.
+ * 		ctest_do_not_optimize(sum_array(array, size));
+ * 	}
+ *
+ * The body is executed inside a loop: 'break' ends only the current sample.
+ */
+#define CTEST_BENCH(NAME) \
+	for(bench_struct ctest_bench = {.name = (NAME), .line_number = __LINE__}; bench_next_sample(&ctest_bench);)\
+		for(size_t ctest_bench_iteration = ctest_bench.iterations; ctest_bench_iteration > 0; ctest_bench_iteration--)
+
+/**
+ * Description: These macros set, inside the body of CTEST_BENCH, the number of
+ * bytes or items processed by one iteration. They enable the throughput report.
+ */
+#define CTEST_BENCH_SET_BYTES(NUM_OF_BYTES) (ctest_bench.bytes_per_iteration = (NUM_OF_BYTES))
+#define CTEST_BENCH_SET_ITEMS(NUM_OF_ITEMS) (ctest_bench.items_per_iteration = (NUM_OF_ITEMS))
+
+/**
+ * Description: This macro compares the speed of two implementations of the same
+ * operation, 'void A_FN(void *input)' and 'void B_FN(void *input)', on the same
+ * INPUT. The samples of A and B are interleaved (ABBAAB...), so frequency
+ * scaling and cache effects affect both in the same way. The speedup of B over
+ * A (time of A / time of B) is printed with its 95% confidence interval. The
+ * result may be checked with ASSERT_FASTER_BY.
+ */
+#define CTEST_BENCH_COMPARE(A_FN, B_FN, INPUT) bench_compare(#A_FN, (A_FN), #B_FN, (B_FN), (void *) (INPUT), __LINE__)
+
+/**
+ * Description: This macro asserts that, in the last CTEST_BENCH_COMPARE, B was 
+ * faster than A by at least MIN_RATIO (the lower bound of the confidence
+ * interval of the speedup must be greater or equal to MIN_RATIO).
+ */
+#define ASSERT_FASTER_BY(MIN_RATIO) assert_bench_fasterBy((MIN_RATIO), __LINE__, NULL)
+
+/**
+ * Description: This macro asserts that the last CTEST_BENCH executed less than
+ * MAX_INSTRUCTIONS instructions per item (see CTEST_BENCH_SET_ITEMS). The 
+ * benchmark must be measured with the performance counters (see 
+ * 'bench_config.perf_counters'). If the kernel forbids the hardware counters,
+ * the result is ignored.
+ */
+#define ASSERT_INSTRUCTIONS_PER_ITEM_LESS(MAX_INSTRUCTIONS) assert_bench_instructionsPerItemLess((MAX_INSTRUCTIONS), __LINE__, NULL)
+
+/**
+ * Description: This macro asserts that the running time of 'void FN(void *input,
+ * size_t n)' grows at most like BOUND (a complexity_class, e.g. COMPLEXITY_O_N).
+ * FN is timed for n = MIN_N, 2*MIN_N, 4*MIN_N, ..., up to MAX_N and the times
+ * are fitted to the models O(1), O(log n), O(n), O(n log n), O(n^2) and O(n^3).
+ * The assertion fails if the best fit is worse than BOUND.
+ */
+#define ASSERT_COMPLEXITY(FN, INPUT, MIN_N, MAX_N, BOUND) assert_complexity((FN), (void *) (INPUT), (MIN_N), (MAX_N), (BOUND), __LINE__, NULL)
+
+/**
+ * Description: This macro executes its body once and records its duration in
+ * the latency recorder REC (a ctest_latency_recorder *):
+ *
+ * 	CTEST_LATENCY_MEASURE(recorder)
+ * 	{
+ * 		handle_request(&request);
+ * 	}
+ *
+ * 'break' ends the body (its duration is recorded too).
+ */
+#define CTEST_LATENCY_MEASURE(REC) \
+	for(uint64_t ctest_latency_start = latency_get_time_ns(), ctest_latency_done = 0; !ctest_latency_done; ctest_latency_done = 1, latency_recorder_record((REC), latency_get_time_ns() - ctest_latency_start))\
+		for(; !ctest_latency_done; ctest_latency_done = 1)
+
+/**
+ * Description: ctest_do_not_optimize() forces the compiler to compute VALUE,
+ * even if it is not used. ctest_clobber_memory() forces the compiler to write
+ * every pending store to memory (the memory is treated as read and written).
+ */
+#define ctest_do_not_optimize(VALUE) __asm__ volatile("" : : "r,m"(VALUE) : "memory")
+#define ctest_clobber_memory() __asm__ volatile("" : : : "memory")
+
+//Definition of types:
+typedef enum
+{
+	BENCH_CALIBRATION,
+	BENCH_WARMUP,
+	BENCH_MEASUREMENT,
+	BENCH_FINISHED
+} bench_phase;
+
+typedef enum
+{
+	COMPLEXITY_O_1,
+	COMPLEXITY_O_LOG_N,
+	COMPLEXITY_O_N,
+	COMPLEXITY_O_N_LOG_N,
+	COMPLEXITY_O_N2,
+	COMPLEXITY_O_N3
+} complexity_class;
+
+typedef enum
+{
+	PERF_COUNTER_INSTRUCTIONS,
+	PERF_COUNTER_CYCLES,
+	PERF_COUNTER_CACHE_MISSES,
+	PERF_COUNTER_BRANCH_MISSES,
+	PERF_COUNTER_PAGE_FAULTS,
+	PERF_COUNTER_CONTEXT_SWITCHES,
+	NUM_OF_PERF_COUNTERS
+} perf_counter_id;
+
+typedef struct {
+	double min_sample_time; //Minimum duration of one sample (seconds).
+	double warmup_time;     //Duration of the warmup (seconds).
+	size_t num_of_samples;  //Number of measured samples (at most MAX_BENCH_SAMPLES).
+	char *baseline_path;    //Baseline file. If NULL, the environment variable CTEST_BENCH_BASELINE is used.
+	bool update_baseline;   //Store the results instead of comparing. Also set by CTEST_BENCH_UPDATE_BASELINE=1.
+	double max_p_value;     //Significance level of the Mann-Whitney U test.
+	double max_slowdown;    //Tolerated increase of the median (0.05 --> 5%).
+	bool perf_counters;     //Measure modules and benchmarks with perf_event_open. Also set by CTEST_PERF_COUNTERS=1.
+	bool noise_control;     //Pin the thread and discard the samples with context switches. Also set by CTEST_BENCH_NOISE_CONTROL=1.
+	int cpu;                //CPU of the noise control mode (-1: automatic). If -1, CTEST_BENCH_CPU is used, if set.
+	bool raise_priority;    //Set the nice value to -20 in the noise control mode (needs CAP_SYS_NICE).
+} bench_config_struct;
+
+typedef struct {
+	bool is_available[NUM_OF_PERF_COUNTERS]; //false if the kernel does not allow the counter.
+	uint64_t values[NUM_OF_PERF_COUNTERS];
+} ctest_perf_counters;
+
+typedef struct {
+	bool is_open;
+	int fds[NUM_OF_PERF_COUNTERS];              //-1 if the counter is not available.
+	int leader_fds[2];                          //Hardware and software groups (-1 if empty).
+	int members[2][NUM_OF_PERF_COUNTERS];       //Counters of each group, in the order of opening.
+	size_t num_of_members[2];
+} perf_group_struct;
+
+typedef struct {
+	char name[MAX_BENCH_NAME];
+	int line_number;
+	size_t num_of_samples;
+	size_t iterations_per_sample;
+	double min;                        //Seconds per iteration.
+	double median;                     //Seconds per iteration.
+	double mean;                       //Seconds per iteration.
+	double mad;                        //Median absolute deviation (seconds per iteration).
+	double p99;                        //Seconds per iteration.
+	double bytes_per_second;           //0 if CTEST_BENCH_SET_BYTES was not used.
+	double items_per_second;           //0 if CTEST_BENCH_SET_ITEMS was not used.
+	size_t items_per_iteration;        //0 if CTEST_BENCH_SET_ITEMS was not used.
+	bool has_perf_counters;            //Says if 'perf' was measured.
+	ctest_perf_counters perf;          //Totals of the samples, discarded ones included (see bench_get_perf_iterations()).
+	size_t num_of_discarded;           //Samples discarded by the noise control mode.
+	int cpu;                           //CPU of the noise control mode (-1 if the thread was not pinned).
+	double samples[MAX_BENCH_SAMPLES]; //Seconds per iteration of each sample, sorted.
+} ctest_bench_stats;
+
+typedef struct {
+	char a_name[MAX_BENCH_NAME];
+	char b_name[MAX_BENCH_NAME];
+	int line_number;
+	size_t num_of_samples;  //Pairs of samples (one of A and one of B).
+	size_t a_iterations;    //Iterations per sample of A.
+	size_t b_iterations;    //Iterations per sample of B.
+	double a_median;        //Seconds per call of A.
+	double b_median;        //Seconds per call of B.
+	double speedup;         //Median of the ratios (time of A / time of B) of the pairs.
+	double speedup_low;     //Lower bound of the 95% confidence interval of the speedup.
+	double speedup_high;    //Upper bound of the 95% confidence interval of the speedup.
+	size_t num_of_discarded; //Pairs discarded by the noise control mode.
+	int cpu;                 //CPU of the noise control mode (-1 if the thread was not pinned).
+} ctest_bench_comparison;
+
+typedef struct {
+	int line_number;
+	size_t num_of_sizes;
+	size_t sizes[MAX_COMPLEXITY_SIZES];
+	double times[MAX_COMPLEXITY_SIZES];   //Median seconds per call of each size.
+	double coefficients[COMPLEXITY_O_N3 + 1]; //c of t(n) = c * f(n), for each model.
+	double errors[COMPLEXITY_O_N3 + 1];   //Median of |ln(t / (c * f(n)))| of each model.
+	complexity_class best_fit;
+	size_t num_of_discarded;              //Samples discarded by the noise control mode.
+} ctest_complexity_fit;
+
+typedef struct {
+	bool was_found;         //Says if the baseline has an entry for the benchmark and this machine.
+	bool was_updated;       //Says if the entry was written (update mode).
+	bool is_regression;
+	size_t num_of_samples;  //Samples of the baseline.
+	double median;          //Median of the baseline (seconds per iteration).
+	double ratio;           //Current median / baseline median.
+	double p_value;         //One-sided p-value: probability of a slowdown this large by chance.
+} bench_baseline_result_struct;
+
+typedef struct {
+	char *name;
+	int line_number;
+	bench_phase phase;
+	size_t iterations;          //Iterations of the current sample.
+	size_t bytes_per_iteration;
+	size_t items_per_iteration;
+	double start_time;          //Time of the first call (trace).
+	double sample_start_time;
+	double warmup_end_time;
+	double min_iteration_time;  //Fastest iteration seen before the measurement.
+	size_t num_of_samples;
+	double samples[MAX_BENCH_SAMPLES];
+	bool has_perf_counters;
+	perf_group_struct perf_group;   //Open during the measurement, if the counters are enabled.
+	ctest_perf_counters perf;
+	uint64_t sample_start_switches; //Context switches at the start of the sample (noise control mode).
+	size_t num_of_discarded;
+	int cpu;
+} bench_struct;
+
+typedef struct ctest_latency_recorder ctest_latency_recorder; //Defined in bench_latency.c.
+
+//Declare global variables:
+extern bench_config_struct bench_config;
+
+//Declaration of functions:
+bool bench_next_sample(bench_struct *bench);
+const ctest_bench_stats *get_last_bench_stats();
+double bench_get_time();
+int bench_compare_doubles(const void *a, const void *b);
+double bench_get_sorted_median(const double sorted_values[], size_t num_of_values);
+void bench_compare(char a_name[], void (*a_fn)(void *), char b_name[], void (*b_fn)(void *), void *input, int line_number);
+const ctest_bench_comparison *get_last_bench_comparison();
+void assert_bench_fasterBy(double min_ratio, int line_number, char custom_message[]);
+void assert_complexity(void (*fn)(void *, size_t), void *input, size_t min_n, size_t max_n, complexity_class bound, int line_number, char custom_message[]);
+const ctest_complexity_fit *get_last_complexity_fit();
+char *complexity_to_str(complexity_class complexity);
+ctest_latency_recorder *latency_recorder_create();
+void latency_recorder_delete(ctest_latency_recorder *recorder);
+void latency_recorder_reset(ctest_latency_recorder *recorder);
+void latency_recorder_record(ctest_latency_recorder *recorder, uint64_t nanoseconds);
+uint64_t latency_recorder_count(ctest_latency_recorder *recorder);
+uint64_t latency_recorder_percentile(ctest_latency_recorder *recorder, double percentile);
+uint64_t latency_get_time_ns();
+void assert_latency_percentileLess(ctest_latency_recorder *recorder, double percentile, uint64_t max_nanoseconds, int line_number, char custom_message[]);
+bool perf_counters_are_enabled();
+void perf_group_start(perf_group_struct *group);
+void perf_group_stop(perf_group_struct *group, ctest_perf_counters *counters);
+void perf_print_counters(FILE *file, const ctest_perf_counters *counters, double num_of_iterations);
+double bench_get_perf_iterations(const ctest_bench_stats *stats);
+void assert_bench_instructionsPerItemLess(double max_instructions, int line_number, char custom_message[]);
+bool bench_noise_is_enabled();
+void bench_noise_begin();
+void bench_noise_end();
+void bench_noise_abort();
+int bench_noise_get_cpu();
+uint64_t bench_noise_get_switches();
+bool bench_noise_discard_sample(uint64_t start_switches, size_t *num_of_discarded, size_t max_discarded);
+void bench_check_baseline(const ctest_bench_stats *stats, bench_baseline_result_struct *result);
+void bench_report_baseline(const ctest_bench_stats *stats, const bench_baseline_result_struct *result);
+#endif
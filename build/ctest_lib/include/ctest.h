@@ -0,0 +1,10 @@
+#ifndef _CTEST_CTEST_H
+#define _CTEST_CTEST_H
+
+#include "ctest_functions.h"
+#include "assert.h"
+#include "bench.h"
+#include "alloc_hooks.h"
+#include "reporter.h"
+
+#endif
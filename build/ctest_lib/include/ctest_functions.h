@@ -0,0 +1,111 @@
+#ifndef _CTEST_CTEST_FUNCTIONS_H
+#define _CTEST_CTEST_FUNCTIONS_H
+
+#include "globals.h"
+#include "bench.h"
+#include <sys/types.h>
+#include <setjmp.h>
+#include <signal.h>
+
+//Macros:
+#define MAX_NAME 32          //Maximum number of chars per name.
+#define MAX_DESCRIPTION 1024 //Maximum number of chars per description.
+#define NUM_OF_SLOWEST_MODULES 5 //Number of modules listed by the summary of the suite.
+#define NUM_OF_ASSERT_HOTSPOTS 10 //Number of sites listed by the console if the assert stats are collected.
+
+/**
+ * Description: After this call, each module of the current suite is executed by
+ * a copy-on-write child of the process, so the fixture built before the call is
+ * shared by every module and a module can not corrupt the state seen by the next
+ * one. The results of the child are merged into 'ctest_info'. The modules must
+ * be written as:
+ *
+ * 	CTEST_FIXTURE_CHECKPOINT();
+ * 	if(start_module("Name", "Description.", func_ids))
+ * 	{
+ * 		//Body of the module.
+ * 	}
+ * 	end_module();
+ *
+ * The checkpoint is released by end_suite().
+ */
+#define CTEST_FIXTURE_CHECKPOINT() fixture_checkpoint()
+
+/**
+ * Description: This macro starts a module like start_module(), but crashes are
+ * contained in the process: if the body receives SIGSEGV, SIGBUS, SIGFPE or
+ * SIGABRT, the module is recorded as crashed (one fail, with the signal and the
+ * line of the last assertion) and the execution goes on from end_module(). It 
+ * avoids the cost of a fork per module. Local variables of the caller changed 
+ * inside the body must be volatile to be read after a crash. The modules must be
+ * written as:
+ *
+ * 	CTEST_MODULE("Name", "Description.", func_ids)
+ * 	{
+ * 		//Body of the module.
+ * 	}
+ * 	end_module();
+ *
+ * It may be used with CTEST_FIXTURE_CHECKPOINT().
+ */
+#define CTEST_MODULE(NAME, DESCRIPTION, FUNC_IDS) \
+	if(sigsetjmp(suite_ctest_info.crash_jump_buffer, 1) != 0) record_module_crash();\
+	else if(start_contained_module((NAME), (DESCRIPTION), (FUNC_IDS)))
+
+//Definition of types:
+typedef struct {
+	char module_name[MAX_NAME];
+	double wall_time;   //Seconds between start_module() and end_module() (CLOCK_MONOTONIC).
+	double cpu_time;    //Seconds of CPU used by the module, including its child processes.
+	long long heap_delta; //Live heap bytes at end_module() minus at start_module() (0 without the allocation hooks).
+	size_t peak_rss;      //Peak resident set size (bytes) of the process that executed the module.
+	ctest_perf_counters perf; //Counters of the thread that executed the module (none available if they are disabled).
+	int num_of_results;
+	int num_of_fails;
+	int num_of_ignored;
+} ctest_module_stats;
+
+typedef struct {
+	char suite_progress[MAX_RESULTS + 1];
+	char suite_name[MAX_NAME];
+	char module_name[MAX_NAME];
+	int num_of_suite_results;
+	int num_of_suite_fails;
+	int num_of_suite_ignored;
+	bool is_checkpoint_set;  //Says if the modules are executed by child processes.
+	bool is_module_child;    //Says if this process is the child that executes a module.
+	pid_t module_child_pid;  //The child that executes the current module (parent only).
+	int module_results_fd;   //Read end of the pipe with the results of the child.
+	sigjmp_buf crash_jump_buffer;            //Set by CTEST_MODULE.
+	volatile sig_atomic_t is_crash_jump_set; //Says if a crash returns to 'crash_jump_buffer'.
+	volatile sig_atomic_t crash_signal;      //Signal received by the crashed module.
+	double suite_start_wall_time;
+	double suite_start_cpu_time;
+	double module_start_wall_time;
+	double module_start_cpu_time;
+	long long module_start_heap;             //Live heap bytes at start_module().
+	long long module_heap_delta;
+	size_t module_peak_rss;
+	perf_group_struct module_perf_group;     //Open during the module, if the counters are enabled.
+	ctest_perf_counters module_perf;
+	bool fail_on_leak;                       //If true (or CTEST_FAIL_ON_LEAK=1), a module whose heap grew receives one fail.
+	ctest_module_stats *modules_stats;       //Stats of the ended modules of the suite.
+	size_t num_of_modules;
+	size_t modules_stats_capacity;
+} suite_ctest_info_struct;
+
+
+//Declare global variables:
+extern suite_ctest_info_struct suite_ctest_info;
+
+//Declaration of functions:
+void start_suite(char *name, char *description, char *func_ids[]);
+void end_suite();
+bool start_module(char *name, char *description, char *func_ids[]);
+void end_module();
+void fixture_checkpoint();
+bool start_contained_module(char *name, char *description, char *func_ids[]);
+void record_module_crash();
+ctest_module_stats get_last_module_stats();
+const ctest_module_stats *get_suite_modules_stats(size_t *num_of_modules);
+#endif
@@ -0,0 +1,80 @@
+#ifndef _CTEST_CTEST_LOG_H
+#define _CTEST_CTEST_LOG_H
+
+//Includes:
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Description: Format of the binary result log (written by the reporter of
+ * reporter_binlog.c and read by ctest_log.c). The file is a sequence of entries
+ * of LOG_ENTRY_SIZE bytes; the integers are little-endian and an id is the
+ * index of the entry that defines the object (so a child process may define
+ * objects without a table shared with its parent). The first byte of an entry
+ * is its kind, except in the header, in the data of a string and in the trailer:
+ * 	header:     "CTESTLOG", u16 version, u16 entry size, u32 0;
+ * 	string:     kind, 3 x 0, u32 length, u64 0; followed by the chars and a '\0'
+ * 	            in ceil((length + 1) / LOG_ENTRY_SIZE) entries;
+ * 	suite:      kind, 3 x 0, u32 name id, u64 0;
+ * 	module:     kind, 3 x 0, u32 name id, u32 suite id, u32 0;
+ * 	result:     kind, u8 status, u16 0, u32 line, u32 assert name id, u32 module
+ * 	            id (the suite id outside modules);
+ * 	failure:    kind, 3 x 0, u32 std message id, u32 custom message id (0 if
+ * 	            none), u32 details id; it follows the result of a fail or error;
+ * 	module end/suite end (3 entries): kind, 3 x 0, u32 id, u32 results, u32 fails;
+ * 	            u32 ignored, u32 0, f64 wall time; f64 cpu time, u64 peak RSS;
+ * 	index:      kind, 3 x 0, u32 module/suite id, u32 first entry, u32 entry of
+ * 	            the end (the results of the module are between them);
+ * 	trailer:    "CTESTIDX", u32 first index entry, u32 number of index entries.
+ * The index and the trailer are written at the end of the run, in the order in
+ * which the modules and the suites ended.
+ */
+#define LOG_ENTRY_SIZE 16
+#define LOG_VERSION 1
+#define LOG_MAGIC "CTESTLOG"
+#define LOG_TRAILER_MAGIC "CTESTIDX"
+#define LOG_NOT_FOUND ((size_t) -1)
+
+//Definition of types:
+typedef enum {
+	LOG_STRING = 1,
+	LOG_SUITE,
+	LOG_MODULE,
+	LOG_RESULT,
+	LOG_FAILURE,
+	LOG_MODULE_END,
+	LOG_SUITE_END,
+	LOG_INDEX
+} log_entry_kind;
+
+typedef struct ctest_log ctest_log; //Defined in ctest_log.c.
+
+typedef struct {
+	const char *module_name;
+	const char *suite_name;
+	int num_of_results;
+	int num_of_fails;
+	int num_of_ignored;
+	double wall_time;
+	double cpu_time;
+	size_t peak_rss;
+} ctest_log_module;
+
+typedef struct {
+	const char *assert_name;
+	const char *std_message;    //NULL if the result did not fail.
+	const char *custom_message; //NULL if the result did not fail or has no custom message.
+	const char *details;        //NULL if the result did not fail.
+	int line_number;
+	char status;                //'.', 'F', 'I' or 'E' (see reporter.h).
+} ctest_log_result;
+
+//Declaration of functions:
+ctest_log *ctest_log_open(char path[]);
+void ctest_log_close(ctest_log *log);
+size_t ctest_log_get_num_of_modules(const ctest_log *log);
+ctest_log_module ctest_log_get_module(const ctest_log *log, size_t index);
+size_t ctest_log_find_module(const ctest_log *log, const char module_name[]);
+size_t ctest_log_for_each_result(const ctest_log *log, size_t index, char status, void (*callback)(const ctest_log_result *result, void *arg), void *arg);
+void ctest_log_print_summary(const ctest_log *log);
+#endif
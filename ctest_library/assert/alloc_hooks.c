@@ -0,0 +1,145 @@
+/**
+ * Title: ALLOC HOOKS
+ */
+
+/**
+ * Description: This file contains the state of the allocation hooks, which
+ * count the calls of malloc, calloc, realloc and free of each thread (used by
+ * WITH_ASSERT_MAX_ALLOCATIONS and WITH_ASSERT_MAX_BYTES_ALLOCATED).
+ *     The hooks are opt-in: they are the __wrap_* functions of alloc_wrap.c,
+ * which are used only if the test is linked with CTEST_ALLOC_HOOKS_LINK_FLAGS
+ * (ld --wrap). Otherwise alloc_wrap.o is not even taken from ctest.a, and
+ * alloc_hooks_are_active() returns false.
+ *     The allocations of ctest itself are not counted: the source files of the
+ * library include internal_alloc.h, which replaces malloc, calloc, realloc and
+ * free by the ctest_internal_* functions below. They increment
+ * 'alloc_internal_depth' of the thread around the call, and the hooks ignore
+ * the calls made while it is positive. Allocations made by the C library
+ * itself (e.g. strdup, fopen) are not seen by --wrap.
+ *     The hooks also keep the live heap of the process (used by the memory
+ * report of the modules): the usable size of each block is added when it is
+ * allocated and subtracted when it is freed, whoever made the call, since a
+ * block allocated by ctest may be freed by the test (e.g. merge_str).
+ */
+
+//Includes:
+#include "alloc_hooks.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+//Define global variables:
+_Thread_local alloc_counters_struct alloc_thread_counters;
+_Thread_local int alloc_internal_depth = 0;
+long long alloc_live_bytes = 0;
+
+//Weak reference: it is not NULL only if alloc_wrap.o was linked (see the description of this file).
+extern void *__wrap_malloc(size_t size) __attribute__((weak));
+
+
+//Function definitions:
+bool alloc_hooks_are_active()
+/**
+ * Description: This function says if the test was linked with the allocation
+ * hooks (CTEST_ALLOC_HOOKS_LINK_FLAGS).
+ *
+ * Input: (void)
+ *
+ * Output: (bool) --> true if the allocations are counted.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return __wrap_malloc != NULL;
+}
+
+
+alloc_counters_struct get_alloc_counters()
+/**
+ * Description: This function returns the allocation counters of the calling
+ * thread. They only grow: the allocations of a region are the difference of
+ * the counters before and after it.
+ *
+ * Input: (void)
+ *
+ * Output: (alloc_counters_struct) --> The counters (always 0 if the hooks are
+ *         not active).
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return alloc_thread_counters;
+}
+
+
+long long get_live_heap_bytes()
+/**
+ * Description: This function returns the bytes of the heap blocks allocated 
+ * and not freed by every thread of the process (usable sizes, as returned by
+ * malloc_usable_size). The calls made by ctest itself are not counted, like in
+ * the counters of the threads. The blocks allocated by the C library itself
+ * are not seen, so freeing them in the test (e.g. the result of strdup)
+ * decreases the value.
+ *
+ * Input: (void)
+ *
+ * Output: (long long) --> The live bytes (always 0 if the hooks are not active).
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return __atomic_load_n(&alloc_live_bytes, __ATOMIC_RELAXED);
+}
+
+
+/**
+ * Description: These functions are used by ctest instead of malloc, calloc,
+ * realloc and free (see internal_alloc.h). They behave exactly like them, but
+ * the call is not counted by the allocation hooks.
+ *
+ * Time Complexity: The same of the replaced function.
+ *
+ * Space Complexity: The same of the replaced function.
+ */
+void *ctest_internal_malloc(size_t size)
+{
+	void *ptr;
+
+	alloc_internal_depth++;
+	ptr = malloc(size);
+	alloc_internal_depth--;
+	return ptr;
+}
+
+
+void *ctest_internal_calloc(size_t num_of_elements, size_t size)
+{
+	void *ptr;
+
+	alloc_internal_depth++;
+	ptr = calloc(num_of_elements, size);
+	alloc_internal_depth--;
+	return ptr;
+}
+
+
+void *ctest_internal_realloc(void *ptr, size_t size)
+{
+	alloc_internal_depth++;
+	ptr = realloc(ptr, size);
+	alloc_internal_depth--;
+	return ptr;
+}
+
+
+void ctest_internal_free(void *ptr)
+{
+	alloc_internal_depth++;
+	free(ptr);
+	alloc_internal_depth--;
+}
@@ -0,0 +1,36 @@
+#ifndef _CTEST_ALLOC_HOOKS_H
+#define _CTEST_ALLOC_HOOKS_H
+
+//Includes:
+#include <stdlib.h>
+#include <stdbool.h>
+
+//Macros:
+/**
+ * Description: Linker flags that enable the allocation hooks (see
+ * alloc_hooks.c). They must be used when the test is linked:
+ * 	cc test.c ctest.a -lm -pthread -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ */
+#define CTEST_ALLOC_HOOKS_LINK_FLAGS "-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free"
+
+//Definition of types:
+typedef struct {
+	size_t num_of_allocations; //Calls of malloc, calloc and realloc (with size > 0).
+	size_t bytes_allocated;    //Bytes requested by those calls.
+	size_t num_of_frees;       //Calls of free with a pointer that is not NULL.
+} alloc_counters_struct;
+
+//Declare global variables:
+extern _Thread_local alloc_counters_struct alloc_thread_counters;
+extern _Thread_local int alloc_internal_depth;
+extern long long alloc_live_bytes; //Usable bytes of the live blocks of every thread (atomic).
+
+//Declaration of functions:
+bool alloc_hooks_are_active();
+alloc_counters_struct get_alloc_counters();
+long long get_live_heap_bytes();
+void *ctest_internal_malloc(size_t size);
+void *ctest_internal_calloc(size_t num_of_elements, size_t size);
+void *ctest_internal_realloc(void *ptr, size_t size);
+void ctest_internal_free(void *ptr);
+#endif
@@ -0,0 +1,105 @@
+/**
+ * Title: ALLOC WRAP
+ */
+
+/**
+ * Description: This file contains the allocation hooks: the functions that
+ * replace malloc, calloc, realloc and free when the test is linked with
+ * CTEST_ALLOC_HOOKS_LINK_FLAGS (ld --wrap=malloc makes every call of malloc call
+ * __wrap_malloc, and __real_malloc call the original malloc). Each hook counts
+ * the call in the counters of the thread, unless it was made by ctest itself
+ * (see alloc_hooks.c), and calls the original function. The live heap of the
+ * process ('alloc_live_bytes') is updated by the same calls: the blocks of ctest
+ * (e.g. the table of the failure sites or the buffers of the trace) and the
+ * blocks of the C library freed by ctest (e.g. the buffer of open_memstream)
+ * are not charged to the module.
+ *     This file must stay in its own object file: it is only taken from ctest.a
+ * when --wrap is used, since __real_* does not exist otherwise.
+ */
+
+//Includes:
+#include "alloc_hooks.h"
+#include <stdlib.h>
+#include <malloc.h>
+
+//Original functions (resolved by ld --wrap):
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t num_of_elements, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+//Local auxiliary functions:
+static void add_live_bytes(long long bytes);
+
+
+//Function definitions:
+void *__wrap_malloc(size_t size)
+{
+	void *ptr;
+
+	if(alloc_internal_depth == 0)
+	{
+		alloc_thread_counters.num_of_allocations++;
+		alloc_thread_counters.bytes_allocated += size;
+	}
+	ptr = __real_malloc(size);
+	if(ptr != NULL) add_live_bytes(malloc_usable_size(ptr));
+	return ptr;
+}
+
+
+void *__wrap_calloc(size_t num_of_elements, size_t size)
+{
+	void *ptr;
+
+	if(alloc_internal_depth == 0)
+	{
+		alloc_thread_counters.num_of_allocations++;
+		alloc_thread_counters.bytes_allocated += num_of_elements * size;
+	}
+	ptr = __real_calloc(num_of_elements, size);
+	if(ptr != NULL) add_live_bytes(malloc_usable_size(ptr));
+	return ptr;
+}
+
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	size_t old_size = ptr != NULL ? malloc_usable_size(ptr) : 0;
+	void *new_ptr;
+
+	if(alloc_internal_depth == 0)
+	{
+		if(size > 0)
+		{
+			alloc_thread_counters.num_of_allocations++;
+			alloc_thread_counters.bytes_allocated += size;
+		}
+		else if(ptr != NULL) alloc_thread_counters.num_of_frees++;
+	}
+	new_ptr = __real_realloc(ptr, size);
+	if(new_ptr != NULL) add_live_bytes((long long) malloc_usable_size(new_ptr) - (long long) old_size);
+	else if(size == 0) add_live_bytes(-(long long) old_size); //realloc(ptr, 0) freed 'ptr'.
+	return new_ptr;
+}
+
+
+void __wrap_free(void *ptr)
+{
+	if(ptr == NULL) return;
+	if(alloc_internal_depth == 0) alloc_thread_counters.num_of_frees++;
+	add_live_bytes(-(long long) malloc_usable_size(ptr));
+	__real_free(ptr);
+}
+
+
+//Definitions of the local auxiliary functions:
+static void add_live_bytes(long long bytes)
+/**
+ * Description: This function adds 'bytes' to the live heap of the process, if
+ * the call was not made by ctest itself.
+ */
+{
+	if(alloc_internal_depth > 0) return;
+	__atomic_fetch_add(&alloc_live_bytes, bytes, __ATOMIC_RELAXED);
+}
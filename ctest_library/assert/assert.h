@@ -3,11 +3,19 @@
 //Includes: 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
 #include "globals.h"
+#include "alloc_hooks.h"
 #include "std_assert_macros.h"
 
 //Constants:
 #define MAX_CHARS 4096 //The maximum number of chars for a message.
+#define CTEST_BATCH_SIZE 1024 //Expectations buffered by a batch before they are evaluated (see batch_assert.c).
+#define MAX_DIGEST_HEX_SIZE 65 //Chars of the hexadecimal string of a digest, with the '\0' (see digest_assert.c).
+#define STREAM_NO_MISMATCH ((size_t) -1) //Returned by ctest_stream_get_mismatch_offset() if the stream matches so far.
+#define MAX_MATRIX_MISMATCHES 8 //Mismatches of a matrix assertion listed in the details of its fail (see matrix_assert.c).
 
 
 //Declarations of structs:
@@ -15,7 +23,7 @@ struct assert_result_struct
 {
 	bool was_successful;
 	int line_number;
-	char result_details[MAX_CHARS];
+	char *result_details; //Buffer of MAX_CHARS chars returned by get_result_details_buffer().
 	char *assert_name;
 	char *std_message;
 	char *custom_message;
@@ -25,12 +33,176 @@ struct assert_result_struct
 typedef struct assert_result_struct assert_result_struct;
 
 
+typedef struct
+{
+	const char *assert_name; //NULL if the slot is free.
+	int line_number;
+	unsigned long long num_of_hits;
+	unsigned long long num_of_passes;
+	unsigned long long num_of_fails;
+	unsigned long long num_of_ignored;
+	unsigned long long total_ns; //Time spent inside the assertions of the site (see assert_stats.c).
+} assert_site_stats;
+
+
+typedef enum
+{
+	WITH_STDOUT_EQUAL,
+	WITH_STDERR_EQUAL,
+	WITH_STREAM_OUT_EQUAL,
+	WITH_EXIT_STATUS_EQUAL,
+	WITH_EXIT_STATUS_NOT_EQUAL,
+	WITH_SIGNAL_EQUAL,
+	WITH_MAX_ALLOCATIONS,
+	WITH_MAX_BYTES_ALLOCATED
+} with_assert_type;
+
+struct with_assert_struct
+{
+	with_assert_type type;
+	bool is_open;            //true between the begin and the end of the block.
+	bool is_capturing;       //false if the block is ignored.
+	int line_number;
+	char *custom_message;
+	char *expected_content;
+	FILE **stream_address;   //Address of the variable with the captured stream.
+	FILE *original_stream;   //Stream replaced by the open_memstream stream.
+	int target_fd;           //Captured file descriptor (-1 if open_memstream is used).
+	int saved_fd;            //Copy of the original 'target_fd'.
+	int capture_fd;          //memfd that receives the captured bytes.
+	char *memstream_buffer;
+	size_t memstream_size;
+	int reference_value;     //Exit status or signal number of the block.
+	bool is_child;           //true in the process that executes the body of the block.
+	pid_t child_pid;
+	int results_fd;          //Pipe used to send the results of the child to the parent.
+	size_t max_value;        //Maximum number of allocations or bytes of the block.
+	alloc_counters_struct initial_alloc_counters; //Counters of the thread at the beginning of the block.
+};
+
+typedef struct with_assert_struct with_assert_struct;
+
+
+typedef enum
+{
+	BATCH_UNSIGNED_INTEGER_EQUAL,
+	BATCH_UNSIGNED_INTEGER_NOT_EQUAL,
+	BATCH_UNSIGNED_INTEGER_GREATER,
+	BATCH_UNSIGNED_INTEGER_GREATER_EQUAL,
+	BATCH_UNSIGNED_INTEGER_LESS,
+	BATCH_UNSIGNED_INTEGER_LESS_EQUAL,
+	BATCH_INTEGER_EQUAL,                 //The BATCH_INTEGER_* operations are in the same order.
+	BATCH_INTEGER_NOT_EQUAL,
+	BATCH_INTEGER_GREATER,
+	BATCH_INTEGER_GREATER_EQUAL,
+	BATCH_INTEGER_LESS,
+	BATCH_INTEGER_LESS_EQUAL,
+	NUM_OF_BATCH_OPS
+} batch_op;
+
+typedef enum
+{
+	DIGEST_FAST128, //128-bit tree of MurmurHash3 leaves (32 hexadecimal digits).
+	DIGEST_SHA256   //SHA-256 (64 hexadecimal digits).
+} digest_algorithm;
+
+typedef struct
+{
+	digest_algorithm algorithm;
+	unsigned long long num_of_bytes; //Bytes given to digest_update().
+	unsigned char block[64];         //Bytes of the last block, not hashed yet.
+	size_t block_size;
+	uint64_t leaf_hash[2];           //DIGEST_FAST128: hash of the current leaf.
+	uint64_t root_hash[2];           //DIGEST_FAST128: hash of the digests of the complete leaves.
+	uint32_t sha256_state[8];        //DIGEST_SHA256.
+} ctest_digest;
+
+typedef enum
+{
+	STREAM_SOURCE_MEMORY,
+	STREAM_SOURCE_FILE,
+	STREAM_SOURCE_GENERATOR
+} stream_source_type;
+
+typedef struct
+{
+	stream_source_type type;
+	const void *reference; //STREAM_SOURCE_MEMORY: the reference bytes.
+	size_t reference_size; //STREAM_SOURCE_MEMORY: the number of reference bytes.
+	const char *path;      //STREAM_SOURCE_FILE: the reference file, mapped by ctest_stream_begin().
+	size_t (*generate)(void *buffer, size_t size, size_t offset, void *arg); //STREAM_SOURCE_GENERATOR (see stream_source_generator).
+	void *arg;             //STREAM_SOURCE_GENERATOR: the argument of 'generate'.
+} ctest_stream_source;
+
+typedef struct
+{
+	const void *data;   //Element (0, 0).
+	size_t num_of_rows;
+	size_t num_of_cols;
+	size_t row_stride;  //Elements from (i, j) to (i + 1, j): the leading dimension of a row-major matrix.
+	size_t col_stride;  //Elements from (i, j) to (i, j + 1): the leading dimension of a column-major matrix.
+} ctest_matrix_view;
+
+
 
 //Declaration of auxiliary functions:
-void print_assert_result(assert_result_struct assert_result);
+char *get_result_details_buffer();
+void print_assert_result(const assert_result_struct *assert_result);
+bool failure_details_are_needed(const assert_result_struct *assert_result);
+void reset_failure_sites();
+void report_suppressed_failures();
+void merge_assert_results(char results[], size_t num_of_results);
+void assert_stats_start_suite();
+void assert_stats_mark_start();
+void assert_stats_record(const char assert_name[], int line_number, char status);
+void assert_stats_end_suite();
+size_t parallel_find_first(size_t begin, size_t end, size_t (*find)(size_t begin, size_t end, const void *arg), const void *arg);
+void parallel_for(size_t begin, size_t end, size_t min_chunk_size, void (*run)(size_t begin, size_t end, const void *arg), const void *arg);
 
 
 //Declaration of functions:
+/*WITH assert blocks (see std_assert_macros.h)*/
+bool with_assert_stdout_equal_begin         (with_assert_struct *with_assert, char expected_content[], int line_number, char custom_message[]);
+bool with_assert_stderr_equal_begin         (with_assert_struct *with_assert, char expected_content[], int line_number, char custom_message[]);
+bool with_assert_stream_out_equal_begin     (with_assert_struct *with_assert, FILE **stream_address, char expected_content[], int line_number, char custom_message[]);
+bool with_assert_exit_status_equal_begin    (with_assert_struct *with_assert, int expected_status, int line_number, char custom_message[]);
+bool with_assert_exit_status_notEqual_begin (with_assert_struct *with_assert, int unexpected_status, int line_number, char custom_message[]);
+bool with_assert_signal_equal_begin         (with_assert_struct *with_assert, int expected_signal, int line_number, char custom_message[]);
+bool with_assert_max_allocations_begin      (with_assert_struct *with_assert, size_t max_allocations, int line_number, char custom_message[]);
+bool with_assert_max_bytesAllocated_begin   (with_assert_struct *with_assert, size_t max_bytes, int line_number, char custom_message[]);
+void with_assert_end                        (with_assert_struct *with_assert);
+void with_assert_cleanup                    (with_assert_struct *with_assert);
+void with_assert_abort_captures             ();
+
+/*Batched assertions (see std_assert_macros.h)*/
+void batch_begin  ();
+void batch_expect (batch_op op, unsigned_integer target, unsigned_integer reference, int line_number);
+void batch_end    (int line_number, char custom_message[]);
+void batch_abort  ();
+
+/*Digests (see digest_assert.c)*/
+void digest_init   (ctest_digest *digest, digest_algorithm algorithm);
+void digest_update (ctest_digest *digest, const void *data, size_t size);
+void digest_final  (ctest_digest *digest, char hex_digest[MAX_DIGEST_HEX_SIZE]);
+void assert_digest_equal                      (ctest_digest *digest, const char expected_digest[], int line_number, char custom_message[]);
+void assert_buffer_digestEqual                (const void *target, size_t target_size, const char expected_digest[], int line_number, char custom_message[]);
+void assert_unsigned_integerArray_digestEqual (unsigned_integer target[], size_t target_size, const char expected_digest[], int line_number, char custom_message[]);
+
+/*Streaming assertions (see stream_assert.c)*/
+ctest_stream_source stream_source_memory    (const void *reference, size_t reference_size);
+ctest_stream_source stream_source_file      (const char path[]);
+ctest_stream_source stream_source_generator (size_t (*generate)(void *buffer, size_t size, size_t offset, void *arg), void *arg);
+void   ctest_stream_begin               (ctest_stream_source source);
+void   ctest_stream_feed                (const void *chunk, size_t chunk_size);
+size_t ctest_stream_get_mismatch_offset ();
+void   ctest_stream_end                 (int line_number, char custom_message[]);
+void   ctest_stream_abort               ();
+
+/*Matrices (see std_assert_macros.h for the views)*/
+void assert_unsigned_integerMatrix_equal     (ctest_matrix_view target, ctest_matrix_view reference, int line_number, char custom_message[]);
+void assert_integerMatrix_equal              (ctest_matrix_view target, ctest_matrix_view reference, int line_number, char custom_message[]);
+void assert_floating_pointMatrix_almostEqual (ctest_matrix_view target, ctest_matrix_view reference, floating_point max_diff, int line_number, char custom_message[]);
+
 /*Single data type*/
 /*STD assert functions for unsigned_integer type*/
 void assert_unsigned_integer_equal        (unsigned_integer target, unsigned_integer reference, int line_number, char custom_message[]);
@@ -1,23 +1,87 @@
 #include "assert.h"
 #include "globals.h"
 #include "text_formatting.h"
+#include "ctest_trace.h"
+#include "reporter.h"
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Macros:
+#define SUPPRESSED_FAIL 'f' //Sent to the parent process for a fail that was only counted.
+
+//Definition of types:
+typedef struct {
+	const char *assert_name; //NULL if the slot is free.
+	int line_number;
+	int num_of_fails;
+} failure_site;
 
 //Define global variables:
 int verbose = HIGH;
 bool ignore = false;
+int result_pipe_fd = -1;
+int max_failures_per_site = 10;
+
+//Local variables:
+static failure_site *failure_sites = NULL; //Open addressing, indexed by hash_failure_site().
+static size_t failure_sites_capacity = 0;  //Power of 2.
+static size_t num_of_failure_sites = 0;
+static failure_site *last_failure_site = NULL; //The last site found, checked first.
+
+//Local auxiliary functions:
+static void count_result(char status);
+static void send_result_to_pipe(char result);
+static failure_site *find_failure_site(const char assert_name[], int line_number);
+static size_t hash_failure_site(const char assert_name[], int line_number);
+static void grow_failure_sites();
 
 
 //Definitions:
 
-void print_assert_result(assert_result_struct assert_result)
+char *get_result_details_buffer()
 /**
- * Description: This function must be called after each assertion. It prints 
- * the result using the stdout stream.
+ * Description: This function returns the buffer for the details of the result
+ * built by the calling thread, emptied. The buffer of each thread is reused by
+ * its next result, so an assertion does not initialize MAX_CHARS chars (only
+ * the fails write the details). It marks the start of the assertion for the
+ * statistics of its site (see assert_stats.c).
  *
  * Input: (void)
  *
+ * Output: (char *) --> The buffer of MAX_CHARS chars, with the empty string.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	static _Thread_local char result_details[MAX_CHARS];
+
+	if(collect_assert_stats) assert_stats_mark_start();
+	result_details[0] = '\0';
+	return result_details;
+}
+
+
+void print_assert_result(const assert_result_struct *assert_result)
+/**
+ * Description: This function must be called after each assertion. It counts 
+ * the result and sends it to the reporters (see reporter.h); the console 
+ * reporter prints it using the stdout stream. If 'verbose' is SILENT, a success
+ * or an ignored result is only counted (the progress is not kept, so a module
+ * may have more than MAX_RESULTS results) and only the fails are reported.
+ *     Only the first 'max_failures_per_site' fails of each site (assert name and
+ * line) of the module are reported; the next ones are only counted (see
+ * report_suppressed_failures()).
+ *     If 'collect_assert_stats' is true, the result is added to the statistics
+ * of its site (see assert_stats.c).
+ *
+ * Input: (const assert_result_struct *) assert_result --> The result.
+ *
  * Output: (void)
  *
  * Time Complexity: -
@@ -25,130 +89,273 @@ void print_assert_result(assert_result_struct assert_result)
  * Space Complexity: -
  */
 {
-	int n, line_length = 80;
-	char *buffer_str;
+	char status;
+	failure_site *site;
 
+	ctest_info.last_line_number = assert_result->line_number;
+	if(ignore) status = REPORT_IGNORED;
+	else if(assert_result->was_successful) status = REPORT_SUCCESS;
+	else status = REPORT_FAIL;
+	if(collect_assert_stats) assert_stats_record(assert_result->assert_name, assert_result->line_number, status);
 
-	//Print the first 'Progress':
-	if(ctest_info.print_progress)
+	if(status == REPORT_FAIL)
 	{
-		fprintf(stdout, "\n>>> Progress: %s", ctest_info.progress);
-		ctest_info.print_progress = false;
+		//A fail beyond 'max_failures_per_site' at the same site is only counted:
+		site = find_failure_site(assert_result->assert_name, assert_result->line_number);
+		site->num_of_fails++;
+		if(max_failures_per_site > 0 && site->num_of_fails > max_failures_per_site)
+		{
+			count_result(REPORT_FAIL);
+			send_result_to_pipe(SUPPRESSED_FAIL);
+			return;
+		}
+		trace_instant_event("failure", assert_result->assert_name, assert_result->line_number);
 	}
 
-	//Check if this result will be ignored:
-	if(ignore)
+	//Silent: the progress is not kept and only the fails are reported:
+	if(verbose == SILENT)
 	{
-		ctest_info.num_of_ignored++;
-		ctest_info.total_ignored++;
-		ctest_info.total_results++;
-		n = fprintf(stdout, "I");
-		if (n < 0)
-		{
-			fprintf(stderr, "Error while printing the result.\n");
-			exit(EXIT_FAILURE);
-		}
-		ctest_info.progress[ctest_info.num_of_results++] = 'I';
-		ctest_info.progress[ctest_info.num_of_results] = '\0';
+		count_result(status);
+		if(status == REPORT_FAIL) reporters_assert(assert_result, status);
+		send_result_to_pipe(status);
 		return;
 	}
 
-	//Handle the result:
-	if (assert_result.was_successful)
+	//Update the progress:
+	if(ctest_info.progress_length >= MAX_RESULTS)
 	{
-		//Print the result:
-		n = fprintf(stdout, ".");
-		if (n < 0)
-		{
-			fprintf(stderr, "Error while printing the result.\n");
-			exit(EXIT_FAILURE);
-		}
-
-		//Update the progress:
-		if(ctest_info.num_of_results > MAX_RESULTS)
-		{
-			fprintf(stderr, "Error: number of results exceeded the maximum allowed.\n");
-			exit(EXIT_FAILURE);
-		}
-		ctest_info.progress[ctest_info.num_of_results++] = '.';
-		ctest_info.progress[ctest_info.num_of_results] = '\0';
+		fprintf(stderr, "Error: number of results exceeded the maximum allowed.\n");
+		exit(EXIT_FAILURE);
 	}
-	else //Fail
-	{
-		//Print the header:
-		n = fprintf(stdout, "F\n\nFAILURE MESSAGE (Assert number %d at LINE %d):\n", ctest_info.num_of_results + 1, assert_result.line_number);
-		if (n < 0)
-		{
-			fprintf(stderr, "Error while printing the header of the result.\n");
-			exit(EXIT_FAILURE);
-		}
+	ctest_info.progress[ctest_info.progress_length++] = status;
+	ctest_info.progress[ctest_info.progress_length] = '\0';
+	count_result(status);
 
-		//Print the assert name:
-		n = fprintf(stdout, "<assert name> --> %s\n", assert_result.assert_name);
-		if (n < 0)
-		{
-			fprintf(stderr, "Error while printing the assert name of the result.\n");
-			exit(EXIT_FAILURE);
-		}
+	reporters_assert(assert_result, status);
+	send_result_to_pipe(status);
+}
 
-		//Print the std message:
-		if(verbose == MEDIUM || verbose == HIGH)
-		{
-			buffer_str = break_line(assert_result.std_message, MAX_CHARS, "<std msg>     --> ", "    ", "", line_length);
-			n = fprintf(stdout, "%s", buffer_str );
-			if (n < 0)
-			{
-				fprintf(stderr, "Error while printing the stantard message of the result.\n");
-				exit(EXIT_FAILURE);
-			}
-			free(buffer_str);
-		}
 
-		//Print the custom message:
-		if(assert_result.custom_message != NULL && (verbose == MEDIUM || verbose == HIGH))
-		{
-			buffer_str = break_line(assert_result.custom_message, MAX_CHARS, "<custom msg>  --> ", "    ", "", line_length);
-			n = fprintf(stdout, "%s", buffer_str);
-			if (n < 0)
-			{
-				fprintf(stderr, "Error while printing the custom message of the result.\n");
-				exit(EXIT_FAILURE);
-			}
-			free(buffer_str);
-		}
+void merge_assert_results(char results[], size_t num_of_results)
+/**
+ * Description: This function adds to the counters of 'ctest_info' the results
+ * made by a child process (see WITH_ASSERT_EXIT_STATUS_EQUAL). Each result is
+ * one char of the progress: '.' (success), 'F' (fail) or 'I' (ignored), or 'f'
+ * for a fail that was only counted (it is not added to the progress). The
+ * results were already printed by the child, so nothing is printed here.
+ *     If this process is a child too, the results are forwarded to its parent.
+ *
+ * Input: (char []) results --> The results read from the child.
+ *        (size_t) num_of_results --> The number of results.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(num_of_results)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+
+	for(i = 0; i < num_of_results; i++)
+	{
+		if(results[i] != '.' && results[i] != 'F' && results[i] != 'I' && results[i] != SUPPRESSED_FAIL) continue;
 
-		//Print the details of the failure:
-		if(verbose == HIGH)
+		//Update the progress:
+		if(verbose != SILENT && results[i] != SUPPRESSED_FAIL)
 		{
-			n = fprintf(stdout, "<details>     -->\n%s", assert_result.result_details);
-			if (n < 0)
+			if(ctest_info.progress_length >= MAX_RESULTS)
 			{
-				fprintf(stderr, "Error while printing the custom message of the result.\n");
+				fprintf(stderr, "Error: number of results exceeded the maximum allowed.\n");
 				exit(EXIT_FAILURE);
 			}
+			ctest_info.progress[ctest_info.progress_length++] = results[i];
+			ctest_info.progress[ctest_info.progress_length] = '\0';
 		}
+		count_result(results[i] == SUPPRESSED_FAIL ? REPORT_FAIL : results[i]);
 
+		//The child has already printed 'Progress':
+		ctest_info.print_progress = false;
+		send_result_to_pipe(results[i]);
+	}
+}
 
 
-		//Update the progress:
-		if(ctest_info.num_of_results > MAX_RESULTS)
-		{
-			fprintf(stderr, "Error: number of results exceeded the maximum allowed.\n");
-			exit(EXIT_FAILURE);
-		}
-		ctest_info.progress[ctest_info.num_of_results++] = 'F';
-		ctest_info.progress[ctest_info.num_of_results] = '\0';
+bool failure_details_are_needed(const assert_result_struct *assert_result)
+/**
+ * Description: This function says if the assertion of 'assert_result' must
+ * generate its details: it failed, 'verbose' is HIGH and the fail will be
+ * reported (it is not beyond 'max_failures_per_site' at its site).
+ *
+ * Input: (const assert_result_struct *) assert_result --> The result, before
+ *        print_assert_result().
+ *
+ * Output: (bool) --> true if the details must be generated.
+ *
+ * Time Complexity: O(1) expected.
+ *
+ * Space Complexity: O(1) amortized.
+ */
+{
+	if(assert_result->was_successful || verbose != HIGH) return false;
+	if(max_failures_per_site <= 0) return true;
+	return find_failure_site(assert_result->assert_name, assert_result->line_number)->num_of_fails < max_failures_per_site;
+}
+
+
+void reset_failure_sites()
+/**
+ * Description: This function forgets the fails counted per site. It is called
+ * by start_suite(), start_module() and by the child of a WITH block.
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(capacity of the table)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(num_of_failure_sites > 0) memset(failure_sites, 0, failure_sites_capacity * sizeof *failure_sites);
+	num_of_failure_sites = 0;
+	last_failure_site = NULL;
+}
+
+
+void report_suppressed_failures()
+/**
+ * Description: This function sends to the reporters the number of fails that
+ * were only counted at each site, e.g. the console prints "(+999,990 more 
+ * failures of assert_integer_equal at LINE 42)". It is called by end_module(),
+ * end_suite() and by the child of a WITH block before it exits.
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(capacity of the table)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+
+	if(max_failures_per_site <= 0 || num_of_failure_sites == 0) return;
+	for(i = 0; i < failure_sites_capacity; i++)
+	{
+		if(failure_sites[i].assert_name == NULL || failure_sites[i].num_of_fails <= max_failures_per_site) continue;
+		reporters_failures_suppressed(failure_sites[i].assert_name, failure_sites[i].line_number, failure_sites[i].num_of_fails - max_failures_per_site);
+	}
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void count_result(char status)
+/**
+ * Description: This function adds a result with 'status' to the counters of the
+ * module and of the execution.
+ */
+{
+	ctest_info.num_of_results++;
+	ctest_info.total_results++;
+	if(status == REPORT_FAIL)
+	{
 		ctest_info.num_of_fails++;
 		ctest_info.total_fails++;
+	}
+	else if(status == REPORT_IGNORED)
+	{
+		ctest_info.num_of_ignored++;
+		ctest_info.total_ignored++;
+	}
+}
+
 
-		//Keep the progress:
-		fprintf(stdout, "\n>>> Progress: %s", ctest_info.progress);
+static void send_result_to_pipe(char result)
+/**
+ * Description: If this process is a child that runs the body of a WITH_ASSERT
+ * block, this function sends 'result' to the parent process. The output is
+ * flushed first, so it is not lost if the child is killed by a signal.
+ */
+{
+	if(result_pipe_fd < 0) return;
+
+	fflush(stdout);
+	if(write(result_pipe_fd, &result, 1) != 1)
+	{
+		fprintf(stderr, "Error while sending the result to the parent process.\n");
+		exit(EXIT_FAILURE);
 	}
+}
 
-	//Increment total results:
-	ctest_info.total_results++;
+
+static failure_site *find_failure_site(const char assert_name[], int line_number)
+/**
+ * Description: This function returns the site of 'assert_name' at 'line_number',
+ * adding it to the table if it is new.
+ */
+{
+	size_t i;
+
+	if(last_failure_site != NULL && last_failure_site->line_number == line_number && (last_failure_site->assert_name == assert_name || strcmp(last_failure_site->assert_name, assert_name) == 0))
+		return last_failure_site;
+
+	if(2 * (num_of_failure_sites + 1) > failure_sites_capacity) grow_failure_sites();
+	for(i = hash_failure_site(assert_name, line_number); failure_sites[i].assert_name != NULL; i = (i + 1) & (failure_sites_capacity - 1))
+	{
+		if(failure_sites[i].line_number == line_number && strcmp(failure_sites[i].assert_name, assert_name) == 0) break;
+	}
+	if(failure_sites[i].assert_name == NULL)
+	{
+		failure_sites[i] = (failure_site) {.assert_name = assert_name, .line_number = line_number, .num_of_fails = 0};
+		num_of_failure_sites++;
+	}
+	last_failure_site = &failure_sites[i];
+	return last_failure_site;
 }
 
 
+static size_t hash_failure_site(const char assert_name[], int line_number)
+/**
+ * Description: FNV-1a of the assert name and the line, reduced to the capacity
+ * of the table.
+ */
+{
+	uint64_t hash = 14695981039346656037ULL;
+
+	for(; *assert_name != '\0'; assert_name++) hash = (hash ^ (unsigned char) *assert_name) * 1099511628211ULL;
+	hash = (hash ^ (uint64_t) (unsigned int) line_number) * 1099511628211ULL;
+	return (size_t) (hash ^ (hash >> 32)) & (failure_sites_capacity - 1);
+}
 
 
+static void grow_failure_sites()
+/**
+ * Description: This function doubles the capacity of the table of sites (64 at
+ * first) and inserts the sites again.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	failure_site *old_sites = failure_sites;
+	size_t old_capacity = failure_sites_capacity, i, j;
+
+	failure_sites_capacity = old_capacity == 0 ? 64 : 2 * old_capacity;
+	failure_sites = calloc(failure_sites_capacity, sizeof *failure_sites);
+	if(failure_sites == NULL)
+	{
+		fprintf(stderr, "Error while allocating the table of the failure sites.\n");
+		exit(EXIT_FAILURE);
+	}
+	for(i = 0; i < old_capacity; i++)
+	{
+		if(old_sites[i].assert_name == NULL) continue;
+		for(j = hash_failure_site(old_sites[i].assert_name, old_sites[i].line_number); failure_sites[j].assert_name != NULL; j = (j + 1) & (failure_sites_capacity - 1));
+		failure_sites[j] = old_sites[i];
+	}
+	free(old_sites);
+	last_failure_site = NULL;
+}
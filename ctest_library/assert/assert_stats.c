@@ -0,0 +1,233 @@
+/**
+ * Title: ASSERT STATS
+ */
+
+/**
+ * Description: This file contains the statistics of the assertions per call
+ * site (assert name and line): the number of hits, of successes, fails and
+ * ignored results, and the time spent inside the assertion, from the
+ * get_result_details_buffer() of the assertion to its print_assert_result().
+ *     The statistics are opt-in: they are collected only if 'collect_assert_stats'
+ * is true (or the environment variable CTEST_ASSERT_STATS is "1") when the suite
+ * starts. At end_suite(), the sites are sorted by time, the greatest first, and
+ * given to the reporters (the console prints the NUM_OF_ASSERT_HOTSPOTS first).
+ *     The table has a fixed capacity (MAX_ASSERT_SITES) and uses open addressing,
+ * so an assertion does not allocate memory. It is mapped with MAP_SHARED when
+ * the suite starts, so the assertions of the child processes (WITH blocks and
+ * CTEST_FIXTURE_CHECKPOINT) are added to the table of the suite. If the table is
+ * full, the results of the new sites are only counted in 'num_of_lost_results'.
+ */
+
+//Includes:
+#define _GNU_SOURCE
+#include "assert.h"
+#include "globals.h"
+#include "reporter.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Macros:
+#define MAX_ASSERT_SITES 4096 //Capacity of the table (power of 2); at most 3/4 of it is used.
+
+//Definition of types:
+typedef struct {
+	size_t num_of_sites;
+	unsigned long long num_of_lost_results; //Results of the sites that did not fit in the table.
+	assert_site_stats sites[MAX_ASSERT_SITES];
+} assert_stats_table;
+
+//Define global variables:
+bool collect_assert_stats = false;
+
+//Local variables:
+static assert_stats_table *stats_table = NULL; //Shared with the child processes.
+static _Thread_local struct timespec assert_start_time;
+
+//Local auxiliary functions:
+static assert_site_stats *find_assert_site(const char assert_name[], int line_number);
+static size_t hash_assert_site(const char assert_name[], int line_number);
+static int compare_assert_sites(const void *a, const void *b);
+
+
+//Function definitions:
+void assert_stats_start_suite()
+/**
+ * Description: This function empties the table of the statistics. It is called
+ * by start_suite(). If the statistics are collected (see the description of this
+ * file), the table is mapped the first time.
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(MAX_ASSERT_SITES)
+ *
+ * Space Complexity: O(MAX_ASSERT_SITES)
+ */
+{
+	char *value = getenv("CTEST_ASSERT_STATS");
+
+	if(value != NULL) collect_assert_stats = strcmp(value, "1") == 0;
+	if(!collect_assert_stats) return;
+
+	if(stats_table == NULL)
+	{
+		stats_table = mmap(NULL, sizeof *stats_table, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if(stats_table == MAP_FAILED)
+		{
+			stats_table = NULL;
+			fprintf(stderr, "Error while mapping the table of the assert stats.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	else memset(stats_table, 0, sizeof *stats_table);
+}
+
+
+void assert_stats_mark_start()
+/**
+ * Description: This function records the time at which the assertion of the
+ * calling thread started. It is called by get_result_details_buffer().
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	clock_gettime(CLOCK_MONOTONIC, &assert_start_time);
+}
+
+
+void assert_stats_record(const char assert_name[], int line_number, char status)
+/**
+ * Description: This function adds a result with 'status' ('.', 'F' or 'I') to
+ * the statistics of its site, with the time elapsed since the last
+ * assert_stats_mark_start() of the thread. Nothing is done if the table is not
+ * mapped.
+ *
+ * Input: (const char []) assert_name --> The name of the assertion;
+ *        (int) line_number --> The line of the assertion;
+ *        (char) status --> The status of the result.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1) expected.
+ *
+ * Space Complexity: O(1)
+ */
+{
+	struct timespec end_time;
+	assert_site_stats *site;
+
+	if(stats_table == NULL) return;
+	clock_gettime(CLOCK_MONOTONIC, &end_time);
+	site = find_assert_site(assert_name, line_number);
+	if(site == NULL)
+	{
+		stats_table->num_of_lost_results++;
+		return;
+	}
+	site->num_of_hits++;
+	if(status == REPORT_SUCCESS) site->num_of_passes++;
+	else if(status == REPORT_IGNORED) site->num_of_ignored++;
+	else site->num_of_fails++;
+	site->total_ns += (unsigned long long) ((end_time.tv_sec - assert_start_time.tv_sec) * 1000000000LL + (end_time.tv_nsec - assert_start_time.tv_nsec));
+}
+
+
+void assert_stats_end_suite()
+/**
+ * Description: This function sorts the sites of the table by their total time,
+ * the greatest first, sends them to the reporters and empties the table. It is
+ * called by end_suite().
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(MAX_ASSERT_SITES + n * log(n)), where n is the number of
+ * sites.
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i, n = 0;
+
+	if(stats_table == NULL) return;
+
+	//The sites are moved to the beginning of the table (it is emptied after):
+	for(i = 0; i < MAX_ASSERT_SITES; i++)
+	{
+		if(stats_table->sites[i].assert_name == NULL) continue;
+		if(i != n) stats_table->sites[n] = stats_table->sites[i];
+		n++;
+	}
+	qsort(stats_table->sites, n, sizeof *stats_table->sites, compare_assert_sites);
+	if(stats_table->num_of_lost_results > 0)
+		fprintf(stderr, "Warning: the table of the assert stats is full (%llu results were not recorded).\n", stats_table->num_of_lost_results);
+	reporters_assert_stats(stats_table->sites, n);
+	memset(stats_table, 0, sizeof *stats_table);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static assert_site_stats *find_assert_site(const char assert_name[], int line_number)
+/**
+ * Description: This function returns the site of 'assert_name' at 'line_number',
+ * adding it to the table if it is new, or NULL if the table is full.
+ */
+{
+	size_t i;
+
+	for(i = hash_assert_site(assert_name, line_number); stats_table->sites[i].assert_name != NULL; i = (i + 1) & (MAX_ASSERT_SITES - 1))
+	{
+		if(stats_table->sites[i].line_number == line_number && (stats_table->sites[i].assert_name == assert_name || strcmp(stats_table->sites[i].assert_name, assert_name) == 0))
+			return &stats_table->sites[i];
+	}
+	if(4 * (stats_table->num_of_sites + 1) > 3 * MAX_ASSERT_SITES) return NULL;
+	stats_table->sites[i].assert_name = assert_name;
+	stats_table->sites[i].line_number = line_number;
+	stats_table->num_of_sites++;
+	return &stats_table->sites[i];
+}
+
+
+static size_t hash_assert_site(const char assert_name[], int line_number)
+/**
+ * Description: FNV-1a of the assert name and the line, reduced to the capacity
+ * of the table.
+ */
+{
+	uint64_t hash = 14695981039346656037ULL;
+
+	for(; *assert_name != '\0'; assert_name++) hash = (hash ^ (unsigned char) *assert_name) * 1099511628211ULL;
+	hash = (hash ^ (uint64_t) (unsigned int) line_number) * 1099511628211ULL;
+	return (size_t) (hash ^ (hash >> 32)) & (MAX_ASSERT_SITES - 1);
+}
+
+
+static int compare_assert_sites(const void *a, const void *b)
+/**
+ * Description: Comparison of qsort: the greatest total time first, then the
+ * greatest number of hits.
+ */
+{
+	const assert_site_stats *site_a = a, *site_b = b;
+
+	if(site_a->total_ns != site_b->total_ns) return site_a->total_ns < site_b->total_ns ? 1 : -1;
+	if(site_a->num_of_hits != site_b->num_of_hits) return site_a->num_of_hits < site_b->num_of_hits ? 1 : -1;
+	return site_a->line_number - site_b->line_number;
+}
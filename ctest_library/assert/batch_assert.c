@@ -0,0 +1,386 @@
+/**
+ * Title: BATCH ASSERT
+ */
+
+/**
+ * Description: This file contains the batched assertions (see CTEST_BATCH_BEGIN
+ * in std_assert_macros.h). Inside a batch, each BATCH_EXPECT_* only appends its
+ * comparison to the buffer of the thread, kept as a structure of arrays (the
+ * operations, the targets, the references and the lines), so no result is made
+ * per expectation. The buffer is evaluated when it is full (CTEST_BATCH_SIZE
+ * expectations) and at CTEST_BATCH_END:
+ *     - the buffer is split into runs of the same operation, and each run is
+ * compared BATCH_LANES values at a time with GCC vector extensions, OR-ing the
+ * lanes that fail (the integers are kept as their unsigned_integer bits and
+ * read back as integer by the signed operations);
+ *     - only a run with some fail is compared again value by value, and its
+ * failing expectations are moved to the beginning of the buffer. They are kept
+ * until CTEST_BATCH_END, which reports them with its custom message; if the
+ * buffer is full of fails, they are reported at once, without custom message.
+ *     A batch without fails gives one success (CTEST_BATCH, at the line of
+ * CTEST_BATCH_END); otherwise, each failing expectation is one fail at its own
+ * line, so max_failures_per_site applies per expectation.
+ */
+
+//Includes:
+#include "assert.h"
+#include "globals.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Macros:
+#define BATCH_LANES 4 //Values compared at once by the kernels.
+
+/**
+ * Description: The loop of a kernel: it compares the values of 'lhs' and 'rhs'
+ * from 'i', BATCH_LANES at a time, and ORs into 'fails' the lanes for which
+ * 'lhs FAIL_OPERATOR rhs' (the expectation fails). The remaining values (less
+ * than BATCH_LANES) are left to the caller.
+ */
+#define COMPARE_VECTORS(VECTOR_TYPE, FAIL_OPERATOR) \
+	for(; i + BATCH_LANES <= n; i += BATCH_LANES)\
+	{\
+		VECTOR_TYPE a, b;\
+		memcpy(&a, &lhs[i], sizeof a);\
+		memcpy(&b, &rhs[i], sizeof b);\
+		fails |= (batch_vector) (a FAIL_OPERATOR b);\
+	}
+
+//Definition of types:
+typedef unsigned_integer batch_vector __attribute__((vector_size(BATCH_LANES * sizeof(unsigned_integer))));
+typedef integer batch_signed_vector __attribute__((vector_size(BATCH_LANES * sizeof(integer))));
+
+typedef struct {
+	bool is_open;
+	bool has_failed;        //A fail of the batch was already reported.
+	size_t num_of_entries;  //Expectations in the buffer.
+	size_t num_of_kept;     //Failing expectations at the beginning of the buffer.
+	unsigned char op[CTEST_BATCH_SIZE];
+	unsigned_integer lhs[CTEST_BATCH_SIZE];
+	unsigned_integer rhs[CTEST_BATCH_SIZE];
+	int line[CTEST_BATCH_SIZE];
+} batch_buffer;
+
+//Local variables:
+static _Thread_local batch_buffer batch;
+static const char *const op_names[NUM_OF_BATCH_OPS] = {
+	"BATCH_EXPECT_UNSIGNED_INTEGER_EQUAL",
+	"BATCH_EXPECT_UNSIGNED_INTEGER_NOT_EQUAL",
+	"BATCH_EXPECT_UNSIGNED_INTEGER_GREATER",
+	"BATCH_EXPECT_UNSIGNED_INTEGER_GREATER_EQUAL",
+	"BATCH_EXPECT_UNSIGNED_INTEGER_LESS",
+	"BATCH_EXPECT_UNSIGNED_INTEGER_LESS_EQUAL",
+	"BATCH_EXPECT_INTEGER_EQUAL",
+	"BATCH_EXPECT_INTEGER_NOT_EQUAL",
+	"BATCH_EXPECT_INTEGER_GREATER",
+	"BATCH_EXPECT_INTEGER_GREATER_EQUAL",
+	"BATCH_EXPECT_INTEGER_LESS",
+	"BATCH_EXPECT_INTEGER_LESS_EQUAL"
+};
+static const char *const op_messages[NUM_OF_BATCH_OPS / 2] = {
+	"The target value SHOULD BE EQUAL to the reference value.",
+	"The target value SHOULD NOT BE EQUAL to the reference value.",
+	"The target value SHOULD BE GREATER than the reference value.",
+	"The target value SHOULD BE GREATER OR EQUAL to the reference value.",
+	"The target value SHOULD BE LESS than the reference value.",
+	"The target value SHOULD BE LESS OR EQUAL to the reference value."
+};
+static const char *const op_fail_symbols[NUM_OF_BATCH_OPS / 2] = {"!=", "==", "<=", "<", ">=", ">"};
+
+//Local auxiliary functions:
+static void check_batch_is_open(const char function_name[]);
+static void flush_batch();
+static bool run_has_fails(batch_op op, const unsigned_integer lhs[], const unsigned_integer rhs[], size_t n);
+static bool expectation_fails(batch_op op, unsigned_integer target, unsigned_integer reference);
+static void report_kept_failures(char custom_message[]);
+
+
+//Function definitions:
+void batch_begin()
+/**
+ * Description: This function opens the batch of the calling thread (see
+ * CTEST_BATCH_BEGIN).
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Error handling: If the batch is already open, this function prints an error
+ * message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(batch.is_open)
+	{
+		fprintf(stderr, "Error: CTEST_BATCH_BEGIN inside another batch.\n");
+		exit(EXIT_FAILURE);
+	}
+	batch.is_open        = true;
+	batch.has_failed     = false;
+	batch.num_of_entries = 0;
+	batch.num_of_kept    = 0;
+}
+
+
+void batch_expect(batch_op op, unsigned_integer target, unsigned_integer reference, int line_number)
+/**
+ * Description: This function appends an expectation to the batch of the calling
+ * thread (see BATCH_EXPECT_UNSIGNED_INTEGER_EQUAL). If the buffer is full, it is
+ * evaluated first.
+ *
+ * Input: (batch_op) op --> The comparison;
+ *        (unsigned_integer) target --> The target value (the bits of an integer
+ *        for the BATCH_INTEGER_* operations);
+ *        (unsigned_integer) reference --> The reference value;
+ *        (int) line_number --> The number of the line of the expectation.
+ *
+ * Output: (void)
+ *
+ * Error handling: If no batch is open or 'op' is invalid, this function prints
+ * an error message and exits a failure code.
+ *
+ * Time Complexity: O(1) amortized.
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+
+	check_batch_is_open("BATCH_EXPECT_*");
+	if(op >= NUM_OF_BATCH_OPS)
+	{
+		fprintf(stderr, "Error: invalid batch operation %d (at line %d).\n", (int) op, line_number);
+		exit(EXIT_FAILURE);
+	}
+	if(batch.num_of_entries == CTEST_BATCH_SIZE) flush_batch();
+
+	i = batch.num_of_entries++;
+	batch.op[i]   = (unsigned char) op;
+	batch.lhs[i]  = target;
+	batch.rhs[i]  = reference;
+	batch.line[i] = line_number;
+}
+
+
+void batch_end(int line_number, char custom_message[])
+/**
+ * Description: This function evaluates the expectations left in the batch of
+ * the calling thread and closes it (see CTEST_BATCH_END). If no expectation of
+ * the batch failed, one success is reported; otherwise, the failing expectations
+ * are reported. If 'ignore' is true, one ignored result is reported.
+ *
+ * Input: (int) line_number --> The number of the line of CTEST_BATCH_END;
+ *        (char []) custom_message --> Personalized message that will be printed
+ *        with each fail.
+ *
+ * Output: (void)
+ *
+ * Error handling: If no batch is open, this function prints an error message
+ * and exits a failure code.
+ *
+ * Time Complexity: O(n), where n is the number of expectations left in the
+ * buffer.
+ *
+ * Space Complexity: O(1)
+ */
+{
+	assert_result_struct assert_result = {
+		true,                                                  //was_successful
+		line_number,                                           //line_number
+		get_result_details_buffer(),                           //result_details[MAX_CHARS]
+		"CTEST_BATCH",                                         //assert_name
+		"Every expectation of the batch SHOULD BE satisfied.", //std_message
+		custom_message                                         //custom_message
+	};
+
+	check_batch_is_open("CTEST_BATCH_END");
+	if(!ignore) flush_batch();
+	batch.is_open = false;
+
+	if(ignore || (!batch.has_failed && batch.num_of_kept == 0)) print_assert_result(&assert_result);
+	else report_kept_failures(custom_message);
+}
+
+
+void batch_abort()
+/**
+ * Description: This function discards the batch of the calling thread, if it is
+ * open. It is called by record_module_crash(): a contained crash inside a batch
+ * skips its CTEST_BATCH_END, and the next CTEST_BATCH_BEGIN would find it open.
+ * The expectations left in the buffer are not reported (the crash is).
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	batch.is_open        = false;
+	batch.num_of_entries = 0;
+	batch.num_of_kept    = 0;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void check_batch_is_open(const char function_name[])
+/**
+ * Description: This function exits a failure code if the calling thread has no
+ * open batch.
+ */
+{
+	if(batch.is_open) return;
+	fprintf(stderr, "Error: %s outside a CTEST_BATCH_BEGIN/CTEST_BATCH_END block.\n", function_name);
+	exit(EXIT_FAILURE);
+}
+
+
+static void flush_batch()
+/**
+ * Description: This function evaluates the expectations of the buffer after the
+ * kept fails (see the description of this file). If the buffer is still full,
+ * the kept fails are reported.
+ */
+{
+	size_t i = batch.num_of_kept, j, k;
+
+	while(i < batch.num_of_entries)
+	{
+		//Run of the same operation:
+		for(j = i + 1; j < batch.num_of_entries && batch.op[j] == batch.op[i]; j++);
+
+		if(run_has_fails(batch.op[i], &batch.lhs[i], &batch.rhs[i], j - i))
+		{
+			for(k = i; k < j; k++)
+			{
+				if(!expectation_fails(batch.op[k], batch.lhs[k], batch.rhs[k])) continue;
+				batch.op[batch.num_of_kept]   = batch.op[k];
+				batch.lhs[batch.num_of_kept]  = batch.lhs[k];
+				batch.rhs[batch.num_of_kept]  = batch.rhs[k];
+				batch.line[batch.num_of_kept] = batch.line[k];
+				batch.num_of_kept++;
+			}
+		}
+		i = j;
+	}
+	batch.num_of_entries = batch.num_of_kept;
+
+	if(batch.num_of_kept == CTEST_BATCH_SIZE)
+	{
+		if(!ignore) report_kept_failures(NULL);
+		batch.num_of_entries = batch.num_of_kept = 0;
+	}
+}
+
+
+static bool run_has_fails(batch_op op, const unsigned_integer lhs[], const unsigned_integer rhs[], size_t n)
+/**
+ * Description: This function says if some of the 'n' expectations with the
+ * operation 'op' fails. The kernels compare BATCH_LANES values at a time.
+ */
+{
+	batch_vector fails = {0};
+	size_t i = 0, lane;
+
+	switch(op)
+	{
+		case BATCH_UNSIGNED_INTEGER_EQUAL:
+		case BATCH_INTEGER_EQUAL:                 COMPARE_VECTORS(batch_vector, !=);        break;
+		case BATCH_UNSIGNED_INTEGER_NOT_EQUAL:
+		case BATCH_INTEGER_NOT_EQUAL:             COMPARE_VECTORS(batch_vector, ==);        break;
+		case BATCH_UNSIGNED_INTEGER_GREATER:      COMPARE_VECTORS(batch_vector, <=);        break;
+		case BATCH_UNSIGNED_INTEGER_GREATER_EQUAL:COMPARE_VECTORS(batch_vector, <);         break;
+		case BATCH_UNSIGNED_INTEGER_LESS:         COMPARE_VECTORS(batch_vector, >=);        break;
+		case BATCH_UNSIGNED_INTEGER_LESS_EQUAL:   COMPARE_VECTORS(batch_vector, >);         break;
+		case BATCH_INTEGER_GREATER:               COMPARE_VECTORS(batch_signed_vector, <=); break;
+		case BATCH_INTEGER_GREATER_EQUAL:         COMPARE_VECTORS(batch_signed_vector, <);  break;
+		case BATCH_INTEGER_LESS:                  COMPARE_VECTORS(batch_signed_vector, >=); break;
+		case BATCH_INTEGER_LESS_EQUAL:            COMPARE_VECTORS(batch_signed_vector, >);  break;
+		default: break;
+	}
+	for(lane = 0; lane < BATCH_LANES; lane++) if(fails[lane] != 0) return true;
+
+	//The last values:
+	for(; i < n; i++) if(expectation_fails(op, lhs[i], rhs[i])) return true;
+	return false;
+}
+
+
+static bool expectation_fails(batch_op op, unsigned_integer target, unsigned_integer reference)
+/**
+ * Description: This function says if one expectation fails.
+ */
+{
+	switch(op)
+	{
+		case BATCH_UNSIGNED_INTEGER_EQUAL:
+		case BATCH_INTEGER_EQUAL:                  return target != reference;
+		case BATCH_UNSIGNED_INTEGER_NOT_EQUAL:
+		case BATCH_INTEGER_NOT_EQUAL:              return target == reference;
+		case BATCH_UNSIGNED_INTEGER_GREATER:       return target <= reference;
+		case BATCH_UNSIGNED_INTEGER_GREATER_EQUAL: return target < reference;
+		case BATCH_UNSIGNED_INTEGER_LESS:          return target >= reference;
+		case BATCH_UNSIGNED_INTEGER_LESS_EQUAL:    return target > reference;
+		case BATCH_INTEGER_GREATER:                return (integer) target <= (integer) reference;
+		case BATCH_INTEGER_GREATER_EQUAL:          return (integer) target < (integer) reference;
+		case BATCH_INTEGER_LESS:                   return (integer) target >= (integer) reference;
+		case BATCH_INTEGER_LESS_EQUAL:             return (integer) target > (integer) reference;
+		default:                                   return false;
+	}
+}
+
+
+static void report_kept_failures(char custom_message[])
+/**
+ * Description: This function reports each failing expectation kept at the
+ * beginning of the buffer as one fail at its line, and forgets them.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	assert_result_struct assert_result;
+	batch_op op;
+	size_t i, comparison;
+	int n = 0;
+
+	for(i = 0; i < batch.num_of_kept; i++)
+	{
+		op = batch.op[i];
+		comparison = op % (NUM_OF_BATCH_OPS / 2);
+		assert_result = (assert_result_struct) {
+			false,                                //was_successful
+			batch.line[i],                        //line_number
+			get_result_details_buffer(),          //result_details[MAX_CHARS]
+			(char *) op_names[op],                //assert_name
+			(char *) op_messages[comparison],     //std_message
+			custom_message                        //custom_message
+		};
+		if(failure_details_are_needed(&assert_result))
+		{
+			if(op < BATCH_INTEGER_EQUAL)
+				n = snprintf(assert_result.result_details, MAX_CHARS, "> %20s    %-20s\n> %20llu %2s %-20llu\n", "target", "reference",
+						batch.lhs[i], op_fail_symbols[comparison], batch.rhs[i]);
+			else
+				n = snprintf(assert_result.result_details, MAX_CHARS, "> %20s    %-20s\n> %+20lld %2s %+-20lld\n", "target", "reference",
+						(integer) batch.lhs[i], op_fail_symbols[comparison], (integer) batch.rhs[i]);
+		}
+		if(n < 0)
+		{
+			fprintf(stderr, "\nError while generating the result message (at line %d).\n", batch.line[i]);
+			exit(EXIT_FAILURE);
+		}
+		print_assert_result(&assert_result);
+	}
+	batch.has_failed = batch.has_failed || batch.num_of_kept > 0;
+	batch.num_of_kept = 0;
+}
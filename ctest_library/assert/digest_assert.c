@@ -0,0 +1,599 @@
+/**
+ * Title: DIGEST ASSERT
+ */
+
+/**
+ * Description: This file contains the digests of buffers and their assertions,
+ * for outputs too large to keep a reference copy: only the hexadecimal digest
+ * of the expected output is kept. The algorithm of an assertion is given by the
+ * length of the expected digest (32 digits: DIGEST_FAST128; 64: DIGEST_SHA256).
+ *     DIGEST_FAST128 (the default) is not cryptographic. The input is split into
+ * leaves of DIGEST_LEAF_SIZE bytes, each hashed with MurmurHash3 (x64, 128 bits,
+ * seed 0); the digest is the MurmurHash3 of the leaf digests followed by the
+ * number of bytes and of leaves (16 bytes each). As the leaves are independent,
+ * the complete leaves of a large update (at least 'assert_parallel_threshold'
+ * bytes) are hashed by the threads of parallel.c; the digest does not depend on
+ * the number of threads nor on how the input is split into updates. The words
+ * are read in the byte order of the machine.
+ *     DIGEST_SHA256 is the standard SHA-256 of the input (as sha256sum), so it is
+ * serial.
+ *     A digest can be computed incrementally (digest_init, digest_update, and
+ * assert_digest_equal or digest_final), e.g. while the output is produced.
+ */
+
+//Includes:
+#include "assert.h"
+#include "globals.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Macros:
+#define DIGEST_LEAF_SIZE (1 << 20) //Bytes of a leaf of DIGEST_FAST128 (multiple of 16).
+#define FAST128_BLOCK_SIZE 16
+#define SHA256_BLOCK_SIZE 64
+#define ROTL64(X, R) (((X) << (R)) | ((X) >> (64 - (R))))
+#define ROTR32(X, R) (((X) >> (R)) | ((X) << (32 - (R))))
+
+//Definition of types:
+typedef struct {
+	const unsigned char *data;
+	uint64_t (*leaf_digests)[2];
+} leaves_job;
+
+//Local variables:
+static const char *algorithm_names[] = {"fast128", "sha256"};
+static const size_t digest_hex_sizes[] = {32, 64}; //Hexadecimal digits of each algorithm.
+static const uint32_t sha256_initial_state[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+static const uint32_t sha256_round_constants[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+//Local auxiliary functions:
+static void fast128_update(ctest_digest *digest, const unsigned char data[], size_t size);
+static void fast128_final(ctest_digest *digest, uint64_t hash[2]);
+static void fast128_blocks(uint64_t hash[2], const unsigned char data[], size_t num_of_blocks);
+static void fast128_finish(uint64_t hash[2], const unsigned char tail[], size_t tail_size, uint64_t length);
+static uint64_t fast128_mix(uint64_t k);
+static void fast128_add_leaf(ctest_digest *digest, const uint64_t leaf_digest[2]);
+static size_t hash_leaves(ctest_digest *digest, const unsigned char data[], size_t num_of_leaves);
+static void hash_leaf_range(size_t begin, size_t end, const void *job);
+static void sha256_update(ctest_digest *digest, const unsigned char data[], size_t size);
+static void sha256_final(ctest_digest *digest, unsigned char hash[32]);
+static void sha256_blocks(uint32_t state[8], const unsigned char data[], size_t num_of_blocks);
+static bool get_expected_algorithm(const char expected_digest[], digest_algorithm *algorithm);
+static void report_digest_result(const char assert_name[], ctest_digest *digest, const char expected_digest[], int line_number, char custom_message[]);
+
+
+//Function definitions:
+void digest_init(ctest_digest *digest, digest_algorithm algorithm)
+/**
+ * Description: This function starts a new digest with 'algorithm'.
+ *
+ * Input: (ctest_digest *) digest --> The digest;
+ *        (digest_algorithm) algorithm --> DIGEST_FAST128 or DIGEST_SHA256.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	memset(digest, 0, sizeof *digest);
+	digest->algorithm = algorithm;
+	if(algorithm == DIGEST_SHA256) memcpy(digest->sha256_state, sha256_initial_state, sizeof sha256_initial_state);
+}
+
+
+void digest_update(ctest_digest *digest, const void *data, size_t size)
+/**
+ * Description: This function adds the 'size' bytes of 'data' to the digest. An
+ * input split into several updates gives the same digest as one update.
+ *
+ * Input: (ctest_digest *) digest --> The digest;
+ *        (const void *) data --> The bytes;
+ *        (size_t) size --> The number of bytes.
+ *
+ * Output: (void)
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(size), divided by the number of threads for the complete
+ * leaves of a large update (DIGEST_FAST128).
+ *
+ * Space Complexity: O(size / DIGEST_LEAF_SIZE)
+ */
+{
+	if(digest->algorithm == DIGEST_SHA256) sha256_update(digest, data, size);
+	else fast128_update(digest, data, size);
+}
+
+
+void digest_final(ctest_digest *digest, char hex_digest[MAX_DIGEST_HEX_SIZE])
+/**
+ * Description: This function writes the hexadecimal digest (lowercase) of the
+ * bytes added so far into 'hex_digest'. The digest is not changed, so more bytes
+ * can be added after.
+ *
+ * Input: (ctest_digest *) digest --> The digest;
+ *        (char []) hex_digest --> Buffer of MAX_DIGEST_HEX_SIZE chars.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	uint64_t fast128_hash[2];
+	unsigned char sha256_hash[32];
+	size_t i;
+
+	if(digest->algorithm == DIGEST_SHA256)
+	{
+		sha256_final(digest, sha256_hash);
+		for(i = 0; i < sizeof sha256_hash; i++) sprintf(&hex_digest[2 * i], "%02x", sha256_hash[i]);
+	}
+	else
+	{
+		fast128_final(digest, fast128_hash);
+		sprintf(hex_digest, "%016llx%016llx", (unsigned long long) fast128_hash[0], (unsigned long long) fast128_hash[1]);
+	}
+}
+
+
+void assert_digest_equal(ctest_digest *digest, const char expected_digest[], int line_number, char custom_message[])
+/**
+ * Description: This function checks if the digest of the bytes added so far to
+ * 'digest' is 'expected_digest' (hexadecimal, in any case). The length of the
+ * expected digest must be the one of the algorithm of 'digest'. The details of a
+ * fail show both digests and the number of bytes hashed.
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (ctest_digest *) digest --> The digest;
+ *        (const char []) expected_digest --> The expected hexadecimal digest;
+ *        (int) line_number --> The number of the line on which this function was
+ *        written in the source code;
+ *        (char []) custom_message --> Personalized message that will be printed
+ *        if the test fails.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	report_digest_result("assert_digest_equal", digest, expected_digest, line_number, custom_message);
+}
+
+
+void assert_buffer_digestEqual(const void *target, size_t target_size, const char expected_digest[], int line_number, char custom_message[])
+/**
+ * Description: This function checks if the digest of the 'target_size' bytes of
+ * 'target' is 'expected_digest' (hexadecimal, in any case). The algorithm is
+ * given by the length of the expected digest (see the description of this
+ * file). The details of a fail show both digests and the number of bytes hashed.
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (const void *) target --> The bytes to be hashed;
+ *        (size_t) target_size --> The number of bytes;
+ *        (const char []) expected_digest --> The expected hexadecimal digest;
+ *        (int) line_number --> The number of the line on which this function was
+ *        written in the source code;
+ *        (char []) custom_message --> Personalized message that will be printed
+ *        if the test fails.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(target_size) (see digest_update).
+ *
+ * Space Complexity: O(target_size / DIGEST_LEAF_SIZE)
+ */
+{
+	ctest_digest digest;
+	digest_algorithm algorithm = DIGEST_FAST128;
+
+	get_expected_algorithm(expected_digest, &algorithm);
+	digest_init(&digest, algorithm);
+	if(!ignore) digest_update(&digest, target, target_size);
+	report_digest_result("assert_buffer_digestEqual", &digest, expected_digest, line_number, custom_message);
+}
+
+
+void assert_unsigned_integerArray_digestEqual(unsigned_integer target[], size_t target_size, const char expected_digest[], int line_number, char custom_message[])
+/**
+ * Description: This function checks if the digest of the bytes of the
+ * 'target_size' elements of 'target' is 'expected_digest' (see
+ * assert_buffer_digestEqual).
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (unsigned_integer []) target --> The array to be hashed;
+ *        (size_t) target_size --> The number of elements of 'target';
+ *        (const char []) expected_digest --> The expected hexadecimal digest;
+ *        (int) line_number --> The number of the line on which this function was
+ *        written in the source code;
+ *        (char []) custom_message --> Personalized message that will be printed
+ *        if the test fails.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(target_size) (see digest_update).
+ *
+ * Space Complexity: O(target_size / DIGEST_LEAF_SIZE)
+ */
+{
+	ctest_digest digest;
+	digest_algorithm algorithm = DIGEST_FAST128;
+
+	get_expected_algorithm(expected_digest, &algorithm);
+	digest_init(&digest, algorithm);
+	if(!ignore) digest_update(&digest, target, target_size * sizeof *target);
+	report_digest_result("assert_unsigned_integerArray_digestEqual", &digest, expected_digest, line_number, custom_message);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void fast128_update(ctest_digest *digest, const unsigned char data[], size_t size)
+/**
+ * Description: This function adds the bytes of 'data' to a DIGEST_FAST128
+ * digest. The complete leaves of a large update are hashed by several threads.
+ */
+{
+	size_t leaf_offset, n;
+
+	while(size > 0)
+	{
+		leaf_offset = digest->num_of_bytes % DIGEST_LEAF_SIZE;
+		if(leaf_offset == 0 && size >= 2 * (size_t) DIGEST_LEAF_SIZE && size >= assert_parallel_threshold)
+		{
+			n = hash_leaves(digest, data, size / DIGEST_LEAF_SIZE);
+		}
+		else
+		{
+			//Bytes up to the end of the leaf, by blocks:
+			n = size < DIGEST_LEAF_SIZE - leaf_offset ? size : DIGEST_LEAF_SIZE - leaf_offset;
+			if(digest->block_size > 0 || n < FAST128_BLOCK_SIZE)
+			{
+				if(n > FAST128_BLOCK_SIZE - digest->block_size) n = FAST128_BLOCK_SIZE - digest->block_size;
+				memcpy(&digest->block[digest->block_size], data, n);
+				digest->block_size += n;
+				if(digest->block_size == FAST128_BLOCK_SIZE)
+				{
+					fast128_blocks(digest->leaf_hash, digest->block, 1);
+					digest->block_size = 0;
+				}
+			}
+			else
+			{
+				n -= n % FAST128_BLOCK_SIZE;
+				fast128_blocks(digest->leaf_hash, data, n / FAST128_BLOCK_SIZE);
+			}
+			digest->num_of_bytes += n;
+
+			//End of a leaf:
+			if(digest->num_of_bytes % DIGEST_LEAF_SIZE == 0)
+			{
+				fast128_finish(digest->leaf_hash, NULL, 0, DIGEST_LEAF_SIZE);
+				fast128_add_leaf(digest, digest->leaf_hash);
+				digest->leaf_hash[0] = digest->leaf_hash[1] = 0;
+			}
+		}
+		data += n;
+		size -= n;
+	}
+}
+
+
+static void fast128_final(ctest_digest *digest, uint64_t hash[2])
+/**
+ * Description: This function computes the DIGEST_FAST128 hash of 'digest' into
+ * 'hash', without changing 'digest'.
+ */
+{
+	uint64_t leaf_hash[2] = {digest->leaf_hash[0], digest->leaf_hash[1]}, sizes[2];
+	size_t leaf_offset = digest->num_of_bytes % DIGEST_LEAF_SIZE;
+	ctest_digest root = *digest;
+
+	//The last leaf, if it is not complete:
+	if(leaf_offset > 0)
+	{
+		fast128_finish(leaf_hash, digest->block, digest->block_size, leaf_offset);
+		fast128_add_leaf(&root, leaf_hash);
+	}
+
+	//The sizes close the hash of the leaf digests:
+	sizes[0] = root.num_of_bytes;
+	sizes[1] = (root.num_of_bytes + DIGEST_LEAF_SIZE - 1) / DIGEST_LEAF_SIZE;
+	fast128_blocks(root.root_hash, (const unsigned char *) sizes, 1);
+	fast128_finish(root.root_hash, NULL, 0, FAST128_BLOCK_SIZE * (sizes[1] + 1));
+	hash[0] = root.root_hash[0];
+	hash[1] = root.root_hash[1];
+}
+
+
+static void fast128_blocks(uint64_t hash[2], const unsigned char data[], size_t num_of_blocks)
+/**
+ * Description: Body of MurmurHash3 (x64, 128 bits): it mixes the blocks of 16
+ * bytes of 'data' into 'hash'.
+ */
+{
+	const uint64_t c1 = 0x87c37b91114253d5ULL, c2 = 0x4cf5ad432745937fULL;
+	uint64_t h1 = hash[0], h2 = hash[1], k1, k2;
+	size_t i;
+
+	for(i = 0; i < num_of_blocks; i++, data += FAST128_BLOCK_SIZE)
+	{
+		memcpy(&k1, data, sizeof k1);
+		memcpy(&k2, data + sizeof k1, sizeof k2);
+
+		k1 *= c1; k1 = ROTL64(k1, 31); k1 *= c2; h1 ^= k1;
+		h1 = ROTL64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+		k2 *= c2; k2 = ROTL64(k2, 33); k2 *= c1; h2 ^= k2;
+		h2 = ROTL64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+	}
+	hash[0] = h1;
+	hash[1] = h2;
+}
+
+
+static void fast128_finish(uint64_t hash[2], const unsigned char tail[], size_t tail_size, uint64_t length)
+/**
+ * Description: Tail and finalization of MurmurHash3 (x64, 128 bits): it mixes the
+ * last 'tail_size' (< 16) bytes and the total 'length' of the input into 'hash'.
+ */
+{
+	const uint64_t c1 = 0x87c37b91114253d5ULL, c2 = 0x4cf5ad432745937fULL;
+	uint64_t h1 = hash[0], h2 = hash[1], k1 = 0, k2 = 0;
+	size_t i;
+
+	for(i = tail_size; i > 8; i--) k2 = (k2 << 8) | tail[i - 1];
+	for(; i > 0; i--) k1 = (k1 << 8) | tail[i - 1];
+	if(tail_size > 8)
+	{
+		k2 *= c2; k2 = ROTL64(k2, 33); k2 *= c1; h2 ^= k2;
+	}
+	if(tail_size > 0)
+	{
+		k1 *= c1; k1 = ROTL64(k1, 31); k1 *= c2; h1 ^= k1;
+	}
+
+	h1 ^= length; h2 ^= length;
+	h1 += h2; h2 += h1;
+	h1 = fast128_mix(h1); h2 = fast128_mix(h2);
+	h1 += h2; h2 += h1;
+	hash[0] = h1;
+	hash[1] = h2;
+}
+
+
+static uint64_t fast128_mix(uint64_t k)
+/**
+ * Description: Final mix (fmix64) of MurmurHash3.
+ */
+{
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+	return k;
+}
+
+
+static void fast128_add_leaf(ctest_digest *digest, const uint64_t leaf_digest[2])
+/**
+ * Description: This function adds the digest of a leaf (one block) to the hash
+ * of the leaf digests.
+ */
+{
+	unsigned char block[FAST128_BLOCK_SIZE];
+
+	memcpy(block, leaf_digest, sizeof block);
+	fast128_blocks(digest->root_hash, block, 1);
+}
+
+
+static size_t hash_leaves(ctest_digest *digest, const unsigned char data[], size_t num_of_leaves)
+/**
+ * Description: This function hashes the 'num_of_leaves' complete leaves of
+ * 'data' with the thread pool, adds them to 'digest' in order and returns the
+ * number of bytes hashed.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	leaves_job job = {data, malloc(num_of_leaves * sizeof *job.leaf_digests)};
+	size_t i;
+
+	if(job.leaf_digests == NULL)
+	{
+		fprintf(stderr, "Error while allocating the leaf digests of a digest.\n");
+		exit(EXIT_FAILURE);
+	}
+	parallel_for(0, num_of_leaves, 1, hash_leaf_range, &job);
+	for(i = 0; i < num_of_leaves; i++) fast128_add_leaf(digest, job.leaf_digests[i]);
+	free(job.leaf_digests);
+	digest->num_of_bytes += (unsigned long long) num_of_leaves * DIGEST_LEAF_SIZE;
+	return num_of_leaves * DIGEST_LEAF_SIZE;
+}
+
+
+static void hash_leaf_range(size_t begin, size_t end, const void *job)
+/**
+ * Description: Function of parallel_for(): it hashes the leaves [begin, end) of
+ * 'job' (leaves_job).
+ */
+{
+	const leaves_job *leaves = job;
+	size_t i;
+
+	for(i = begin; i < end; i++)
+	{
+		leaves->leaf_digests[i][0] = leaves->leaf_digests[i][1] = 0;
+		fast128_blocks(leaves->leaf_digests[i], &leaves->data[i * DIGEST_LEAF_SIZE], DIGEST_LEAF_SIZE / FAST128_BLOCK_SIZE);
+		fast128_finish(leaves->leaf_digests[i], NULL, 0, DIGEST_LEAF_SIZE);
+	}
+}
+
+
+static void sha256_update(ctest_digest *digest, const unsigned char data[], size_t size)
+/**
+ * Description: This function adds the bytes of 'data' to a DIGEST_SHA256 digest.
+ */
+{
+	size_t n;
+
+	digest->num_of_bytes += size;
+	if(digest->block_size > 0)
+	{
+		n = size < SHA256_BLOCK_SIZE - digest->block_size ? size : SHA256_BLOCK_SIZE - digest->block_size;
+		memcpy(&digest->block[digest->block_size], data, n);
+		digest->block_size += n;
+		data += n;
+		size -= n;
+		if(digest->block_size < SHA256_BLOCK_SIZE) return;
+		sha256_blocks(digest->sha256_state, digest->block, 1);
+		digest->block_size = 0;
+	}
+	sha256_blocks(digest->sha256_state, data, size / SHA256_BLOCK_SIZE);
+	memcpy(digest->block, &data[size - size % SHA256_BLOCK_SIZE], size % SHA256_BLOCK_SIZE);
+	digest->block_size = size % SHA256_BLOCK_SIZE;
+}
+
+
+static void sha256_final(ctest_digest *digest, unsigned char hash[32])
+/**
+ * Description: This function computes the SHA-256 hash of 'digest' into 'hash'
+ * (padding and length), without changing 'digest'.
+ */
+{
+	unsigned char padding[2 * SHA256_BLOCK_SIZE] = {0};
+	uint32_t state[8];
+	uint64_t num_of_bits = digest->num_of_bytes * 8;
+	size_t padding_size = digest->block_size < SHA256_BLOCK_SIZE - 8 ? SHA256_BLOCK_SIZE : 2 * SHA256_BLOCK_SIZE;
+	size_t i;
+
+	memcpy(state, digest->sha256_state, sizeof state);
+	memcpy(padding, digest->block, digest->block_size);
+	padding[digest->block_size] = 0x80;
+	for(i = 0; i < 8; i++) padding[padding_size - 1 - i] = (unsigned char) (num_of_bits >> (8 * i));
+	sha256_blocks(state, padding, padding_size / SHA256_BLOCK_SIZE);
+	for(i = 0; i < 32; i++) hash[i] = (unsigned char) (state[i / 4] >> (24 - 8 * (i % 4)));
+}
+
+
+static void sha256_blocks(uint32_t state[8], const unsigned char data[], size_t num_of_blocks)
+/**
+ * Description: Compression function of SHA-256 over the blocks of 64 bytes of
+ * 'data'.
+ */
+{
+	uint32_t w[64], s[8], s0, s1, t1, t2;
+	size_t i, block;
+
+	for(block = 0; block < num_of_blocks; block++, data += SHA256_BLOCK_SIZE)
+	{
+		for(i = 0; i < 16; i++)
+			w[i] = (uint32_t) data[4 * i] << 24 | (uint32_t) data[4 * i + 1] << 16 | (uint32_t) data[4 * i + 2] << 8 | data[4 * i + 3];
+		for(i = 16; i < 64; i++)
+		{
+			s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		memcpy(s, state, sizeof s);
+		for(i = 0; i < 64; i++)
+		{
+			t1 = s[7] + (ROTR32(s[4], 6) ^ ROTR32(s[4], 11) ^ ROTR32(s[4], 25)) + ((s[4] & s[5]) ^ (~s[4] & s[6])) + sha256_round_constants[i] + w[i];
+			t2 = (ROTR32(s[0], 2) ^ ROTR32(s[0], 13) ^ ROTR32(s[0], 22)) + ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+			memmove(&s[1], &s[0], 7 * sizeof s[0]);
+			s[4] += t1;
+			s[0] = t1 + t2;
+		}
+		for(i = 0; i < 8; i++) state[i] += s[i];
+	}
+}
+
+
+static bool get_expected_algorithm(const char expected_digest[], digest_algorithm *algorithm)
+/**
+ * Description: This function sets 'algorithm' from the length of the expected
+ * digest, and says if it is a valid hexadecimal digest.
+ */
+{
+	size_t i;
+
+	if(expected_digest == NULL) return false;
+	for(i = 0; expected_digest[i] != '\0'; i++) if(!isxdigit((unsigned char) expected_digest[i])) return false;
+	if(i == digest_hex_sizes[DIGEST_FAST128]) *algorithm = DIGEST_FAST128;
+	else if(i == digest_hex_sizes[DIGEST_SHA256]) *algorithm = DIGEST_SHA256;
+	else return false;
+	return true;
+}
+
+
+static void report_digest_result(const char assert_name[], ctest_digest *digest, const char expected_digest[], int line_number, char custom_message[])
+/**
+ * Description: This function compares the digest with the expected one and
+ * reports the result of the assertion 'assert_name'.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char hex_digest[MAX_DIGEST_HEX_SIZE];
+	digest_algorithm algorithm = digest->algorithm;
+	bool is_valid;
+	int n = 0;
+	assert_result_struct assert_result = {
+		true,                                                 //was_successful
+		line_number,                                          //line_number
+		get_result_details_buffer(),                          //result_details[MAX_CHARS]
+		(char *) assert_name,                                 //assert_name
+		"The digest of 'target' SHOULD BE the expected one.", //std_message
+		custom_message                                        //custom_message
+	};
+
+	if(ignore) goto print;
+
+	is_valid = get_expected_algorithm(expected_digest, &algorithm) && algorithm == digest->algorithm;
+	digest_final(digest, hex_digest);
+	assert_result.was_successful = is_valid && strcasecmp(hex_digest, expected_digest) == 0;
+
+	if(failure_details_are_needed(&assert_result))
+	{
+		if(is_valid)
+			n = snprintf(assert_result.result_details, MAX_CHARS, "> computed (%s, %llu bytes hashed): %s\n> expected: %s\n",
+					algorithm_names[digest->algorithm], digest->num_of_bytes, hex_digest, expected_digest);
+		else
+			n = snprintf(assert_result.result_details, MAX_CHARS, "> computed (%s, %llu bytes hashed): %s\n> expected: \"%s\" is not a digest of %zu hexadecimal digits\n",
+					algorithm_names[digest->algorithm], digest->num_of_bytes, hex_digest, expected_digest == NULL ? "(null)" : expected_digest, digest_hex_sizes[digest->algorithm]);
+		if(n < 0)
+		{
+			fprintf(stderr, "\nError while generating the result message (at line %d).\n", line_number);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+print:
+	print_assert_result(&assert_result);
+}
@@ -0,0 +1,342 @@
+/**
+ * Title: MATRIX ASSERT
+ */
+
+/**
+ * Description: This file contains the matrix assertions. They compare two views
+ * (ctest_matrix_view): matrices kept in arrays with any strides, e.g. row-major
+ * or column-major matrices, submatrices or columns of a row-major buffer, so
+ * nothing is copied.
+ *     The matrices are traversed in blocks of MATRIX_BLOCK_SIZE x
+ * MATRIX_BLOCK_SIZE elements. Inside a block, the inner loop follows the
+ * dimension of the target with the smaller stride, so the target is read in
+ * order and the reference (e.g. transposed) stays in the cache within the
+ * block.
+ *     Every element is compared: a fail reports the number of mismatches and the
+ * first MAX_MATRIX_MISMATCHES of them in row-major order, by (row, col).
+ */
+
+//Includes:
+#include "assert.h"
+#include "globals.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Macros:
+#define MATRIX_BLOCK_SIZE 64 //Rows and columns of a block of the traversal.
+
+/**
+ * Description: The body of a scan function: it compares the elements of 'target'
+ * and 'reference' (arrays of TYPE) block by block, and adds to 'mismatches'
+ * each element for which ELEMENT_FAILS (of the elements 'a' and 'b'), with the
+ * difference DIFFERENCE.
+ */
+#define SCAN_MATRICES(TYPE, ELEMENT_FAILS, DIFFERENCE) \
+	const TYPE *t = target->data, *r = reference->data;\
+	size_t block_row, block_col, end_row, end_col, i, j;\
+	TYPE a, b;\
+\
+	for(block_row = 0; block_row < target->num_of_rows; block_row += MATRIX_BLOCK_SIZE)\
+	{\
+		end_row = target->num_of_rows - block_row < MATRIX_BLOCK_SIZE ? target->num_of_rows : block_row + MATRIX_BLOCK_SIZE;\
+		for(block_col = 0; block_col < target->num_of_cols; block_col += MATRIX_BLOCK_SIZE)\
+		{\
+			end_col = target->num_of_cols - block_col < MATRIX_BLOCK_SIZE ? target->num_of_cols : block_col + MATRIX_BLOCK_SIZE;\
+			if(target->row_stride < target->col_stride)\
+			{\
+				for(j = block_col; j < end_col; j++)\
+					for(i = block_row; i < end_row; i++)\
+					{\
+						a = t[i * target->row_stride + j * target->col_stride];\
+						b = r[i * reference->row_stride + j * reference->col_stride];\
+						if(ELEMENT_FAILS) add_mismatch(mismatches, i, j, (DIFFERENCE));\
+					}\
+			}\
+			else\
+			{\
+				for(i = block_row; i < end_row; i++)\
+					for(j = block_col; j < end_col; j++)\
+					{\
+						a = t[i * target->row_stride + j * target->col_stride];\
+						b = r[i * reference->row_stride + j * reference->col_stride];\
+						if(ELEMENT_FAILS) add_mismatch(mismatches, i, j, (DIFFERENCE));\
+					}\
+			}\
+		}\
+	}
+
+//Definition of types:
+typedef enum {
+	MATRIX_UNSIGNED_INTEGER,
+	MATRIX_INTEGER,
+	MATRIX_FLOATING_POINT
+} matrix_type;
+
+typedef struct {
+	size_t num_of_mismatches;
+	size_t num_of_kept;                        //Mismatches in 'rows' and 'cols'.
+	size_t rows[MAX_MATRIX_MISMATCHES];        //First mismatches in row-major order.
+	size_t cols[MAX_MATRIX_MISMATCHES];
+	floating_point max_difference;             //Greatest |target - reference| (floating_point).
+} matrix_mismatches;
+
+//Local auxiliary functions:
+static void assert_matrices(matrix_type type, const char assert_name[], const ctest_matrix_view *target, const ctest_matrix_view *reference, floating_point max_diff, int line_number, char custom_message[]);
+static void scan_unsigned_integer_matrices(const ctest_matrix_view *target, const ctest_matrix_view *reference, matrix_mismatches *mismatches);
+static void scan_integer_matrices(const ctest_matrix_view *target, const ctest_matrix_view *reference, matrix_mismatches *mismatches);
+static void scan_floating_point_matrices(const ctest_matrix_view *target, const ctest_matrix_view *reference, floating_point max_diff, matrix_mismatches *mismatches);
+static void add_mismatch(matrix_mismatches *mismatches, size_t row, size_t col, floating_point difference);
+static int print_mismatch(char buffer[], size_t size, matrix_type type, const ctest_matrix_view *target, const ctest_matrix_view *reference, size_t row, size_t col);
+
+
+//Function definitions:
+void assert_unsigned_integerMatrix_equal(ctest_matrix_view target, ctest_matrix_view reference, int line_number, char custom_message[])
+/**
+ * Description: This function checks if the matrices of the views 'target' and
+ * 'reference' (of unsigned_integer elements) have the same size and the same
+ * elements. The details of a fail give the first mismatches by (row, col).
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (ctest_matrix_view) target --> The view of the target matrix;
+ *        (ctest_matrix_view) reference --> The view of the reference matrix;
+ *        (int) line_number --> The number of the line on which this function was
+ *        written in the source code;
+ *        (char []) custom_message --> Personalized message that will be printed
+ *        if the test fails.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(rows * cols)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	assert_matrices(MATRIX_UNSIGNED_INTEGER, "assert_unsigned_integerMatrix_equal", &target, &reference, 0, line_number, custom_message);
+}
+
+
+void assert_integerMatrix_equal(ctest_matrix_view target, ctest_matrix_view reference, int line_number, char custom_message[])
+/**
+ * Description: This function checks if the matrices of the views 'target' and
+ * 'reference' (of integer elements) have the same size and the same elements.
+ * The details of a fail give the first mismatches by (row, col).
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (ctest_matrix_view) target --> The view of the target matrix;
+ *        (ctest_matrix_view) reference --> The view of the reference matrix;
+ *        (int) line_number --> The number of the line on which this function was
+ *        written in the source code;
+ *        (char []) custom_message --> Personalized message that will be printed
+ *        if the test fails.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(rows * cols)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	assert_matrices(MATRIX_INTEGER, "assert_integerMatrix_equal", &target, &reference, 0, line_number, custom_message);
+}
+
+
+void assert_floating_pointMatrix_almostEqual(ctest_matrix_view target, ctest_matrix_view reference, floating_point max_diff, int line_number, char custom_message[])
+/**
+ * Description: This function checks if the matrices of the views 'target' and
+ * 'reference' (of floating_point elements) have the same size and if each pair
+ * of elements is almost equal: fabs(target - reference) < max_diff (see
+ * assert_floating_point_almostEqual). The details of a fail give the first
+ * mismatches by (row, col) and the greatest difference.
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (ctest_matrix_view) target --> The view of the target matrix;
+ *        (ctest_matrix_view) reference --> The view of the reference matrix;
+ *        (floating_point) max_diff --> The maximum difference between two
+ *        elements (at least 1e-12);
+ *        (int) line_number --> The number of the line on which this function was
+ *        written in the source code;
+ *        (char []) custom_message --> Personalized message that will be printed
+ *        if the test fails.
+ *
+ * Output: (void)
+ *
+ * Error handling: If max_diff < 1e-12, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(rows * cols)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(!ignore && max_diff < 1e-12)
+	{
+		fprintf(stderr, "\nError: max_diff must be greater than 1e-12 (at line %d).\n", line_number);
+		exit(EXIT_FAILURE);
+	}
+	assert_matrices(MATRIX_FLOATING_POINT, "assert_floating_pointMatrix_almostEqual", &target, &reference, max_diff, line_number, custom_message);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void assert_matrices(matrix_type type, const char assert_name[], const ctest_matrix_view *target, const ctest_matrix_view *reference, floating_point max_diff, int line_number, char custom_message[])
+/**
+ * Description: This function compares the matrices with the scan function of
+ * 'type' and reports the result of the assertion 'assert_name'.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	matrix_mismatches mismatches = {0};
+	size_t i, length;
+	int n = 0;
+	char *std_message = type == MATRIX_FLOATING_POINT ?
+		"Each element of 'target' SHOULD BE ALMOST EQUAL to the one of 'reference'." :
+		"Each element of 'target' SHOULD BE EQUAL to the one of 'reference'.";
+	assert_result_struct assert_result = {
+		true,                        //was_successful
+		line_number,                 //line_number
+		get_result_details_buffer(), //result_details[MAX_CHARS]
+		(char *) assert_name,        //assert_name
+		std_message,                 //std_message
+		custom_message               //custom_message
+	};
+
+	if(ignore) goto print;
+
+	//Compare the sizes, then the elements:
+	if(target->num_of_rows != reference->num_of_rows || target->num_of_cols != reference->num_of_cols)
+	{
+		assert_result.was_successful = false;
+	}
+	else
+	{
+		if(type == MATRIX_UNSIGNED_INTEGER) scan_unsigned_integer_matrices(target, reference, &mismatches);
+		else if(type == MATRIX_INTEGER) scan_integer_matrices(target, reference, &mismatches);
+		else scan_floating_point_matrices(target, reference, max_diff, &mismatches);
+		assert_result.was_successful = mismatches.num_of_mismatches == 0;
+	}
+
+	if(failure_details_are_needed(&assert_result))
+	{
+		if(target->num_of_rows != reference->num_of_rows || target->num_of_cols != reference->num_of_cols)
+		{
+			n = snprintf(assert_result.result_details, MAX_CHARS, "> target: %zu x %zu != reference: %zu x %zu\n",
+					target->num_of_rows, target->num_of_cols, reference->num_of_rows, reference->num_of_cols);
+		}
+		else
+		{
+			n = snprintf(assert_result.result_details, MAX_CHARS, "> %zu of the %zu x %zu elements differ", mismatches.num_of_mismatches, target->num_of_rows, target->num_of_cols);
+			if(n >= 0 && type == MATRIX_FLOATING_POINT)
+			{
+				length = strlen(assert_result.result_details);
+				n = snprintf(assert_result.result_details + length, MAX_CHARS - length, " (max |target - reference|: %lg >= max_diff: %lg)", mismatches.max_difference, max_diff);
+			}
+			for(i = 0; n >= 0 && i < mismatches.num_of_kept; i++)
+			{
+				length = strlen(assert_result.result_details);
+				n = print_mismatch(assert_result.result_details + length, MAX_CHARS - length, type, target, reference, mismatches.rows[i], mismatches.cols[i]);
+			}
+			if(n >= 0)
+			{
+				length = strlen(assert_result.result_details);
+				n = snprintf(assert_result.result_details + length, MAX_CHARS - length, "%s\n", mismatches.num_of_mismatches > mismatches.num_of_kept ? "\n> ..." : "");
+			}
+		}
+		if(n < 0)
+		{
+			fprintf(stderr, "\nError while generating the result message (at line %d).\n", line_number);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+print:
+	print_assert_result(&assert_result);
+}
+
+
+static void scan_unsigned_integer_matrices(const ctest_matrix_view *target, const ctest_matrix_view *reference, matrix_mismatches *mismatches)
+/**
+ * Description: This function adds to 'mismatches' the different elements of two
+ * matrices of unsigned_integer elements with the same size.
+ */
+{
+	SCAN_MATRICES(unsigned_integer, a != b, 0)
+}
+
+
+static void scan_integer_matrices(const ctest_matrix_view *target, const ctest_matrix_view *reference, matrix_mismatches *mismatches)
+/**
+ * Description: This function adds to 'mismatches' the different elements of two
+ * matrices of integer elements with the same size.
+ */
+{
+	SCAN_MATRICES(integer, a != b, 0)
+}
+
+
+static void scan_floating_point_matrices(const ctest_matrix_view *target, const ctest_matrix_view *reference, floating_point max_diff, matrix_mismatches *mismatches)
+/**
+ * Description: This function adds to 'mismatches' the elements of two matrices
+ * of floating_point elements with the same size that are not almost equal (a NaN
+ * is never almost equal).
+ */
+{
+	SCAN_MATRICES(floating_point, !(fabs(a - b) < max_diff), fabs(a - b))
+}
+
+
+static void add_mismatch(matrix_mismatches *mismatches, size_t row, size_t col, floating_point difference)
+/**
+ * Description: This function counts a mismatch, and keeps it if it is among the
+ * first MAX_MATRIX_MISMATCHES in row-major order (the blocks are not traversed
+ * in this order).
+ */
+{
+	size_t i;
+
+	mismatches->num_of_mismatches++;
+	if(difference > mismatches->max_difference) mismatches->max_difference = difference; //A NaN is not kept.
+
+	//Insertion in the sorted list of the first mismatches:
+	for(i = mismatches->num_of_kept; i > 0; i--)
+	{
+		if(mismatches->rows[i - 1] < row || (mismatches->rows[i - 1] == row && mismatches->cols[i - 1] < col)) break;
+		if(i < MAX_MATRIX_MISMATCHES)
+		{
+			mismatches->rows[i] = mismatches->rows[i - 1];
+			mismatches->cols[i] = mismatches->cols[i - 1];
+		}
+	}
+	if(i == MAX_MATRIX_MISMATCHES) return;
+	mismatches->rows[i] = row;
+	mismatches->cols[i] = col;
+	if(mismatches->num_of_kept < MAX_MATRIX_MISMATCHES) mismatches->num_of_kept++;
+}
+
+
+static int print_mismatch(char buffer[], size_t size, matrix_type type, const ctest_matrix_view *target, const ctest_matrix_view *reference, size_t row, size_t col)
+/**
+ * Description: This function writes the elements of a mismatch at (row, col) in
+ * 'buffer', with snprintf (whose result is returned).
+ */
+{
+	size_t target_index = row * target->row_stride + col * target->col_stride;
+	size_t reference_index = row * reference->row_stride + col * reference->col_stride;
+	int n;
+
+	if(type == MATRIX_UNSIGNED_INTEGER)
+		n = snprintf(buffer, size, "\n> (row %zu, col %zu): %llu != %llu", row, col,
+				((const unsigned_integer *) target->data)[target_index], ((const unsigned_integer *) reference->data)[reference_index]);
+	else if(type == MATRIX_INTEGER)
+		n = snprintf(buffer, size, "\n> (row %zu, col %zu): %+lld != %+lld", row, col,
+				((const integer *) target->data)[target_index], ((const integer *) reference->data)[reference_index]);
+	else
+		n = snprintf(buffer, size, "\n> (row %zu, col %zu): %+lg !~= %+lg", row, col,
+				((const floating_point *) target->data)[target_index], ((const floating_point *) reference->data)[reference_index]);
+	return n;
+}
@@ -0,0 +1,295 @@
+/**
+ * Title: PARALLEL
+ */
+
+/**
+ * Description: This file contains the thread pool used by the array assertions
+ * to scan large inputs (at least 'assert_parallel_threshold' elements) with
+ * 'assert_num_of_threads' threads (0: the number of online CPUs; 1: no thread),
+ * and by the digests to hash their leaves (parallel_for).
+ *     The pool is created by the first scan that needs it, and grows if more
+ * threads are asked later. The calling thread works too. A scan is split into
+ * chunks, taken in increasing order; each chunk returns the first index that
+ * matches in it, and the result is the least of them, so it is the index found
+ * by the serial scan. A chunk that starts after an index already found is
+ * skipped.
+ *     Only one scan uses the pool at once: a scan started while the pool is
+ * busy (e.g. by another thread of the test) is serial. A child process (fork)
+ * does not inherit the threads, so it creates its own pool.
+ */
+
+//Includes:
+#define _GNU_SOURCE
+#include "assert.h"
+#include "globals.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Macros:
+#define MAX_POOL_THREADS 256       //Maximum number of threads of the pool (the calling thread is not counted).
+#define CHUNKS_PER_THREAD 8        //A scan is split into about CHUNKS_PER_THREAD chunks per thread.
+#define MIN_CHUNK_SIZE (1 << 14)   //Minimum number of elements of a chunk.
+
+//Definition of types:
+typedef struct {
+	size_t (*find)(size_t begin, size_t end, const void *arg);
+	const void *arg;
+	size_t begin;
+	size_t end;
+	size_t chunk_size;
+	size_t next_chunk;             //Index of the next chunk to be taken (atomic).
+	size_t first_index;            //Least index found (atomic), 'end' if none.
+} scan_job;
+
+typedef struct {
+	void (*run)(size_t begin, size_t end, const void *arg);
+	const void *arg;
+} for_job;
+
+//Define global variables:
+int assert_num_of_threads = 0;
+size_t assert_parallel_threshold = 1 << 20;
+
+//Local variables:
+static pthread_mutex_t submit_mutex = PTHREAD_MUTEX_INITIALIZER; //Held by the scan that uses the pool.
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_done = PTHREAD_COND_INITIALIZER;
+static int num_of_pool_threads = 0;
+static pid_t pool_pid = -1;          //Process that created the threads.
+static unsigned long job_id = 0;     //Incremented for each job given to the pool.
+static int num_of_helpers = 0;       //Threads of the pool that work on the current job.
+static int num_of_seats_taken = 0;   //Threads of the pool that started the current job.
+static int num_of_busy_threads = 0;  //Threads of the pool that did not finish the current job.
+static scan_job current_job;
+
+//Local auxiliary functions:
+static size_t scan(size_t begin, size_t end, size_t min_chunk_size, size_t (*find)(size_t begin, size_t end, const void *arg), const void *arg);
+static size_t run_for_job(size_t begin, size_t end, const void *job);
+static int get_num_of_threads();
+static bool prepare_pool(int num_of_threads);
+static void *pool_thread(void *first_job_id);
+static void run_chunks(scan_job *job);
+
+
+//Function definitions:
+size_t parallel_find_first(size_t begin, size_t end, size_t (*find)(size_t begin, size_t end, const void *arg), const void *arg)
+/**
+ * Description: This function returns the first index of [begin, end) that
+ * matches, scanning the range with the thread pool if it has at least
+ * 'assert_parallel_threshold' elements (see the description of this file).
+ *
+ * Input: (size_t) begin --> The first index of the range;
+ *        (size_t) end --> The end of the range (excluded);
+ *        (size_t (*)(size_t, size_t, const void *)) find --> Function that
+ *        returns the first index of a subrange that matches, or the end of the
+ *        subrange if none. It is called by several threads at once;
+ *        (const void *) arg --> The argument of 'find'.
+ *
+ * Output: (size_t) --> The first index that matches, or 'end' if none.
+ *
+ * Time Complexity: O((end - begin) / number of threads) if no index matches.
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(end <= begin || end - begin < assert_parallel_threshold) return find(begin, end, arg);
+	return scan(begin, end, MIN_CHUNK_SIZE, find, arg);
+}
+
+
+void parallel_for(size_t begin, size_t end, size_t min_chunk_size, void (*run)(size_t begin, size_t end, const void *arg), const void *arg)
+/**
+ * Description: This function calls 'run' on subranges that cover [begin, end),
+ * of at least 'min_chunk_size' elements (except the last one), with the thread
+ * pool. The caller decides if the range is large enough to use the threads.
+ *
+ * Input: (size_t) begin --> The first index of the range;
+ *        (size_t) end --> The end of the range (excluded);
+ *        (size_t) min_chunk_size --> Minimum number of elements of a subrange;
+ *        (void (*)(size_t, size_t, const void *)) run --> Function that
+ *        processes a subrange. It is called by several threads at once;
+ *        (const void *) arg --> The argument of 'run'.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O((end - begin) / number of threads), times the cost of
+ * 'run' per element.
+ *
+ * Space Complexity: O(1)
+ */
+{
+	for_job job = {run, arg};
+
+	if(end <= begin) return;
+	scan(begin, end, min_chunk_size > 0 ? min_chunk_size : 1, run_for_job, &job);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static size_t scan(size_t begin, size_t end, size_t min_chunk_size, size_t (*find)(size_t begin, size_t end, const void *arg), const void *arg)
+/**
+ * Description: This function returns the first index of [begin, end) (not
+ * empty) that matches, scanning chunks of at least 'min_chunk_size' elements with
+ * the thread pool. The scan is serial if it has only one chunk, if there is
+ * only one thread, or if the pool is busy.
+ */
+{
+	int num_of_threads = get_num_of_threads();
+
+	if(num_of_threads <= 1 || end - begin <= min_chunk_size) return find(begin, end, arg);
+	if(pthread_mutex_trylock(&submit_mutex) != 0) return find(begin, end, arg);
+	if(!prepare_pool(num_of_threads - 1))
+	{
+		pthread_mutex_unlock(&submit_mutex);
+		return find(begin, end, arg);
+	}
+
+	//Give the job to the pool:
+	pthread_mutex_lock(&pool_mutex);
+	current_job = (scan_job) {
+		.find        = find,
+		.arg         = arg,
+		.begin       = begin,
+		.end         = end,
+		.chunk_size  = (end - begin) / ((size_t) num_of_threads * CHUNKS_PER_THREAD) + 1,
+		.next_chunk  = 0,
+		.first_index = end
+	};
+	if(current_job.chunk_size < min_chunk_size) current_job.chunk_size = min_chunk_size;
+	num_of_helpers = num_of_busy_threads = num_of_threads - 1;
+	num_of_seats_taken = 0;
+	job_id++;
+	pthread_cond_broadcast(&job_ready);
+	pthread_mutex_unlock(&pool_mutex);
+
+	run_chunks(&current_job);
+
+	//Wait for the pool:
+	pthread_mutex_lock(&pool_mutex);
+	while(num_of_busy_threads > 0) pthread_cond_wait(&job_done, &pool_mutex);
+	pthread_mutex_unlock(&pool_mutex);
+	pthread_mutex_unlock(&submit_mutex);
+	return current_job.first_index;
+}
+
+
+static size_t run_for_job(size_t begin, size_t end, const void *job)
+/**
+ * Description: Function 'find' of parallel_for(): it runs the function of 'job'
+ * (for_job) on the subrange, and never matches.
+ */
+{
+	const for_job *for_each = job;
+
+	for_each->run(begin, end, for_each->arg);
+	return end;
+}
+
+
+static int get_num_of_threads()
+/**
+ * Description: This function returns the number of threads of a scan (the
+ * calling thread included), from 'assert_num_of_threads'.
+ */
+{
+	long num_of_cpus;
+
+	if(assert_num_of_threads > 0) return assert_num_of_threads < MAX_POOL_THREADS + 1 ? assert_num_of_threads : MAX_POOL_THREADS + 1;
+	num_of_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if(num_of_cpus < 1) return 1;
+	return num_of_cpus < MAX_POOL_THREADS + 1 ? (int) num_of_cpus : MAX_POOL_THREADS + 1;
+}
+
+
+static bool prepare_pool(int num_of_threads)
+/**
+ * Description: This function creates the threads of the pool until it has
+ * 'num_of_threads' threads. The pool of a parent process is forgotten by a
+ * child. It returns false if the threads can not be created.
+ */
+{
+	pthread_t thread;
+
+	if(pool_pid != getpid())
+	{
+		//Threads of the parent process (if any) do not exist in this process:
+		pthread_mutex_init(&pool_mutex, NULL);
+		pthread_cond_init(&job_ready, NULL);
+		pthread_cond_init(&job_done, NULL);
+		num_of_pool_threads = 0;
+		num_of_helpers = num_of_seats_taken = num_of_busy_threads = 0;
+		pool_pid = getpid();
+	}
+
+	for(; num_of_pool_threads < num_of_threads; num_of_pool_threads++)
+	{
+		if(pthread_create(&thread, NULL, pool_thread, (void *) (uintptr_t) job_id) != 0) break;
+		pthread_detach(thread);
+	}
+	return num_of_pool_threads >= num_of_threads;
+}
+
+
+static void *pool_thread(void *first_job_id)
+/**
+ * Description: Body of the threads of the pool: each job is scanned with the
+ * calling thread. The pool may have more threads than the job needs: the
+ * threads that find no free seat wait for the next job. 'first_job_id' is the
+ * id of the last job given before the thread was created.
+ */
+{
+	unsigned long last_job_id = (unsigned long) (uintptr_t) first_job_id;
+
+	while(true)
+	{
+		pthread_mutex_lock(&pool_mutex);
+		while(job_id == last_job_id) pthread_cond_wait(&job_ready, &pool_mutex);
+		last_job_id = job_id;
+		if(num_of_seats_taken == num_of_helpers)
+		{
+			pthread_mutex_unlock(&pool_mutex);
+			continue;
+		}
+		num_of_seats_taken++;
+		pthread_mutex_unlock(&pool_mutex);
+
+		run_chunks(&current_job);
+
+		pthread_mutex_lock(&pool_mutex);
+		if(--num_of_busy_threads == 0) pthread_cond_signal(&job_done);
+		pthread_mutex_unlock(&pool_mutex);
+	}
+	return NULL;
+}
+
+
+static void run_chunks(scan_job *job)
+/**
+ * Description: This function scans the chunks of 'job' that are not taken yet,
+ * keeping the least index found.
+ */
+{
+	size_t chunk, chunk_begin, chunk_end, index, first_index;
+
+	while(true)
+	{
+		chunk = __atomic_fetch_add(&job->next_chunk, 1, __ATOMIC_RELAXED);
+		if(chunk > (job->end - job->begin - 1) / job->chunk_size) return;
+		chunk_begin = job->begin + chunk * job->chunk_size;
+		chunk_end = job->end - chunk_begin > job->chunk_size ? chunk_begin + job->chunk_size : job->end;
+
+		//The chunks are taken in increasing order: the next ones can not have a smaller index.
+		if(chunk_begin >= __atomic_load_n(&job->first_index, __ATOMIC_RELAXED)) return;
+
+		index = job->find(chunk_begin, chunk_end, job->arg);
+		if(index >= chunk_end) continue;
+		first_index = __atomic_load_n(&job->first_index, __ATOMIC_RELAXED);
+		while(index < first_index && !__atomic_compare_exchange_n(&job->first_index, &first_index, index, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	}
+}
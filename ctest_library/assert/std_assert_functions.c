@@ -22,11 +22,23 @@
 #include <string.h>
 #include <strings.h>
 #include <ctype.h>
+#include "internal_alloc.h" //Must be the last include.
 
 
 //Constants:
 #define MAX_ERROR_MSG_SZ 128
 
+//Definition of types:
+typedef struct {
+    unsigned_integer *target;
+    unsigned_integer *reference;
+} unsigned_integerArray_pair;
+
+typedef struct {
+    unsigned_integer *target;
+    bool ascending_order;
+} unsigned_integerArray_order;
+
 //Local auxiliary functions:
 static char *decimal_to_binary_generate_str(unsigned_integer target, size_t num_of_digits); 
 static char *mask_compare_generate_str(unsigned_integer target, unsigned_integer reference, unsigned_integer mask, char equal_symbol, char diff_symbol);
@@ -42,6 +54,8 @@ static void unsigned_integerArray_to_array_of_sizes(unsigned_integer arr[], size
 static void free_size_t_pointer_list(size_t *array_of_sizes[]);
 static char *unsigned_integerArray_to_str(unsigned_integer target_array[], size_t target_array_size, size_t array_of_size_reference[]); 
 static char *size_tArray_to_index_str(size_t index_array[], size_t index_array_size, size_t array_of_size_reference[], size_t max_limit);
+static size_t unsigned_integerArray_find_first_difference(size_t begin, size_t end, const void *arrays);
+static size_t unsigned_integerArray_find_first_unsorted(size_t begin, size_t end, const void *order);
 
 
 static T_element unsigned_integer_to_T_element(unsigned_integer n);
@@ -89,7 +103,7 @@ void assert_unsigned_integer_equal(unsigned_integer target, unsigned_integer ref
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_unsigned_integer_equal",                            //assert_name
                          "The target value SHOULD BE EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -106,7 +120,7 @@ void assert_unsigned_integer_equal(unsigned_integer target, unsigned_integer ref
     assert_result.was_successful = (target == reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -140,7 +154,7 @@ void assert_unsigned_integer_equal(unsigned_integer target, unsigned_integer ref
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -186,7 +200,7 @@ void assert_unsigned_integer_notEqual(unsigned_integer target, unsigned_integer
     assert_result_struct assert_result = {
                                      true,                                                           //was_successful
                          line_number,                                                    //line_number
-                         "",                                                             //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                    //result_details[MAX_CHARS]
                          "assert_unsigned_integer_notEqual",                             //assert_name
                          "The target value SHOULD NOT BE EQUAL to the reference value.", //std_message
                          custom_message                                                  //custom_message
@@ -203,7 +217,7 @@ void assert_unsigned_integer_notEqual(unsigned_integer target, unsigned_integer
     assert_result.was_successful = (target != reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -237,7 +251,7 @@ void assert_unsigned_integer_notEqual(unsigned_integer target, unsigned_integer
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -282,7 +296,7 @@ void assert_unsigned_integer_greater(unsigned_integer target, unsigned_integer r
     assert_result_struct assert_result = {
                                      true,                                                           //was_successful
                          line_number,                                                    //line_number
-                         "",                                                             //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                    //result_details[MAX_CHARS]
                          "assert_unsigned_integer_greater",                              //assert_name
                          "The target value SHOULD BE GREATER than the reference value.", //std_message
                          custom_message                                                  //custom_message
@@ -299,7 +313,7 @@ void assert_unsigned_integer_greater(unsigned_integer target, unsigned_integer r
     assert_result.was_successful = (target > reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -333,7 +347,7 @@ void assert_unsigned_integer_greater(unsigned_integer target, unsigned_integer r
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -378,7 +392,7 @@ void assert_unsigned_integer_greaterEqual (unsigned_integer target, unsigned_int
     assert_result_struct assert_result = {
                                      true,                                                                  //was_successful
                          line_number,                                                           //line_number
-                         "",                                                                    //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                           //result_details[MAX_CHARS]
                          "assert_unsigned_integer_greaterEqual",                                //assert_name
                          "The target value SHOULD BE GREATER OR EQUAL to the reference value.", //std_message
                          custom_message                                                         //custom_message
@@ -395,7 +409,7 @@ void assert_unsigned_integer_greaterEqual (unsigned_integer target, unsigned_int
     assert_result.was_successful = (target >= reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -429,7 +443,7 @@ void assert_unsigned_integer_greaterEqual (unsigned_integer target, unsigned_int
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -474,7 +488,7 @@ void assert_unsigned_integer_less (unsigned_integer target, unsigned_integer ref
     assert_result_struct assert_result = {
                                      true,                                                        //was_successful
                          line_number,                                                 //line_number
-                         "",                                                          //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                 //result_details[MAX_CHARS]
                          "assert_unsigned_integer_less",                              //assert_name
                          "The target value SHOULD BE LESS than the reference value.", //std_message
                          custom_message                                               //custom_message
@@ -490,7 +504,7 @@ void assert_unsigned_integer_less (unsigned_integer target, unsigned_integer ref
     assert_result.was_successful = (target < reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -524,7 +538,7 @@ void assert_unsigned_integer_less (unsigned_integer target, unsigned_integer ref
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -568,7 +582,7 @@ void assert_unsigned_integer_lessEqual (unsigned_integer target, unsigned_intege
     assert_result_struct assert_result = {
                                      true,                                                               //was_successful
                          line_number,                                                        //line_number
-                         "",                                                                 //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                        //result_details[MAX_CHARS]
                          "assert_unsigned_integer_lessEqual",                                //assert_name
                          "The target value SHOULD BE LESS OR EQUAL to the reference value.", //std_message
                          custom_message                                                      //custom_message
@@ -584,7 +598,7 @@ void assert_unsigned_integer_lessEqual (unsigned_integer target, unsigned_intege
     assert_result.was_successful = (target <= reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -618,7 +632,7 @@ void assert_unsigned_integer_lessEqual (unsigned_integer target, unsigned_intege
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -667,7 +681,7 @@ void assert_unsigned_integer_bitMaskEqual (unsigned_integer target, unsigned_int
     assert_result_struct assert_result = {
                                      true,                                                                                                       //was_successful
                          line_number,                                                                                                //line_number
-                         "",                                                                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                                                                //result_details[MAX_CHARS]
                          "assert_unsigned_integer_bitMaskEqual",                                                                     //assert_name
                          "The bits selected by the bit mask from the target and the reference values SHOULD BE RESPECTIVELY EQUAL.", //std_message
                          custom_message                                                                                              //custom_message
@@ -683,7 +697,7 @@ void assert_unsigned_integer_bitMaskEqual (unsigned_integer target, unsigned_int
     assert_result.was_successful = (~(target ^ reference) & mask) == mask;
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -744,7 +758,7 @@ void assert_unsigned_integer_bitMaskEqual (unsigned_integer target, unsigned_int
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -793,7 +807,7 @@ void assert_integer_equal(integer target, integer reference, int line_number, ch
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_integer_equal",                                     //assert_name
                          "The target value SHOULD BE EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -809,7 +823,7 @@ void assert_integer_equal(integer target, integer reference, int line_number, ch
     assert_result.was_successful = (target == reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -843,7 +857,7 @@ void assert_integer_equal(integer target, integer reference, int line_number, ch
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -887,7 +901,7 @@ void assert_integer_notEqual     (integer target, integer reference, int line_nu
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_integer_notEqual",                            //assert_name
                          "The target value SHOULD NOT BE EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -903,7 +917,7 @@ void assert_integer_notEqual     (integer target, integer reference, int line_nu
     assert_result.was_successful = (target != reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -937,7 +951,7 @@ void assert_integer_notEqual     (integer target, integer reference, int line_nu
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -982,7 +996,7 @@ void assert_integer_greater(integer target, integer reference, int line_number,
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_integer_greater",                            //assert_name
                          "The target value SHOULD BE GREATER than the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -998,7 +1012,7 @@ void assert_integer_greater(integer target, integer reference, int line_number,
     assert_result.was_successful = (target > reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -1032,7 +1046,7 @@ void assert_integer_greater(integer target, integer reference, int line_number,
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1078,7 +1092,7 @@ void assert_integer_greaterEqual (integer target, integer reference, int line_nu
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_integer_greaterEqual",                            //assert_name
                          "The target value SHOULD BE GREATER OR EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1094,7 +1108,7 @@ void assert_integer_greaterEqual (integer target, integer reference, int line_nu
     assert_result.was_successful = (target >= reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -1128,7 +1142,7 @@ void assert_integer_greaterEqual (integer target, integer reference, int line_nu
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1174,7 +1188,7 @@ void assert_integer_less (integer target, integer reference, int line_number, ch
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_integer_less",                            //assert_name
                          "The target value SHOULD BE LESS than the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1190,7 +1204,7 @@ void assert_integer_less (integer target, integer reference, int line_number, ch
     assert_result.was_successful = (target < reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -1224,7 +1238,7 @@ void assert_integer_less (integer target, integer reference, int line_number, ch
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1270,7 +1284,7 @@ void assert_integer_lessEqual (integer target, integer reference, int line_numbe
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_integer_lessEqual",                            //assert_name
                          "The target value SHOULD BE LESS OR EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1286,7 +1300,7 @@ void assert_integer_lessEqual (integer target, integer reference, int line_numbe
     assert_result.was_successful = (target <= reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -1320,7 +1334,7 @@ void assert_integer_lessEqual (integer target, integer reference, int line_numbe
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1377,7 +1391,7 @@ void assert_floating_point_almostEqual(floating_point target, floating_point ref
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_floating_point_almostEqual",                            //assert_name
                          "The target value SHOULD BE ALMOST EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1406,7 +1420,7 @@ void assert_floating_point_almostEqual(floating_point target, floating_point ref
     assert_result.was_successful = fabs(target - reference) < max_diff;
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
 
         //------------------------------------------------------------------------------
@@ -1448,7 +1462,7 @@ void assert_floating_point_almostEqual(floating_point target, floating_point ref
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1503,7 +1517,7 @@ void assert_floating_point_notAlmostEqual(floating_point target, floating_point
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_floating_point_notAlmostEqual",                            //assert_name
                          "The target value SHOULD BE NOT ALMOST EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1532,7 +1546,7 @@ void assert_floating_point_notAlmostEqual(floating_point target, floating_point
     assert_result.was_successful = fabs(target - reference) >= min_diff;
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
 
         //------------------------------------------------------------------------------
@@ -1574,7 +1588,7 @@ void assert_floating_point_notAlmostEqual(floating_point target, floating_point
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1619,7 +1633,7 @@ void assert_floating_point_greater(floating_point target, floating_point referen
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_floating_point_greater",                            //assert_name
                          "The target value SHOULD BE GREATER than the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1635,7 +1649,7 @@ void assert_floating_point_greater(floating_point target, floating_point referen
     assert_result.was_successful = (target > reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -1669,7 +1683,7 @@ void assert_floating_point_greater(floating_point target, floating_point referen
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1714,7 +1728,7 @@ void assert_floating_point_greaterEqual (floating_point target, floating_point r
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_floating_point_greaterEqual",                            //assert_name
                          "The target value SHOULD BE GREATER OR EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1730,7 +1744,7 @@ void assert_floating_point_greaterEqual (floating_point target, floating_point r
     assert_result.was_successful = (target >= reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -1764,7 +1778,7 @@ void assert_floating_point_greaterEqual (floating_point target, floating_point r
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1809,7 +1823,7 @@ void assert_floating_point_less (floating_point target, floating_point reference
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_floating_point_less",                            //assert_name
                          "The target value SHOULD BE LESS than the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1825,7 +1839,7 @@ void assert_floating_point_less (floating_point target, floating_point reference
     assert_result.was_successful = (target < reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -1859,7 +1873,7 @@ void assert_floating_point_less (floating_point target, floating_point reference
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -1904,7 +1918,7 @@ void assert_floating_point_lessEqual (floating_point target, floating_point refe
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_floating_point_lessEqual",                            //assert_name
                          "The target value SHOULD BE LESS OR EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -1920,7 +1934,7 @@ void assert_floating_point_lessEqual (floating_point target, floating_point refe
     assert_result.was_successful = (target <= reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -1954,7 +1968,7 @@ void assert_floating_point_lessEqual (floating_point target, floating_point refe
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2002,7 +2016,7 @@ void assert_bool_equal(bool target, bool reference, int line_number, char custom
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_bool_equal",                            //assert_name
                          "The target value SHOULD BE EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -2018,7 +2032,7 @@ void assert_bool_equal(bool target, bool reference, int line_number, char custom
     assert_result.was_successful = (target == reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2052,7 +2066,7 @@ void assert_bool_equal(bool target, bool reference, int line_number, char custom
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2097,7 +2111,7 @@ void assert_bool_notEqual(bool target, bool reference, int line_number, char cus
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_bool_notEqual",                            //assert_name
                          "The target value SHOULD NOT BE EQUAL to the reference value.", //std_message
                          custom_message                                              //custom_message
@@ -2113,7 +2127,7 @@ void assert_bool_notEqual(bool target, bool reference, int line_number, char cus
     assert_result.was_successful = (target != reference);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2147,7 +2161,7 @@ void assert_bool_notEqual(bool target, bool reference, int line_number, char cus
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2190,7 +2204,7 @@ void assert_bool_true(bool target, int line_number, char custom_message[])
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_bool_true",                            //assert_name
                          "The target value SHOULD BE true.", //std_message
                          custom_message                                              //custom_message
@@ -2206,7 +2220,7 @@ void assert_bool_true(bool target, int line_number, char custom_message[])
     assert_result.was_successful = (target == true);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2237,7 +2251,7 @@ void assert_bool_true(bool target, int line_number, char custom_message[])
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2280,7 +2294,7 @@ void assert_bool_false(bool target, int line_number, char custom_message[])
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_bool_false",                            //assert_name
                          "The target value SHOULD BE false.", //std_message
                          custom_message                                              //custom_message
@@ -2296,7 +2310,7 @@ void assert_bool_false(bool target, int line_number, char custom_message[])
     assert_result.was_successful = (target == false);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2327,7 +2341,7 @@ void assert_bool_false(bool target, int line_number, char custom_message[])
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2370,7 +2384,7 @@ void assert_pointer_isNULL(void *target, int line_number, char custom_message[])
     assert_result_struct assert_result = {
                                      true,                       //was_successful
                          line_number,                            //line_number
-                         "",                                     //result_details[MAX_CHARS]
+                         get_result_details_buffer(),            //result_details[MAX_CHARS]
                          "assert_pointer_isNULL",                //assert_name
                          "The pointer 'target' SHOULD BE NULL.", //std_message
                          custom_message                          //custom_message
@@ -2386,7 +2400,7 @@ void assert_pointer_isNULL(void *target, int line_number, char custom_message[])
     assert_result.was_successful = (target == NULL);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2418,7 +2432,7 @@ void assert_pointer_isNULL(void *target, int line_number, char custom_message[])
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2462,7 +2476,7 @@ void assert_pointer_notIsNULL(void *target, int line_number, char custom_message
     assert_result_struct assert_result = {
                                      true,                       //was_successful
                          line_number,                            //line_number
-                         "",                                     //result_details[MAX_CHARS]
+                         get_result_details_buffer(),            //result_details[MAX_CHARS]
                          "assert_pointer_notIsNULL",                //assert_name
                          "The pointer 'target' SHOULD NOT BE NULL.", //std_message
                          custom_message                          //custom_message
@@ -2478,7 +2492,7 @@ void assert_pointer_notIsNULL(void *target, int line_number, char custom_message
     assert_result.was_successful = (target != NULL);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2510,7 +2524,7 @@ void assert_pointer_notIsNULL(void *target, int line_number, char custom_message
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2561,7 +2575,7 @@ void assert_unsigned_integerArray_equal (unsigned_integer target[], size_t targe
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_unsigned_integerArray_equal",                            //assert_name
                          "Each element of the target array SHOULD BE EQUAL to each respective element of the reference array.", //std_message
                          custom_message                                              //custom_message
@@ -2580,20 +2594,14 @@ void assert_unsigned_integerArray_equal (unsigned_integer target[], size_t targe
         assert_result.was_successful = false;
     else
     {
-        //Check each element:
-        size_t i;
-        for(i = 0; i < target_size; i++)
-        {
-            if(target[i] != reference[i])
-            {
-                assert_result.was_successful = false;
-                break;
-            }
-        }
+        //Check each element (a large array is split across threads, see parallel.c):
+        unsigned_integerArray_pair arrays = {target, reference};
+        if(parallel_find_first(0, target_size, unsigned_integerArray_find_first_difference, &arrays) != target_size)
+            assert_result.was_successful = false;
     }
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2650,7 +2658,7 @@ void assert_unsigned_integerArray_equal (unsigned_integer target[], size_t targe
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2700,7 +2708,7 @@ void assert_unsigned_integerArray_notEqual (unsigned_integer target[], size_t ta
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_unsigned_integerArray_notEqual",                            //assert_name
                          "The target array SHOULD NOT BE EQUAL to the reference array.", //std_message
                          custom_message                                              //custom_message
@@ -2719,20 +2727,14 @@ void assert_unsigned_integerArray_notEqual (unsigned_integer target[], size_t ta
         assert_result.was_successful = true;
     else
     {
-        //Check each element:
-        size_t i;
-        for(i = 0; i < target_size; i++)
-        {
-            if(target[i] != reference[i])
-            {
-                assert_result.was_successful = true;
-                break;
-            }
-        }
+        //Check each element (a large array is split across threads, see parallel.c):
+        unsigned_integerArray_pair arrays = {target, reference};
+        if(parallel_find_first(0, target_size, unsigned_integerArray_find_first_difference, &arrays) != target_size)
+            assert_result.was_successful = true;
     }
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2789,7 +2791,7 @@ void assert_unsigned_integerArray_notEqual (unsigned_integer target[], size_t ta
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -2834,7 +2836,7 @@ void assert_unsigned_integerArray_sorted(unsigned_integer target[], size_t targe
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_unsigned_integerArray_sorted",                            //assert_name
                          "", //std_message
                          custom_message                                              //custom_message
@@ -2855,30 +2857,14 @@ void assert_unsigned_integerArray_sorted(unsigned_integer target[], size_t targe
     //Check if the array is sorted only if it has more than 1 element:
     if(target_size > 1)
     {
-        size_t i;
-        for(i = 1; i < target_size; i++)
-        {
-            if(ascending_order)
-            {
-                if(target[i] < target[i - 1])
-                {
-                    assert_result.was_successful = false;
-                    break;
-                }
-            }
-            else
-            {
-                if(target[i] > target[i - 1])
-                {
-                    assert_result.was_successful = false;
-                    break;
-                }
-            }
-        }
+        //A large array is split across threads (see parallel.c):
+        unsigned_integerArray_order order = {target, ascending_order};
+        if(parallel_find_first(1, target_size, unsigned_integerArray_find_first_unsorted, &order) != target_size)
+            assert_result.was_successful = false;
     }
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -2935,7 +2921,7 @@ print:
     else
         assert_result.std_message = std_message_dsc;
 
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
 
     
     //------------------------------------------------------------------------------
@@ -2982,7 +2968,7 @@ void assert_unsigned_integerArray_notSorted(unsigned_integer target[], size_t ta
     assert_result_struct assert_result = {
                                      true,                                                       //was_successful
                          line_number,                                                //line_number
-                         "",                                                         //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                //result_details[MAX_CHARS]
                          "assert_unsigned_integerArray_notSorted",                            //assert_name
                          "", //std_message
                          custom_message                                              //custom_message
@@ -3003,30 +2989,14 @@ void assert_unsigned_integerArray_notSorted(unsigned_integer target[], size_t ta
     //Check if the array is sorted only if it has more than 1 element:
     if(target_size > 1)
     {
-        size_t i;
-        for(i = 1; i < target_size; i++)
-        {
-            if(ascending_order)
-            {
-                if(target[i] < target[i - 1]) //Not sorted
-                {
-                    assert_result.was_successful = true;
-                    break;
-                }
-            }
-            else
-            {
-                if(target[i] > target[i - 1]) //Not sorted
-                {
-                    assert_result.was_successful = true;
-                    break;
-                }
-            }
-        }
+        //A large array is split across threads (see parallel.c):
+        unsigned_integerArray_order order = {target, ascending_order};
+        if(parallel_find_first(1, target_size, unsigned_integerArray_find_first_unsorted, &order) != target_size)
+            assert_result.was_successful = true;
     }
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -3083,7 +3053,7 @@ print:
     else
         assert_result.std_message = std_message_dsc;
 
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
 
     
     //------------------------------------------------------------------------------
@@ -3151,7 +3121,7 @@ void assert_unsigned_integerArray_permutation(unsigned_integer target[], size_t
     assert_result_struct assert_result = {
                                      true,                                                               //was_successful
                                      line_number,                                                        //line_number
-                                     "",                                                                 //result_details[MAX_CHARS]
+                                     get_result_details_buffer(),                                        //result_details[MAX_CHARS]
                                      "assert_unsigned_integerArray_permutation",                         //assert_name
                                      "The target array SHOULD BE A PERMUTATION of the reference array.", //std_message
                                      custom_message                                                      //custom_message
@@ -3188,7 +3158,7 @@ void assert_unsigned_integerArray_permutation(unsigned_integer target[], size_t
     D_delete_dict(&ref_counter_dict);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -3275,7 +3245,7 @@ void assert_unsigned_integerArray_permutation(unsigned_integer target[], size_t
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -3334,7 +3304,7 @@ void assert_unsigned_integerArray_notPermutation(unsigned_integer target[], size
     assert_result_struct assert_result = {
                                      true,                                                                   //was_successful
                                      line_number,                                                            //line_number
-                                     "",                                                                     //result_details[MAX_CHARS]
+                                     get_result_details_buffer(),                                            //result_details[MAX_CHARS]
                                      "assert_unsigned_integerArray_notPermutation",                          //assert_name
                                      "The target array SHOULD NOT BE A PERMUTATION of the reference array.", //std_message
                                      custom_message                                                          //custom_message
@@ -3372,7 +3342,7 @@ void assert_unsigned_integerArray_notPermutation(unsigned_integer target[], size
 
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -3459,7 +3429,7 @@ void assert_unsigned_integerArray_notPermutation(unsigned_integer target[], size
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -3527,7 +3497,7 @@ void assert_unsigned_integerArray_isPartialPermutation(unsigned_integer target[]
     assert_result_struct assert_result = {
                                      true,                                                               //was_successful
                                      line_number,                                                        //line_number
-                                     "",                                                                 //result_details[MAX_CHARS]
+                                     get_result_details_buffer(),                                        //result_details[MAX_CHARS]
                                      "assert_unsigned_integerArray_isPartialPermutation",                         //assert_name
                                      "The target array SHOULD BE A PARTIAL PERMUTATION of the reference array.", //std_message
                                      custom_message                                                      //custom_message
@@ -3562,7 +3532,7 @@ void assert_unsigned_integerArray_isPartialPermutation(unsigned_integer target[]
     D_delete_dict(&ref_counter_dict);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -3649,7 +3619,7 @@ void assert_unsigned_integerArray_isPartialPermutation(unsigned_integer target[]
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -3709,7 +3679,7 @@ void assert_unsigned_integerArray_notIsPartialPermutation(unsigned_integer targe
     assert_result_struct assert_result = {
                                      true,                                                                   //was_successful
                                      line_number,                                                            //line_number
-                                     "",                                                                     //result_details[MAX_CHARS]
+                                     get_result_details_buffer(),                                            //result_details[MAX_CHARS]
                                      "assert_unsigned_integerArray_notIsPartialPermutation",                          //assert_name
                                      "The target array SHOULD NOT BE A PARTIAL PERMUTATION of the reference array.", //std_message
                                      custom_message                                                          //custom_message
@@ -3745,7 +3715,7 @@ void assert_unsigned_integerArray_notIsPartialPermutation(unsigned_integer targe
 
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -3832,7 +3802,7 @@ void assert_unsigned_integerArray_notIsPartialPermutation(unsigned_integer targe
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -3900,7 +3870,7 @@ void assert_unsigned_integerArray_hasPartialPermutation(unsigned_integer target[
     assert_result_struct assert_result = {
                                      true,                                                               //was_successful
                                      line_number,                                                        //line_number
-                                     "",                                                                 //result_details[MAX_CHARS]
+                                     get_result_details_buffer(),                                        //result_details[MAX_CHARS]
                                      "assert_unsigned_integerArray_hasPartialPermutation",                         //assert_name
                                      "The target array SHOULD HAVE AS PARTIAL PERMUTATION the reference array.", //std_message
                                      custom_message                                                      //custom_message
@@ -3935,7 +3905,7 @@ void assert_unsigned_integerArray_hasPartialPermutation(unsigned_integer target[
     D_delete_dict(&target_counter_dict);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -4023,7 +3993,7 @@ void assert_unsigned_integerArray_hasPartialPermutation(unsigned_integer target[
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -4082,7 +4052,7 @@ void assert_unsigned_integerArray_notHasPartialPermutation(unsigned_integer targ
     assert_result_struct assert_result = {
                                      true,                                                               //was_successful
                                      line_number,                                                        //line_number
-                                     "",                                                                 //result_details[MAX_CHARS]
+                                     get_result_details_buffer(),                                        //result_details[MAX_CHARS]
                                      "assert_unsigned_integerArray_notHasPartialPermutation",                         //assert_name
                                      "The target array SHOULD NOT HAVE AS PARTIAL PERMUTATION the reference array.", //std_message
                                      custom_message                                                      //custom_message
@@ -4116,7 +4086,7 @@ void assert_unsigned_integerArray_notHasPartialPermutation(unsigned_integer targ
     D_delete_dict(&target_counter_dict);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //------------------------------------------------------------------------------
         //Generate the details for a highly verbose fail message:
@@ -4204,7 +4174,7 @@ void assert_unsigned_integerArray_notHasPartialPermutation(unsigned_integer targ
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -4254,7 +4224,7 @@ void assert_string_equal (char target[], char reference[], bool ignore_case, int
     assert_result_struct assert_result = {
                          true,                                                             //was_successful
                          line_number,                                                      //line_number
-                         "",                                                               //result_details[MAX_CHARS]
+                         get_result_details_buffer(),                                      //result_details[MAX_CHARS]
                          "assert_string_equal",                                            //assert_name
                          "The string 'target' SHOULD BE EQUAL to the string 'reference'.", //std_message
                          custom_message                                                    //custom_message
@@ -4271,7 +4241,7 @@ void assert_string_equal (char target[], char reference[], bool ignore_case, int
     else assert_result.was_successful = !strncmp(target, reference, max_string_size);
 
     //Check if it is necessary to generate highly verbose details in case of fail:
-    if(!assert_result.was_successful && verbose == HIGH)
+    if(failure_details_are_needed(&assert_result))
     {
         //Check for chars like '\n', '\t':
         if(check_for_special_char(target) || check_for_special_char(reference)) 
@@ -4331,7 +4301,7 @@ void assert_string_equal (char target[], char reference[], bool ignore_case, int
     //------------------------------------------------------------------------------
     //Print the result:
 print:
-    print_assert_result(assert_result);
+    print_assert_result(&assert_result);
     
     //------------------------------------------------------------------------------
     //Finish:
@@ -5423,6 +5393,44 @@ static char *size_tArray_to_index_str(size_t index_array[], size_t index_array_s
 
 }
 
+static size_t unsigned_integerArray_find_first_difference(size_t begin, size_t end, const void *arrays)
+/**
+ * Description: This function returns the first index of [begin, end) at which
+ * the arrays of 'arrays' (unsigned_integerArray_pair) differ, or 'end'.
+ */
+{
+    const unsigned_integerArray_pair *pair = arrays;
+    size_t i;
+
+    for(i = begin; i < end; i++)
+        if(pair->target[i] != pair->reference[i]) return i;
+    return end;
+}
+
+static size_t unsigned_integerArray_find_first_unsorted(size_t begin, size_t end, const void *order)
+/**
+ * Description: This function returns the first index i of [begin, end) (begin
+ * > 0) such that target[i - 1] and target[i] are not in the order of 'order'
+ * (unsigned_integerArray_order), or 'end'.
+ */
+{
+    const unsigned_integerArray_order *array_order = order;
+    const unsigned_integer *target = array_order->target;
+    size_t i;
+
+    if(array_order->ascending_order)
+    {
+        for(i = begin; i < end; i++)
+            if(target[i] < target[i - 1]) return i;
+    }
+    else
+    {
+        for(i = begin; i < end; i++)
+            if(target[i] > target[i - 1]) return i;
+    }
+    return end;
+}
+
 static T_element unsigned_integer_to_T_element(unsigned_integer n)
 {
     return (T_element){{.u_i = n}, UNSIGNED_INTEGER};
@@ -12,11 +12,341 @@
 #define _CTEST_STD_ASSERT_MACROS_H
 
 /*STD macros for I/O*/
-/*WITH_ASSERT_STDOUT_EQUAL(EXPECTED_CONTENT, LINE_NUMBER, MSG){ <PIECE_OF_CODE> }END_WITH;*/
-/*WITH_ASSERT_STDERR_EQUAL(EXPECTED_CONTENT, LINE_NUMBER, MSG){ <PIECE_OF_CODE> }END_WITH;*/
-/*WITH_ASSERT_STREAM_OUT_EQUAL(STREAM_OUT, EXPECTED_CONTENT, LINE_NUMBER, MSG){ <PIECE_OF_CODE> }END_WITH;*/
-/*WITH_ASSERT_EXIT_STATUS_EQUAL(EXPECTED_STATUS, LINE_NUMBER, MSG){ <PIECE_OF_CODE> }END_WITH;*/
-/*WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(UNEXPECTED_STATUS, LINE_NUMBER, MSG){ <PIECE_OF_CODE> }END_WITH;*/
+
+/**
+ * Macro Name: WITH_ASSERT_STDOUT_EQUAL
+ * Description: This macro opens a block whose output to stdout is captured in
+ * memory (the file descriptor 1 is redirected onto a memfd, so writes through
+ * 'stdout', printf, puts and write(1, ...) are all captured). At END_WITH the
+ * captured content is compared with EXPECTED_CONTENT and stdout is restored.
+ * The stream is also restored if the block is left early (break, return, goto).
+ * 	The block must be ended with END_WITH followed by a semicolon.
+ * 	Assertions should not be made inside the block: their output would be 
+ * captured too.
+ * 	If 'ignore' is true, the block is executed without capturing anything.
+ * Ex:
+ * 	WITH_ASSERT_STDOUT_EQUAL("Hello world!\n", __LINE__, NULL)
+ * 	{
+ * 		printf("Hello world!\n");
+ * 	}END_WITH;
+ *
+ * Input:
+ * 	EXPECTED_CONTENT --> String with the content that stdout must receive.
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed if the assertion fails.
+ */
+#define WITH_ASSERT_STDOUT_EQUAL(EXPECTED_CONTENT, LINE_NUMBER, CUSTOM_MESSAGE) \
+{\
+	with_assert_struct with_assert_block __attribute__((cleanup(with_assert_cleanup))) = {0};\
+	if(with_assert_stdout_equal_begin(&with_assert_block, (EXPECTED_CONTENT), (LINE_NUMBER), (CUSTOM_MESSAGE)))\
+	do
+
+
+
+/**
+ * Macro Name: WITH_ASSERT_STDERR_EQUAL
+ * Description: This macro opens a block whose output to stderr is captured in
+ * memory. It works exactly like WITH_ASSERT_STDOUT_EQUAL.
+ * Ex:
+ * 	WITH_ASSERT_STDERR_EQUAL("Error.\n", __LINE__, NULL)
+ * 	{
+ * 		fprintf(stderr, "Error.\n");
+ * 	}END_WITH;
+ *
+ * Input:
+ * 	EXPECTED_CONTENT --> String with the content that stderr must receive.
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed if the assertion fails.
+ */
+#define WITH_ASSERT_STDERR_EQUAL(EXPECTED_CONTENT, LINE_NUMBER, CUSTOM_MESSAGE) \
+{\
+	with_assert_struct with_assert_block __attribute__((cleanup(with_assert_cleanup))) = {0};\
+	if(with_assert_stderr_equal_begin(&with_assert_block, (EXPECTED_CONTENT), (LINE_NUMBER), (CUSTOM_MESSAGE)))\
+	do
+
+
+
+/**
+ * Macro Name: WITH_ASSERT_STREAM_OUT_EQUAL
+ * Description: This macro opens a block whose output to the stream STREAM_OUT
+ * is captured in memory. If STREAM_OUT has a file descriptor, the descriptor is
+ * redirected onto a memfd. Otherwise (e.g. a stream created with fmemopen), 
+ * the variable STREAM_OUT is replaced by an open_memstream stream until 
+ * END_WITH, so the code inside the block must read the variable when writing.
+ * 	The block must be ended with END_WITH followed by a semicolon.
+ * Ex:
+ * 	WITH_ASSERT_STREAM_OUT_EQUAL(log_stream, "log message\n", __LINE__, NULL)
+ * 	{
+ * 		fprintf(log_stream, "log message\n");
+ * 	}END_WITH;
+ *
+ * Input:
+ * 	STREAM_OUT       --> Variable (lvalue) of type (FILE *).
+ * 	EXPECTED_CONTENT --> String with the content that the stream must receive.
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed if the assertion fails.
+ */
+#define WITH_ASSERT_STREAM_OUT_EQUAL(STREAM_OUT, EXPECTED_CONTENT, LINE_NUMBER, CUSTOM_MESSAGE) \
+{\
+	with_assert_struct with_assert_block __attribute__((cleanup(with_assert_cleanup))) = {0};\
+	if(with_assert_stream_out_equal_begin(&with_assert_block, &(STREAM_OUT), (EXPECTED_CONTENT), (LINE_NUMBER), (CUSTOM_MESSAGE)))\
+	do
+
+
+
+/*STD macros for exit status and signals*/
+
+/**
+ * Macro Name: WITH_ASSERT_EXIT_STATUS_EQUAL
+ * Description: This macro opens a block that is executed by a child process 
+ * (fork). The block passes if the child exits with the status EXPECTED_STATUS.
+ * If the body reaches END_WITH, the child exits with EXIT_SUCCESS. The results
+ * of assertions made inside the block are merged into the current module. 
+ * Changes made by the block to the memory of the test are not seen after it.
+ * 	The block must be ended with END_WITH followed by a semicolon.
+ * 	If 'ignore' is true, the block is not executed.
+ * Ex:
+ * 	WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_FAILURE, __LINE__, NULL)
+ * 	{
+ * 		A_pop(empty_array); //Calls exit(EXIT_FAILURE).
+ * 	}END_WITH;
+ *
+ * Input:
+ * 	EXPECTED_STATUS  --> The status that the block must exit with.
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed if the assertion fails.
+ */
+#define WITH_ASSERT_EXIT_STATUS_EQUAL(EXPECTED_STATUS, LINE_NUMBER, CUSTOM_MESSAGE) \
+{\
+	with_assert_struct with_assert_block __attribute__((cleanup(with_assert_cleanup))) = {0};\
+	if(with_assert_exit_status_equal_begin(&with_assert_block, (EXPECTED_STATUS), (LINE_NUMBER), (CUSTOM_MESSAGE)))\
+	do
+
+
+
+/**
+ * Macro Name: WITH_ASSERT_EXIT_STATUS_NOT_EQUAL
+ * Description: This macro works like WITH_ASSERT_EXIT_STATUS_EQUAL, but the
+ * block passes if the child exits with a status different from 
+ * UNEXPECTED_STATUS. If the child is terminated by a signal, the block fails.
+ * Ex:
+ * 	WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(EXIT_SUCCESS, __LINE__, NULL)
+ * 	{
+ * 		exit(3);
+ * 	}END_WITH;
+ *
+ * Input:
+ * 	UNEXPECTED_STATUS --> The status that the block must not exit with.
+ * 	LINE_NUMBER       --> The number of the line.
+ * 	CUSTOM_MESSAGE    --> Custom message that will be printed if the assertion fails.
+ */
+#define WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(UNEXPECTED_STATUS, LINE_NUMBER, CUSTOM_MESSAGE) \
+{\
+	with_assert_struct with_assert_block __attribute__((cleanup(with_assert_cleanup))) = {0};\
+	if(with_assert_exit_status_notEqual_begin(&with_assert_block, (UNEXPECTED_STATUS), (LINE_NUMBER), (CUSTOM_MESSAGE)))\
+	do
+
+
+
+/**
+ * Macro Name: WITH_ASSERT_SIGNAL_EQUAL
+ * Description: This macro opens a death test: the block is executed by a child
+ * process (fork) and passes if the child is terminated by EXPECTED_SIGNAL. No
+ * core file is generated by the child.
+ * Ex:
+ * 	WITH_ASSERT_SIGNAL_EQUAL(SIGABRT, __LINE__, NULL)
+ * 	{
+ * 		abort();
+ * 	}END_WITH;
+ *
+ * Input:
+ * 	EXPECTED_SIGNAL  --> The signal that must terminate the block (e.g. SIGSEGV).
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed if the assertion fails.
+ */
+#define WITH_ASSERT_SIGNAL_EQUAL(EXPECTED_SIGNAL, LINE_NUMBER, CUSTOM_MESSAGE) \
+{\
+	with_assert_struct with_assert_block __attribute__((cleanup(with_assert_cleanup))) = {0};\
+	if(with_assert_signal_equal_begin(&with_assert_block, (EXPECTED_SIGNAL), (LINE_NUMBER), (CUSTOM_MESSAGE)))\
+	do
+
+
+
+/*STD macros for allocations*/
+
+/**
+ * Macro Name: WITH_ASSERT_MAX_ALLOCATIONS
+ * Description: This macro opens a block that passes if the current thread
+ * calls malloc, calloc and realloc at most MAX_ALLOCATIONS times inside it.
+ * The allocations of ctest itself and of other threads are not counted. The
+ * test must be linked with the allocation hooks (CTEST_ALLOC_HOOKS_LINK_FLAGS),
+ * otherwise the block prints an error message and exits a failure code.
+ * 	The block must be ended with END_WITH followed by a semicolon.
+ * 	If 'ignore' is true, the block is executed without counting anything.
+ * Ex:
+ * 	WITH_ASSERT_MAX_ALLOCATIONS(0, __LINE__, NULL)
+ * 	{
+ * 		process_packet(&packet);
+ * 	}END_WITH;
+ *
+ * Input:
+ * 	MAX_ALLOCATIONS  --> The maximum number of allocations of the block.
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed if the assertion fails.
+ */
+#define WITH_ASSERT_MAX_ALLOCATIONS(MAX_ALLOCATIONS, LINE_NUMBER, CUSTOM_MESSAGE) \
+{\
+	with_assert_struct with_assert_block __attribute__((cleanup(with_assert_cleanup))) = {0};\
+	if(with_assert_max_allocations_begin(&with_assert_block, (MAX_ALLOCATIONS), (LINE_NUMBER), (CUSTOM_MESSAGE)))\
+	do
+
+
+
+/**
+ * Macro Name: WITH_ASSERT_MAX_BYTES_ALLOCATED
+ * Description: This macro works like WITH_ASSERT_MAX_ALLOCATIONS, but the
+ * block passes if the current thread requests at most MAX_BYTES bytes from
+ * malloc, calloc and realloc inside it (freed memory is not subtracted).
+ * Ex:
+ * 	WITH_ASSERT_MAX_BYTES_ALLOCATED(4096, __LINE__, NULL)
+ * 	{
+ * 		parse_header(&request);
+ * 	}END_WITH;
+ *
+ * Input:
+ * 	MAX_BYTES        --> The maximum number of bytes allocated by the block.
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed if the assertion fails.
+ */
+#define WITH_ASSERT_MAX_BYTES_ALLOCATED(MAX_BYTES, LINE_NUMBER, CUSTOM_MESSAGE) \
+{\
+	with_assert_struct with_assert_block __attribute__((cleanup(with_assert_cleanup))) = {0};\
+	if(with_assert_max_bytesAllocated_begin(&with_assert_block, (MAX_BYTES), (LINE_NUMBER), (CUSTOM_MESSAGE)))\
+	do
+
+
+
+/**
+ * Macro Name: END_WITH
+ * Description: This macro closes the innermost WITH_ASSERT_* block, evaluating
+ * and printing its result. It must be followed by a semicolon.
+ */
+#define END_WITH \
+	while(0);\
+	with_assert_end(&with_assert_block);\
+}\
+do {;} while (0)
+
+
+
+
+/*STD macros for batched assertions*/
+
+/**
+ * Macro Name: CTEST_BATCH_BEGIN
+ * Description: This macro opens a batch of expectations of the calling thread.
+ * Inside the batch, each BATCH_EXPECT_* only records its comparison; the batch
+ * is evaluated by vectorized kernels when CTEST_BATCH_SIZE expectations are 
+ * buffered and at CTEST_BATCH_END (see batch_assert.c). It replaces a loop of
+ * assertions, which makes one result per element.
+ * 	Batches can not be nested.
+ * Ex:
+ * 	CTEST_BATCH_BEGIN();
+ * 	for(i = 0; i < size; i++) BATCH_EXPECT_UNSIGNED_INTEGER_EQUAL(out[i], expected[i], __LINE__);
+ * 	CTEST_BATCH_END(__LINE__, NULL);
+ */
+#define CTEST_BATCH_BEGIN() batch_begin()
+
+
+
+/**
+ * Macro Name: CTEST_BATCH_END
+ * Description: This macro evaluates and closes the batch. If every expectation
+ * is satisfied, one success is reported (CTEST_BATCH); otherwise, each failing
+ * expectation is reported as a fail at its own line.
+ *
+ * Input:
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed with each fail.
+ */
+#define CTEST_BATCH_END(LINE_NUMBER, CUSTOM_MESSAGE) batch_end((LINE_NUMBER), (CUSTOM_MESSAGE))
+
+
+
+/**
+ * Macro Name: BATCH_EXPECT_UNSIGNED_INTEGER_* and BATCH_EXPECT_INTEGER_*
+ * Description: These macros append to the open batch the expectation that 
+ * TARGET is EQUAL, NOT_EQUAL, GREATER, GREATER_EQUAL, LESS or LESS_EQUAL to
+ * REFERENCE (compared as unsigned_integer or as integer values).
+ *
+ * Input:
+ * 	TARGET           --> The target value.
+ * 	REFERENCE        --> The reference value.
+ * 	LINE_NUMBER      --> The number of the line.
+ */
+#define BATCH_EXPECT_UNSIGNED_INTEGER_EQUAL(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_UNSIGNED_INTEGER_EQUAL, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_UNSIGNED_INTEGER_NOT_EQUAL(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_UNSIGNED_INTEGER_NOT_EQUAL, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_UNSIGNED_INTEGER_GREATER(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_UNSIGNED_INTEGER_GREATER, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_UNSIGNED_INTEGER_GREATER_EQUAL(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_UNSIGNED_INTEGER_GREATER_EQUAL, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_UNSIGNED_INTEGER_LESS(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_UNSIGNED_INTEGER_LESS, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_UNSIGNED_INTEGER_LESS_EQUAL(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_UNSIGNED_INTEGER_LESS_EQUAL, (TARGET), (REFERENCE), (LINE_NUMBER))
+
+#define BATCH_EXPECT_INTEGER_EQUAL(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_INTEGER_EQUAL, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_INTEGER_NOT_EQUAL(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_INTEGER_NOT_EQUAL, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_INTEGER_GREATER(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_INTEGER_GREATER, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_INTEGER_GREATER_EQUAL(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_INTEGER_GREATER_EQUAL, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_INTEGER_LESS(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_INTEGER_LESS, (TARGET), (REFERENCE), (LINE_NUMBER))
+#define BATCH_EXPECT_INTEGER_LESS_EQUAL(TARGET, REFERENCE, LINE_NUMBER) batch_expect(BATCH_INTEGER_LESS_EQUAL, (TARGET), (REFERENCE), (LINE_NUMBER))
+
+
+
+
+/*STD macros for digests*/
+
+/**
+ * Macro Name: ASSERT_ARRAY_DIGEST_EQUAL
+ * Description: This macro checks if the digest of the bytes of the TARGET_SIZE
+ * elements of TARGET (an array of any type) is EXPECTED_DIGEST, a string of 32
+ * (fast128) or 64 (sha256) hexadecimal digits (see digest_assert.c). The array
+ * is hashed in place, not copied.
+ *
+ * Input:
+ * 	TARGET           --> The target array.
+ * 	TARGET_SIZE      --> The number of elements of the target array.
+ * 	EXPECTED_DIGEST  --> The expected hexadecimal digest.
+ * 	LINE_NUMBER      --> The number of the line.
+ * 	CUSTOM_MESSAGE   --> Custom message that will be printed if the test fails.
+ */
+#define ASSERT_ARRAY_DIGEST_EQUAL(TARGET, TARGET_SIZE, EXPECTED_DIGEST, LINE_NUMBER, CUSTOM_MESSAGE) \
+	assert_buffer_digestEqual((TARGET), (TARGET_SIZE) * sizeof (TARGET)[0], (EXPECTED_DIGEST), (LINE_NUMBER), (CUSTOM_MESSAGE))
+
+
+
+
+/*STD macros for matrix views*/
+
+/**
+ * Macro Name: MATRIX_VIEW, MATRIX_STRIDED_VIEW and MATRIX_COLUMN_VIEW
+ * Description: These macros make the view (ctest_matrix_view) of a matrix kept
+ * in an array of unsigned_integer, integer or floating_point elements, given to
+ * the matrix assertions (e.g. assert_integerMatrix_equal). The elements are not
+ * copied. The strides and the leading dimensions are numbers of elements.
+ *     - MATRIX_VIEW: row-major matrix of NUM_OF_ROWS x NUM_OF_COLS, with
+ * LEADING_DIMENSION elements from a row to the next one (>= NUM_OF_COLS);
+ *     - MATRIX_STRIDED_VIEW: any layout, e.g. a column-major matrix has a
+ * ROW_STRIDE of 1 and a COL_STRIDE of its leading dimension;
+ *     - MATRIX_COLUMN_VIEW: the column COL of a row-major matrix, as a matrix of
+ * NUM_OF_ROWS x 1.
+ * Ex:
+ * 	assert_floating_pointMatrix_almostEqual(MATRIX_VIEW(c, m, n, ldc), MATRIX_STRIDED_VIEW(expected, m, n, 1, m), 1e-9, __LINE__, NULL);
+ */
+#define MATRIX_VIEW(DATA, NUM_OF_ROWS, NUM_OF_COLS, LEADING_DIMENSION) \
+	((ctest_matrix_view) {(DATA), (NUM_OF_ROWS), (NUM_OF_COLS), (LEADING_DIMENSION), 1})
+#define MATRIX_STRIDED_VIEW(DATA, NUM_OF_ROWS, NUM_OF_COLS, ROW_STRIDE, COL_STRIDE) \
+	((ctest_matrix_view) {(DATA), (NUM_OF_ROWS), (NUM_OF_COLS), (ROW_STRIDE), (COL_STRIDE)})
+#define MATRIX_COLUMN_VIEW(DATA, NUM_OF_ROWS, LEADING_DIMENSION, COL) \
+	((ctest_matrix_view) {(DATA) + (COL), (NUM_OF_ROWS), 1, (LEADING_DIMENSION), 1})
+
 
 
 
@@ -0,0 +1,449 @@
+/**
+ * Title: STREAM ASSERT
+ */
+
+/**
+ * Description: This file contains the streaming assertions: an output produced
+ * in chunks is compared with a reference chunk by chunk, without keeping the
+ * whole output. A session of the calling thread is opened by
+ * ctest_stream_begin() with the source of the reference bytes:
+ *     - stream_source_memory(): a buffer in memory;
+ *     - stream_source_file(): a file, mapped (read-only) by ctest_stream_begin().
+ * The pages already compared are given back to the kernel, so the resident part
+ * of the mapping stays about one chunk;
+ *     - stream_source_generator(): a function that writes the reference bytes of
+ * each chunk in a buffer of the session, which grows to the largest chunk.
+ *     Each ctest_stream_feed() compares its chunk with the reference bytes at the
+ * same offset of the stream (a large chunk is scanned by the threads of
+ * parallel.c) and records the offset of the first mismatch; the chunks after it
+ * are only counted. ctest_stream_end() also checks that the reference has no
+ * more bytes, and reports one result (ctest_stream).
+ */
+
+//Includes:
+#include "assert.h"
+#include "globals.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Definition of types:
+typedef struct {
+	bool is_open;
+	ctest_stream_source source;
+	const unsigned char *reference;  //Reference bytes (STREAM_SOURCE_MEMORY and STREAM_SOURCE_FILE).
+	size_t reference_size;
+	size_t num_of_released_bytes;    //STREAM_SOURCE_FILE: bytes of the mapping given back to the kernel.
+	unsigned char *buffer;           //STREAM_SOURCE_GENERATOR: reference bytes of the chunk.
+	size_t buffer_size;
+	size_t num_of_bytes;             //Bytes fed.
+	size_t mismatch_offset;          //STREAM_NO_MISMATCH if the stream matches so far.
+	unsigned char target_byte;       //Bytes at 'mismatch_offset' (if the reference has it).
+	unsigned char reference_byte;
+	bool reference_is_shorter;       //The mismatch is the end of the reference.
+	bool reference_is_longer;        //Set by ctest_stream_end().
+} stream_session;
+
+typedef struct {
+	const unsigned char *target;
+	const unsigned char *reference;
+} stream_chunks;
+
+//Local variables:
+static _Thread_local stream_session session;
+
+//Local auxiliary functions:
+static void check_stream_is_open(const char function_name[]);
+static size_t get_reference_bytes(const unsigned char **reference, size_t size);
+static bool reference_has_more_bytes();
+static size_t find_first_difference(size_t begin, size_t end, const void *chunks);
+static void release_compared_pages();
+static void close_session();
+
+
+//Function definitions:
+ctest_stream_source stream_source_memory(const void *reference, size_t reference_size)
+/**
+ * Description: This function returns the source of a reference kept in memory.
+ *
+ * Input: (const void *) reference --> The reference bytes. They must exist until
+ *        ctest_stream_end();
+ *        (size_t) reference_size --> The number of reference bytes.
+ *
+ * Output: (ctest_stream_source) --> The source.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return (ctest_stream_source) {.type = STREAM_SOURCE_MEMORY, .reference = reference, .reference_size = reference_size};
+}
+
+
+ctest_stream_source stream_source_file(const char path[])
+/**
+ * Description: This function returns the source of a reference file. The file
+ * is mapped by ctest_stream_begin().
+ *
+ * Input: (const char []) path --> The path of the reference file.
+ *
+ * Output: (ctest_stream_source) --> The source.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return (ctest_stream_source) {.type = STREAM_SOURCE_FILE, .path = path};
+}
+
+
+ctest_stream_source stream_source_generator(size_t (*generate)(void *buffer, size_t size, size_t offset, void *arg), void *arg)
+/**
+ * Description: This function returns the source of a reference generated on
+ * demand.
+ *
+ * Input: (size_t (*)(void *, size_t, size_t, void *)) generate --> Function
+ *        that writes in 'buffer' the 'size' reference bytes from 'offset' and
+ *        returns the number of bytes written (less than 'size' only at the end
+ *        of the reference). The offsets increase from 0;
+ *        (void *) arg --> The argument of 'generate'.
+ *
+ * Output: (ctest_stream_source) --> The source.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return (ctest_stream_source) {.type = STREAM_SOURCE_GENERATOR, .generate = generate, .arg = arg};
+}
+
+
+void ctest_stream_begin(ctest_stream_source source)
+/**
+ * Description: This function opens the streaming session of the calling thread
+ * with the reference 'source' (see the description of this file).
+ *
+ * Input: (ctest_stream_source) source --> The source of the reference.
+ *
+ * Output: (void)
+ *
+ * Error handling: If a session is already open, or the reference file can not
+ * be mapped, this function prints an error message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	struct stat file_stat;
+	void *data;
+	int fd;
+
+	if(session.is_open)
+	{
+		fprintf(stderr, "Error: ctest_stream_begin inside another streaming session.\n");
+		exit(EXIT_FAILURE);
+	}
+	session = (stream_session) {.is_open = true, .source = source, .mismatch_offset = STREAM_NO_MISMATCH};
+
+	if(source.type == STREAM_SOURCE_MEMORY)
+	{
+		session.reference = source.reference;
+		session.reference_size = source.reference_size;
+	}
+	else if(source.type == STREAM_SOURCE_FILE)
+	{
+		fd = open(source.path, O_RDONLY);
+		if(fd < 0 || fstat(fd, &file_stat) != 0)
+		{
+			fprintf(stderr, "Error while opening the reference file '%s' of a stream.\n", source.path);
+			exit(EXIT_FAILURE);
+		}
+		session.reference_size = (size_t) file_stat.st_size;
+		if(session.reference_size > 0)
+		{
+			data = mmap(NULL, session.reference_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(data == MAP_FAILED)
+			{
+				fprintf(stderr, "Error while mapping the reference file '%s' of a stream.\n", source.path);
+				exit(EXIT_FAILURE);
+			}
+			madvise(data, session.reference_size, MADV_SEQUENTIAL);
+			session.reference = data;
+		}
+		close(fd);
+	}
+}
+
+
+void ctest_stream_feed(const void *chunk, size_t chunk_size)
+/**
+ * Description: This function compares the next 'chunk_size' bytes of the stream
+ * with the reference, until the first mismatch. If 'ignore' is true, the chunk
+ * is only counted.
+ *
+ * Input: (const void *) chunk --> The bytes of the chunk;
+ *        (size_t) chunk_size --> The number of bytes of the chunk.
+ *
+ * Output: (void)
+ *
+ * Error handling: If no session is open or the buffer of the generator can not
+ * be allocated, this function prints an error message and exits a failure code.
+ *
+ * Time Complexity: O(chunk_size), divided by the number of threads for a large
+ * chunk.
+ *
+ * Space Complexity: O(chunk_size) for a generator, else O(1).
+ */
+{
+	const unsigned char *reference = NULL;
+	stream_chunks chunks;
+	size_t n, index;
+
+	check_stream_is_open("ctest_stream_feed");
+	if(ignore || session.mismatch_offset != STREAM_NO_MISMATCH || chunk_size == 0)
+	{
+		session.num_of_bytes += chunk_size;
+		return;
+	}
+
+	n = get_reference_bytes(&reference, chunk_size);
+	chunks = (stream_chunks) {chunk, reference};
+	index = n > 0 ? parallel_find_first(0, n, find_first_difference, &chunks) : 0;
+	if(index < n)
+	{
+		session.mismatch_offset = session.num_of_bytes + index;
+		session.target_byte = chunks.target[index];
+		session.reference_byte = reference[index];
+	}
+	else if(n < chunk_size)
+	{
+		session.mismatch_offset = session.num_of_bytes + n;
+		session.target_byte = chunks.target[n];
+		session.reference_is_shorter = true;
+	}
+	session.num_of_bytes += chunk_size;
+	release_compared_pages();
+}
+
+
+size_t ctest_stream_get_mismatch_offset()
+/**
+ * Description: This function returns the offset of the first mismatch of the
+ * streaming session of the calling thread so far.
+ *
+ * Input: (void)
+ *
+ * Output: (size_t) --> The offset of the first mismatch (the end of the
+ * reference if the stream is longer), or STREAM_NO_MISMATCH.
+ *
+ * Error handling: If no session is open, this function prints an error message
+ * and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	check_stream_is_open("ctest_stream_get_mismatch_offset");
+	return session.mismatch_offset;
+}
+
+
+void ctest_stream_end(int line_number, char custom_message[])
+/**
+ * Description: This function closes the streaming session of the calling thread
+ * and reports its result: the stream passes if it is equal to the reference,
+ * with the same length. The details of a fail show the offset of the first
+ * mismatch and the number of bytes fed. If 'ignore' is true, the result is
+ * ignored.
+ *
+ * Input: (int) line_number --> The number of the line of ctest_stream_end;
+ *        (char []) custom_message --> Personalized message that will be printed
+ *        if the test fails.
+ *
+ * Output: (void)
+ *
+ * Error handling: If no session is open, this function prints an error message
+ * and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	int n = 0;
+	assert_result_struct assert_result = {
+		true,                                                 //was_successful
+		line_number,                                          //line_number
+		get_result_details_buffer(),                          //result_details[MAX_CHARS]
+		"ctest_stream",                                       //assert_name
+		"The stream SHOULD BE EQUAL to the reference.",       //std_message
+		custom_message                                        //custom_message
+	};
+
+	check_stream_is_open("ctest_stream_end");
+	if(ignore) goto print;
+
+	if(session.mismatch_offset == STREAM_NO_MISMATCH) session.reference_is_longer = reference_has_more_bytes();
+	assert_result.was_successful = session.mismatch_offset == STREAM_NO_MISMATCH && !session.reference_is_longer;
+
+	if(failure_details_are_needed(&assert_result))
+	{
+		if(session.reference_is_longer && session.source.type == STREAM_SOURCE_GENERATOR)
+			n = snprintf(assert_result.result_details, MAX_CHARS, "> The stream ends at offset %zu, before the generated reference.\n", session.num_of_bytes);
+		else if(session.reference_is_longer)
+			n = snprintf(assert_result.result_details, MAX_CHARS, "> The stream ends at offset %zu, before the reference (%zu bytes).\n", session.num_of_bytes, session.reference_size);
+		else if(session.reference_is_shorter)
+			n = snprintf(assert_result.result_details, MAX_CHARS, "> The reference ends at offset %zu (target byte 0x%02x), before the stream (%zu bytes fed).\n",
+					session.mismatch_offset, session.target_byte, session.num_of_bytes);
+		else
+			n = snprintf(assert_result.result_details, MAX_CHARS, "> First mismatch at offset %zu: target byte 0x%02x != reference byte 0x%02x (%zu bytes fed).\n",
+					session.mismatch_offset, session.target_byte, session.reference_byte, session.num_of_bytes);
+		if(n < 0)
+		{
+			fprintf(stderr, "\nError while generating the result message (at line %d).\n", line_number);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+print:
+	close_session();
+	print_assert_result(&assert_result);
+}
+
+
+void ctest_stream_abort()
+/**
+ * Description: This function closes the session of the calling thread, if it is
+ * open, without reporting it. It is called by record_module_crash(): a contained
+ * crash inside a session skips its ctest_stream_end(), which leaves the reference
+ * file mapped, the buffer of the generator allocated and the next
+ * ctest_stream_begin() failing.
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(session.is_open) close_session();
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void check_stream_is_open(const char function_name[])
+/**
+ * Description: This function exits a failure code if the calling thread has no
+ * open streaming session.
+ */
+{
+	if(session.is_open) return;
+	fprintf(stderr, "Error: %s outside a ctest_stream_begin/ctest_stream_end session.\n", function_name);
+	exit(EXIT_FAILURE);
+}
+
+
+static size_t get_reference_bytes(const unsigned char **reference, size_t size)
+/**
+ * Description: This function points 'reference' to the (at most 'size')
+ * reference bytes at the offset of the stream, and returns their number.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	unsigned char *buffer;
+
+	if(session.source.type != STREAM_SOURCE_GENERATOR)
+	{
+		if(session.num_of_bytes >= session.reference_size) return 0;
+		*reference = session.reference + session.num_of_bytes;
+		return session.reference_size - session.num_of_bytes < size ? session.reference_size - session.num_of_bytes : size;
+	}
+
+	//The buffer grows to the largest chunk:
+	if(session.buffer_size < size)
+	{
+		buffer = realloc(session.buffer, size);
+		if(buffer == NULL)
+		{
+			fprintf(stderr, "Error while allocating the reference buffer of a stream.\n");
+			exit(EXIT_FAILURE);
+		}
+		session.buffer = buffer;
+		session.buffer_size = size;
+	}
+	*reference = session.buffer;
+	size = session.source.generate(session.buffer, size, session.num_of_bytes, session.source.arg);
+	return size < session.buffer_size ? size : session.buffer_size;
+}
+
+
+static bool reference_has_more_bytes()
+/**
+ * Description: This function says if the reference has bytes after the offset
+ * of the stream (a generator is asked for one more byte).
+ */
+{
+	const unsigned char *reference;
+
+	return get_reference_bytes(&reference, 1) > 0;
+}
+
+
+static size_t find_first_difference(size_t begin, size_t end, const void *chunks)
+/**
+ * Description: This function returns the first index of [begin, end) at which
+ * the target and the reference of 'chunks' (stream_chunks) differ, or 'end'.
+ */
+{
+	const stream_chunks *bytes = chunks;
+	size_t i;
+
+	if(memcmp(&bytes->target[begin], &bytes->reference[begin], end - begin) == 0) return end;
+	for(i = begin; bytes->target[i] == bytes->reference[i]; i++);
+	return i;
+}
+
+
+static void release_compared_pages()
+/**
+ * Description: This function gives back to the kernel the pages of the mapped
+ * reference file that were already compared.
+ */
+{
+	size_t page_size = (size_t) sysconf(_SC_PAGESIZE), end;
+
+	if(session.source.type != STREAM_SOURCE_FILE || session.reference == NULL) return;
+	end = session.num_of_bytes < session.reference_size ? session.num_of_bytes : session.reference_size;
+	end -= end % page_size;
+	if(end <= session.num_of_released_bytes) return;
+	madvise((void *) (session.reference + session.num_of_released_bytes), end - session.num_of_released_bytes, MADV_DONTNEED);
+	session.num_of_released_bytes = end;
+}
+
+
+static void close_session()
+/**
+ * Description: This function unmaps the reference file and frees the buffer of
+ * the generator of the session, and closes it.
+ */
+{
+	if(session.source.type == STREAM_SOURCE_FILE && session.reference != NULL) munmap((void *) session.reference, session.reference_size);
+	free(session.buffer);
+	session = (stream_session) {.is_open = false};
+}
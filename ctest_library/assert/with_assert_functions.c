@@ -0,0 +1,971 @@
+/**
+ * Author: Artur Assis Alves
+ * Date: 19/10/2026
+ * Title: WITH assert functions file.
+ */
+
+/**
+ * Description: This file contains the functions used by the WITH_ASSERT_*
+ * macros. Each block is opened by a *_begin function and closed by
+ * with_assert_end(), which evaluates and prints the result of the block.
+ *     The output of stdout/stderr (and of any other stream backed by a file
+ * descriptor) is captured by redirecting its file descriptor with dup2 onto an
+ * anonymous memory file (memfd_create). Streams without a file descriptor are
+ * captured by replacing them with an open_memstream buffer. In both cases the
+ * captured bytes are compared in place, without any temporary file. The open
+ * captures are also kept in a registry outside the stack of the blocks, so a
+ * crash contained by CTEST_MODULE can restore the streams (see
+ * with_assert_abort_captures()).
+ *     The body of the exit status/signal blocks is executed by a child process
+ * created with fork() at the beginning of the block. The child is a copy-on-write
+ * clone of the test at that point (no exec, so the fixture built before the block
+ * is inherited and no process startup cost is paid). Each result of an assertion
+ * made by the child is sent through a pipe and merged into the counters of the
+ * parent.
+ *     The allocation blocks compare the allocation counters of the thread (see
+ * alloc_hooks.c) at the beginning and at the end of the block.
+ */
+
+#define _GNU_SOURCE
+
+//Includes:
+#include "assert.h"
+#include "globals.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include "internal_alloc.h" //Must be the last include.
+
+
+//Constants:
+#define MAX_ERROR_MSG_SZ 128
+#define WINDOW_BEFORE 16 //Number of bytes shown before the first difference.
+#define WINDOW_SIZE 48   //Number of bytes shown in the details of a failure.
+#define MAX_OPEN_CAPTURES 16 //Maximum number of nested capture blocks.
+
+//Definition of types:
+typedef struct {
+    FILE **stream_address;
+    FILE *original_stream;
+    int target_fd;
+    int saved_fd;
+    int capture_fd;
+    char *memstream_buffer;  //Updated by the memory stream, so it must not be on the stack of the block.
+    size_t memstream_size;
+} open_capture;
+
+//Local variables:
+static open_capture open_captures[MAX_OPEN_CAPTURES]; //Captures not finished yet, the innermost last.
+static int num_of_open_captures = 0;
+
+//Local auxiliary functions:
+static bool begin_capture(with_assert_struct *with_assert, with_assert_type type, FILE **stream_address, char expected_content[], int line_number, char custom_message[]);
+static void finish_capture(with_assert_struct *with_assert, const char **captured_content, size_t *captured_size);
+static void release_capture(with_assert_struct *with_assert, const char *captured_content, size_t captured_size);
+static void evaluate_capture(with_assert_struct *with_assert, const char captured_content[], size_t captured_size);
+static char *bytes_window_to_one_line_str(const char bytes[], size_t size, size_t init, size_t window_size);
+static char *bytes_window_comparison_to_str(const char target[], size_t target_size, const char reference[], size_t reference_size, size_t init, size_t window_size, char equality_char, char difference_char);
+static bool begin_child(with_assert_struct *with_assert, with_assert_type type, int reference_value, int line_number, char custom_message[]);
+static void finish_child(with_assert_struct *with_assert, int *child_status);
+static void evaluate_child(with_assert_struct *with_assert, int child_status);
+static bool begin_alloc_count(with_assert_struct *with_assert, with_assert_type type, size_t max_value, int line_number, char custom_message[]);
+static void evaluate_alloc_count(with_assert_struct *with_assert);
+static void capture_error(char msg[], int line_number);
+
+
+
+//Definitions of the functions:
+bool with_assert_stdout_equal_begin(with_assert_struct *with_assert, char expected_content[], int line_number, char custom_message[])
+/**
+ * Description: This function opens a WITH_ASSERT_STDOUT_EQUAL block. Every byte
+ * written to stdout (using the FILE 'stdout' or the file descriptor 1) until
+ * with_assert_end() is called is captured in memory.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *        (char []) expected_content --> The content that stdout must receive.
+ *        (int) line_number --> The number of the line on which the block was written.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (bool) --> true. The body of the block must always be executed.
+ */
+{
+    return begin_capture(with_assert, WITH_STDOUT_EQUAL, &stdout, expected_content, line_number, custom_message);
+}
+
+
+bool with_assert_stderr_equal_begin(with_assert_struct *with_assert, char expected_content[], int line_number, char custom_message[])
+/**
+ * Description: This function opens a WITH_ASSERT_STDERR_EQUAL block. Every byte
+ * written to stderr (using the FILE 'stderr' or the file descriptor 2) until
+ * with_assert_end() is called is captured in memory.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *        (char []) expected_content --> The content that stderr must receive.
+ *        (int) line_number --> The number of the line on which the block was written.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (bool) --> true. The body of the block must always be executed.
+ */
+{
+    return begin_capture(with_assert, WITH_STDERR_EQUAL, &stderr, expected_content, line_number, custom_message);
+}
+
+
+bool with_assert_stream_out_equal_begin(with_assert_struct *with_assert, FILE **stream_address, char expected_content[], int line_number, char custom_message[])
+/**
+ * Description: This function opens a WITH_ASSERT_STREAM_OUT_EQUAL block. If
+ * the stream has a file descriptor, the descriptor is redirected to memory,
+ * capturing writes made through the FILE and through the descriptor. Otherwise,
+ * the variable at 'stream_address' is replaced by an open_memstream stream until
+ * the end of the block.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *        (FILE **) stream_address --> Address of the variable that holds the stream.
+ *        (char []) expected_content --> The content that the stream must receive.
+ *        (int) line_number --> The number of the line on which the block was written.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (bool) --> true. The body of the block must always be executed.
+ */
+{
+    return begin_capture(with_assert, WITH_STREAM_OUT_EQUAL, stream_address, expected_content, line_number, custom_message);
+}
+
+
+bool with_assert_exit_status_equal_begin(with_assert_struct *with_assert, int expected_status, int line_number, char custom_message[])
+/**
+ * Description: This function opens a WITH_ASSERT_EXIT_STATUS_EQUAL block. A
+ * child process is forked: the body of the block is executed only by the child
+ * and the parent waits for it in with_assert_end(). If the child reaches the end
+ * of the block, it exits with EXIT_SUCCESS.
+ *     If 'ignore' is true, no child is created and the body is not executed.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *        (int) expected_status --> The status that the block must exit with.
+ *        (int) line_number --> The number of the line on which the block was written.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (bool) --> true in the child (the body must be executed) and false in
+ *         the parent.
+ */
+{
+    return begin_child(with_assert, WITH_EXIT_STATUS_EQUAL, expected_status, line_number, custom_message);
+}
+
+
+bool with_assert_exit_status_notEqual_begin(with_assert_struct *with_assert, int unexpected_status, int line_number, char custom_message[])
+/**
+ * Description: This function opens a WITH_ASSERT_EXIT_STATUS_NOT_EQUAL block. It
+ * works like with_assert_exit_status_equal_begin(). A child killed by a signal
+ * did not exit with any status, so that case fails too.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *        (int) unexpected_status --> The status that the block must not exit with.
+ *        (int) line_number --> The number of the line on which the block was written.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (bool) --> true in the child (the body must be executed) and false in
+ *         the parent.
+ */
+{
+    return begin_child(with_assert, WITH_EXIT_STATUS_NOT_EQUAL, unexpected_status, line_number, custom_message);
+}
+
+
+bool with_assert_signal_equal_begin(with_assert_struct *with_assert, int expected_signal, int line_number, char custom_message[])
+/**
+ * Description: This function opens a WITH_ASSERT_SIGNAL_EQUAL block (death 
+ * test). It works like with_assert_exit_status_equal_begin(), but the child must
+ * be terminated by the signal 'expected_signal'. Core dumps are disabled in the
+ * child.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *        (int) expected_signal --> The signal that must terminate the block (e.g. SIGSEGV).
+ *        (int) line_number --> The number of the line on which the block was written.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (bool) --> true in the child (the body must be executed) and false in
+ *         the parent.
+ */
+{
+    return begin_child(with_assert, WITH_SIGNAL_EQUAL, expected_signal, line_number, custom_message);
+}
+
+
+bool with_assert_max_allocations_begin(with_assert_struct *with_assert, size_t max_allocations, int line_number, char custom_message[])
+/**
+ * Description: This function opens a WITH_ASSERT_MAX_ALLOCATIONS block.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *        (size_t) max_allocations --> The maximum number of allocations of the block.
+ *        (int) line_number --> The number of the line on which the block was written.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (bool) --> true. The body of the block must always be executed.
+ */
+{
+    return begin_alloc_count(with_assert, WITH_MAX_ALLOCATIONS, max_allocations, line_number, custom_message);
+}
+
+
+bool with_assert_max_bytesAllocated_begin(with_assert_struct *with_assert, size_t max_bytes, int line_number, char custom_message[])
+/**
+ * Description: This function opens a WITH_ASSERT_MAX_BYTES_ALLOCATED block.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *        (size_t) max_bytes --> The maximum number of bytes allocated by the block.
+ *        (int) line_number --> The number of the line on which the block was written.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (bool) --> true. The body of the block must always be executed.
+ */
+{
+    return begin_alloc_count(with_assert, WITH_MAX_BYTES_ALLOCATED, max_bytes, line_number, custom_message);
+}
+
+
+void with_assert_end(with_assert_struct *with_assert)
+/**
+ * Description: This function closes a WITH_ASSERT_* block: the original stream
+ * is restored and the result of the block is printed. Calling it for a block
+ * that is already closed does nothing.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(captured_size)
+ *
+ * Space Complexity: O(1) --> The captured bytes are mapped, not copied.
+ */
+{
+    const char *captured_content;
+    size_t captured_size;
+    int child_status;
+
+    if(!with_assert->is_open) return;
+    with_assert->is_open = false;
+
+    //Blocks that count allocations:
+    if(with_assert->type == WITH_MAX_ALLOCATIONS || with_assert->type == WITH_MAX_BYTES_ALLOCATED)
+    {
+        evaluate_alloc_count(with_assert);
+        return;
+    }
+
+    //Blocks executed by a child process:
+    if(with_assert->type == WITH_EXIT_STATUS_EQUAL || with_assert->type == WITH_EXIT_STATUS_NOT_EQUAL || with_assert->type == WITH_SIGNAL_EQUAL)
+    {
+        finish_child(with_assert, &child_status);
+        evaluate_child(with_assert, child_status);
+        return;
+    }
+
+    finish_capture(with_assert, &captured_content, &captured_size);
+    evaluate_capture(with_assert, captured_content, captured_size);
+    release_capture(with_assert, captured_content, captured_size);
+}
+
+
+void with_assert_cleanup(with_assert_struct *with_assert)
+/**
+ * Description: This function is called automatically when the scope of a
+ * WITH_ASSERT_* block is left. If the block was left early (return, goto), it
+ * is closed here, so the original stream is always restored.
+ *
+ * Input: (with_assert_struct *) with_assert --> The state of the block.
+ *
+ * Output: (void)
+ */
+{
+    with_assert_end(with_assert);
+}
+
+
+void with_assert_abort_captures()
+/**
+ * Description: This function restores the streams of the capture blocks that
+ * are still open, the innermost first, and discards their captured bytes. It is
+ * called by record_module_crash(): the siglongjmp of a contained crash skips
+ * with_assert_end() and the cleanup of the blocks.
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(number of open captures)
+ *
+ * Space Complexity: O(1)
+ */
+{
+    open_capture *capture;
+
+    while(num_of_open_captures > 0)
+    {
+        capture = &open_captures[--num_of_open_captures];
+        if(capture->target_fd >= 0)
+        {
+            fflush(*capture->stream_address);
+            dup2(capture->saved_fd, capture->target_fd);
+            close(capture->saved_fd);
+            close(capture->capture_fd);
+        }
+        else
+        {
+            fclose(*capture->stream_address);
+            *capture->stream_address = capture->original_stream;
+            free(capture->memstream_buffer);
+        }
+    }
+}
+
+
+
+//------------------------------------------------------------------------------
+//Definitions for the local auxiliary functions:
+static bool begin_capture(with_assert_struct *with_assert, with_assert_type type, FILE **stream_address, char expected_content[], int line_number, char custom_message[])
+/**
+ * Description: This function initializes 'with_assert' and starts capturing
+ * the stream at 'stream_address'. If 'ignore' is true, nothing is captured.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+    open_capture *capture;
+
+    with_assert->type             = type;
+    with_assert->is_open          = true;
+    with_assert->is_capturing     = false;
+    with_assert->line_number      = line_number;
+    with_assert->custom_message   = custom_message;
+    with_assert->expected_content = expected_content;
+    with_assert->stream_address   = stream_address;
+    with_assert->original_stream  = NULL;
+    with_assert->target_fd        = -1;
+    with_assert->saved_fd         = -1;
+    with_assert->capture_fd       = -1;
+    with_assert->memstream_buffer = NULL;
+    with_assert->memstream_size   = 0;
+
+    //Check for ignore:
+    if(ignore) return true;
+
+    //Everything written before the block must go to the original destination:
+    if(fflush(*stream_address) == EOF) capture_error("Error while flushing the stream before the capture.", line_number);
+    if(num_of_open_captures == MAX_OPEN_CAPTURES) capture_error("Too many nested capture blocks.", line_number);
+    capture = &open_captures[num_of_open_captures];
+
+    with_assert->target_fd = fileno(*stream_address);
+    if(with_assert->target_fd >= 0)
+    {
+        //Redirect the file descriptor onto an anonymous memory file:
+        with_assert->capture_fd = memfd_create("ctest_capture", MFD_CLOEXEC);
+        if(with_assert->capture_fd < 0) capture_error("Error while creating the memory file for the capture.", line_number);
+
+        with_assert->saved_fd = fcntl(with_assert->target_fd, F_DUPFD_CLOEXEC, 0);
+        if(with_assert->saved_fd < 0) capture_error("Error while saving the original file descriptor.", line_number);
+
+        if(dup2(with_assert->capture_fd, with_assert->target_fd) < 0) capture_error("Error while redirecting the file descriptor.", line_number);
+    }
+    else
+    {
+        //The stream has no file descriptor, replace it with a memory stream:
+        with_assert->original_stream = *stream_address;
+        *stream_address = open_memstream(&capture->memstream_buffer, &capture->memstream_size);
+        if(*stream_address == NULL)
+        {
+            *stream_address = with_assert->original_stream;
+            capture_error("Error while opening the memory stream for the capture.", line_number);
+        }
+    }
+    with_assert->is_capturing = true;
+
+    //Register the capture:
+    capture->stream_address  = stream_address;
+    capture->original_stream = with_assert->original_stream;
+    capture->target_fd       = with_assert->target_fd;
+    capture->saved_fd        = with_assert->saved_fd;
+    capture->capture_fd      = with_assert->capture_fd;
+    num_of_open_captures++;
+
+    return true;
+}
+
+
+static void finish_capture(with_assert_struct *with_assert, const char **captured_content, size_t *captured_size)
+/**
+ * Description: This function stops the capture, restores the original stream
+ * and returns the captured bytes without copying them. The bytes of a memfd
+ * capture are mapped into memory (read only).
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+    struct stat capture_stat;
+    void *mapped_content;
+    open_capture *capture;
+
+    *captured_content = "";
+    *captured_size = 0;
+    if(!with_assert->is_capturing) return;
+    with_assert->is_capturing = false;
+    capture = &open_captures[--num_of_open_captures]; //The blocks are nested.
+
+    if(with_assert->target_fd >= 0)
+    {
+        //Flush what is still buffered in the FILE and restore the descriptor:
+        fflush(*with_assert->stream_address);
+        if(dup2(with_assert->saved_fd, with_assert->target_fd) < 0) capture_error("Error while restoring the file descriptor.", with_assert->line_number);
+        close(with_assert->saved_fd);
+        with_assert->saved_fd = -1;
+
+        if(fstat(with_assert->capture_fd, &capture_stat) < 0) capture_error("Error while reading the size of the capture.", with_assert->line_number);
+        if(capture_stat.st_size > 0)
+        {
+            mapped_content = mmap(NULL, capture_stat.st_size, PROT_READ, MAP_PRIVATE, with_assert->capture_fd, 0);
+            if(mapped_content == MAP_FAILED) capture_error("Error while mapping the captured content.", with_assert->line_number);
+            *captured_content = mapped_content;
+            *captured_size = capture_stat.st_size;
+        }
+    }
+    else
+    {
+        //Closing the memory stream updates its buffer and size:
+        fclose(*with_assert->stream_address);
+        *with_assert->stream_address = with_assert->original_stream;
+        with_assert->memstream_buffer = capture->memstream_buffer;
+        with_assert->memstream_size = capture->memstream_size;
+        if(with_assert->memstream_buffer != NULL)
+        {
+            *captured_content = with_assert->memstream_buffer;
+            *captured_size = with_assert->memstream_size;
+        }
+    }
+}
+
+
+static void release_capture(with_assert_struct *with_assert, const char *captured_content, size_t captured_size)
+/**
+ * Description: This function frees the resources used by the capture.
+ */
+{
+    if(with_assert->capture_fd >= 0)
+    {
+        if(captured_size > 0) munmap((void *)captured_content, captured_size);
+        close(with_assert->capture_fd);
+        with_assert->capture_fd = -1;
+    }
+    free(with_assert->memstream_buffer);
+    with_assert->memstream_buffer = NULL;
+}
+
+
+static void evaluate_capture(with_assert_struct *with_assert, const char captured_content[], size_t captured_size)
+/**
+ * Description: This function compares the captured content with the expected
+ * content and prints the result.
+ *
+ * Time Complexity: O(captured_size)
+ *
+ * Space Complexity: O(1)
+ */
+{
+    //------------------------------------------------------------------------------
+    //Define and initialize the variables:
+    int counter;
+    size_t expected_size, min_size, first_difference, init;
+    char *captured_str, *expected_str, *comparison_str;
+    char *stream_name;
+    assert_result_struct assert_result = {
+                         true,                                                                                 //was_successful
+                         with_assert->line_number,                                                             //line_number
+                         get_result_details_buffer(),                                                          //result_details[MAX_CHARS]
+                         "",                                                                                   //assert_name
+                         "",                                                                                   //std_message
+                         with_assert->custom_message                                                           //custom_message
+                                         };
+
+    switch(with_assert->type)
+    {
+        case WITH_STDOUT_EQUAL:
+            assert_result.assert_name = "WITH_ASSERT_STDOUT_EQUAL";
+            assert_result.std_message = "The content written to stdout inside the block SHOULD BE EQUAL to the expected content.";
+            stream_name = "stdout";
+            break;
+        case WITH_STDERR_EQUAL:
+            assert_result.assert_name = "WITH_ASSERT_STDERR_EQUAL";
+            assert_result.std_message = "The content written to stderr inside the block SHOULD BE EQUAL to the expected content.";
+            stream_name = "stderr";
+            break;
+        default:
+            assert_result.assert_name = "WITH_ASSERT_STREAM_OUT_EQUAL";
+            assert_result.std_message = "The content written to the stream inside the block SHOULD BE EQUAL to the expected content.";
+            stream_name = (with_assert->target_fd >= 0)?"file descriptor":"memory stream";
+            break;
+    }
+
+    //------------------------------------------------------------------------------
+    //Check for ignore:
+    if(ignore)
+        goto print;
+
+    //------------------------------------------------------------------------------
+    //Execute the test:
+    expected_size = strlen(with_assert->expected_content);
+    assert_result.was_successful = (captured_size == expected_size && memcmp(captured_content, with_assert->expected_content, expected_size) == 0);
+
+    //Check if it is necessary to generate highly verbose details in case of fail:
+    if(failure_details_are_needed(&assert_result))
+    {
+        //Find the first byte that differs:
+        min_size = (captured_size < expected_size)?captured_size:expected_size;
+        for(first_difference = 0; first_difference < min_size; first_difference++)
+            if(captured_content[first_difference] != with_assert->expected_content[first_difference]) break;
+        init = (first_difference > WINDOW_BEFORE)?first_difference - WINDOW_BEFORE:0;
+
+        captured_str   = bytes_window_to_one_line_str(captured_content, captured_size, init, WINDOW_SIZE);
+        expected_str   = bytes_window_to_one_line_str(with_assert->expected_content, expected_size, init, WINDOW_SIZE);
+        comparison_str = bytes_window_comparison_to_str(captured_content, captured_size, with_assert->expected_content, expected_size, init, WINDOW_SIZE, '|', '*');
+
+        counter = snprintf(assert_result.result_details,
+                    MAX_CHARS,
+                    "> captured from: %s\n"\
+                    "> first difference at byte %zu (showing bytes from %zu)\n"\
+                    ">\n"\
+                    "> captured (len %5zu): [%s]\n"\
+                    ">                       %s\n"\
+                    "> expected (len %5zu): [%s]\n",
+                    stream_name,
+                    first_difference,
+                    init,
+                    captured_size,
+                    captured_str,
+                    comparison_str,
+                    expected_size,
+                    expected_str
+                    );
+
+        //Free allocated memory:
+        free(captured_str);
+        free(expected_str);
+        free(comparison_str);
+
+        //------------------------------------------------------------------------------
+        //Check for error:
+        if (counter < 0)
+            capture_error("Error while generating the result message.", with_assert->line_number);
+        //------------------------------------------------------------------------------
+    }
+
+    //------------------------------------------------------------------------------
+    //Print the result:
+print:
+    print_assert_result(&assert_result);
+}
+
+
+static char *bytes_window_to_one_line_str(const char bytes[], size_t size, size_t init, size_t window_size)
+/**
+ * Description: This function creates a string with the bytes in the range
+ * [init, init + window_size) of 'bytes', each one with a total width of 2.
+ * Special chars are escaped ('\n' -> "\n") and non printable bytes are shown
+ * as " .".
+ *
+ * Memory issues: After using the returned string, it is necessary to free it.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+    size_t i, end = (init + window_size < size)?init + window_size:size;
+    size_t length = (end > init)?end - init:0;
+    char *resultant_string, escape;
+
+    resultant_string = calloc(2 * length + 1, sizeof *resultant_string);
+    if(resultant_string == NULL) capture_error("Memory allocation was not possible.", __LINE__);
+
+    for(i = 0; i < length; i++)
+    {
+        switch(bytes[init + i])
+        {
+            case '\t': escape = 't'; break;
+            case '\n': escape = 'n'; break;
+            case '\b': escape = 'b'; break;
+            case '\v': escape = 'v'; break;
+            case '\r': escape = 'r'; break;
+            default: escape = '\0'; break;
+        }
+        if(escape != '\0')
+        {
+            resultant_string[2 * i] = '\\';
+            resultant_string[2 * i + 1] = escape;
+        }
+        else
+        {
+            resultant_string[2 * i] = ' ';
+            resultant_string[2 * i + 1] = isprint((unsigned char) bytes[init + i])?bytes[init + i]:'.';
+        }
+    }
+    resultant_string[2 * length] = '\0';
+
+    return resultant_string;
+}
+
+
+static char *bytes_window_comparison_to_str(const char target[], size_t target_size, const char reference[], size_t reference_size, size_t init, size_t window_size, char equality_char, char difference_char)
+/**
+ * Description: This function compares the bytes in the range [init, init +
+ * window_size) of 'target' and 'reference', creating a string with
+ * 'equality_char' for each equal byte and 'difference_char' otherwise. Each
+ * char has a total width of 2, matching bytes_window_to_one_line_str().
+ *
+ * Memory issues: After using the returned string, it is necessary to free it.
+ */
+{
+    size_t i, max_size = (target_size > reference_size)?target_size:reference_size;
+    size_t end = (init + window_size < max_size)?init + window_size:max_size;
+    size_t length = (end > init)?end - init:0;
+    char *comparison_string;
+
+    comparison_string = calloc(2 * length + 1, sizeof *comparison_string);
+    if(comparison_string == NULL) capture_error("Memory allocation was not possible.", __LINE__);
+
+    for(i = 0; i < length; i++)
+    {
+        comparison_string[2 * i] = ' ';
+        if(init + i < target_size && init + i < reference_size && target[init + i] == reference[init + i])
+            comparison_string[2 * i + 1] = equality_char;
+        else
+            comparison_string[2 * i + 1] = difference_char;
+    }
+    comparison_string[2 * length] = '\0';
+
+    return comparison_string;
+}
+
+
+static bool begin_child(with_assert_struct *with_assert, with_assert_type type, int reference_value, int line_number, char custom_message[])
+/**
+ * Description: This function initializes 'with_assert' and forks the child that
+ * executes the body of the block. The child sends its results to the parent 
+ * through a pipe ('result_pipe_fd').
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+    int pipe_fds[2];
+    pid_t pid;
+    struct rlimit core_limit = {0, 0};
+
+    with_assert->type            = type;
+    with_assert->is_open         = true;
+    with_assert->is_capturing    = false;
+    with_assert->line_number     = line_number;
+    with_assert->custom_message  = custom_message;
+    with_assert->reference_value = reference_value;
+    with_assert->is_child        = false;
+    with_assert->child_pid       = -1;
+    with_assert->results_fd      = -1;
+    with_assert->target_fd       = -1;
+    with_assert->saved_fd        = -1;
+    with_assert->capture_fd      = -1;
+
+    //Check for ignore:
+    if(ignore) return false;
+
+    //The buffers must be empty, otherwise they would be written twice:
+    fflush(NULL);
+
+    if(pipe2(pipe_fds, O_CLOEXEC) < 0) capture_error("Error while creating the pipe for the results of the block.", line_number);
+
+    pid = fork();
+    if(pid < 0) capture_error("Error while creating the child process.", line_number);
+
+    if(pid == 0)
+    {
+        //Child: execute the body of the block.
+        close(pipe_fds[0]);
+        with_assert->is_child = true;
+        result_pipe_fd = pipe_fds[1];
+        reset_failure_sites(); //The parent reports its own sites.
+        setrlimit(RLIMIT_CORE, &core_limit);
+        return true;
+    }
+
+    //Parent: skip the body of the block.
+    close(pipe_fds[1]);
+    with_assert->child_pid = pid;
+    with_assert->results_fd = pipe_fds[0];
+    return false;
+}
+
+
+static void finish_child(with_assert_struct *with_assert, int *child_status)
+/**
+ * Description: In the child, this function ends the process with EXIT_SUCCESS
+ * (the body of the block reached its end). In the parent, it merges the results
+ * sent by the child and waits for its termination.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+    char results[MAX_RESULTS];
+    ssize_t n;
+
+    *child_status = 0;
+    if(with_assert->is_child)
+    {
+        report_suppressed_failures();
+        fflush(NULL);
+        exit(EXIT_SUCCESS);
+    }
+    if(with_assert->child_pid < 0) return; //Ignored.
+
+    //Read the results until the child closes the pipe:
+    while((n = read(with_assert->results_fd, results, sizeof results)) != 0)
+    {
+        if(n < 0)
+        {
+            if(errno == EINTR) continue;
+            capture_error("Error while reading the results of the child process.", with_assert->line_number);
+        }
+        merge_assert_results(results, n);
+    }
+    close(with_assert->results_fd);
+    with_assert->results_fd = -1;
+
+    while(waitpid(with_assert->child_pid, child_status, 0) < 0)
+    {
+        if(errno != EINTR) capture_error("Error while waiting for the child process.", with_assert->line_number);
+    }
+    with_assert->child_pid = -1;
+}
+
+
+static void evaluate_child(with_assert_struct *with_assert, int child_status)
+/**
+ * Description: This function checks the termination status of the child and
+ * prints the result.
+ */
+{
+    //------------------------------------------------------------------------------
+    //Define and initialize the variables:
+    int counter;
+    char termination_str[MAX_ERROR_MSG_SZ];
+    char *reference_name;
+    assert_result_struct assert_result = {
+                         true,                                                      //was_successful
+                         with_assert->line_number,                                  //line_number
+                         get_result_details_buffer(),                               //result_details[MAX_CHARS]
+                         "",                                                        //assert_name
+                         "",                                                        //std_message
+                         with_assert->custom_message                                //custom_message
+                                         };
+
+    switch(with_assert->type)
+    {
+        case WITH_EXIT_STATUS_EQUAL:
+            assert_result.assert_name = "WITH_ASSERT_EXIT_STATUS_EQUAL";
+            assert_result.std_message = "The block SHOULD EXIT with a status EQUAL to the expected status.";
+            reference_name = "expected status";
+            break;
+        case WITH_EXIT_STATUS_NOT_EQUAL:
+            assert_result.assert_name = "WITH_ASSERT_EXIT_STATUS_NOT_EQUAL";
+            assert_result.std_message = "The block SHOULD EXIT with a status NOT EQUAL to the unexpected status.";
+            reference_name = "unexpected status";
+            break;
+        default:
+            assert_result.assert_name = "WITH_ASSERT_SIGNAL_EQUAL";
+            assert_result.std_message = "The block SHOULD BE TERMINATED by the expected signal.";
+            reference_name = "expected signal";
+            break;
+    }
+
+    //------------------------------------------------------------------------------
+    //Check for ignore:
+    if(ignore)
+        goto print;
+
+    //------------------------------------------------------------------------------
+    //Execute the test:
+    if(with_assert->type == WITH_SIGNAL_EQUAL)
+        assert_result.was_successful = WIFSIGNALED(child_status) && WTERMSIG(child_status) == with_assert->reference_value;
+    else if(with_assert->type == WITH_EXIT_STATUS_EQUAL)
+        assert_result.was_successful = WIFEXITED(child_status) && WEXITSTATUS(child_status) == with_assert->reference_value;
+    else
+        assert_result.was_successful = WIFEXITED(child_status) && WEXITSTATUS(child_status) != with_assert->reference_value;
+
+    //Check if it is necessary to generate highly verbose details in case of fail:
+    if(failure_details_are_needed(&assert_result))
+    {
+        if(WIFSIGNALED(child_status))
+            snprintf(termination_str, MAX_ERROR_MSG_SZ, "terminated by signal %d (%s)", WTERMSIG(child_status), strsignal(WTERMSIG(child_status)));
+        else
+            snprintf(termination_str, MAX_ERROR_MSG_SZ, "exited with status %d", WEXITSTATUS(child_status));
+
+        if(with_assert->type == WITH_SIGNAL_EQUAL)
+            counter = snprintf(assert_result.result_details,
+                        MAX_CHARS,
+                        "> %-17s: %d (%s)\n"\
+                        "> %-17s: %s\n",
+                        reference_name,
+                        with_assert->reference_value,
+                        strsignal(with_assert->reference_value),
+                        "block",
+                        termination_str
+                        );
+        else
+            counter = snprintf(assert_result.result_details,
+                        MAX_CHARS,
+                        "> %-17s: %d\n"\
+                        "> %-17s: %s\n",
+                        reference_name,
+                        with_assert->reference_value,
+                        "block",
+                        termination_str
+                        );
+
+        //------------------------------------------------------------------------------
+        //Check for error:
+        if (counter < 0)
+            capture_error("Error while generating the result message.", with_assert->line_number);
+        //------------------------------------------------------------------------------
+    }
+
+    //------------------------------------------------------------------------------
+    //Print the result:
+print:
+    print_assert_result(&assert_result);
+}
+
+
+static bool begin_alloc_count(with_assert_struct *with_assert, with_assert_type type, size_t max_value, int line_number, char custom_message[])
+/**
+ * Description: This function initializes 'with_assert' and saves the
+ * allocation counters of the thread.
+ *
+ * Error handling: If the allocation hooks are not active, this function prints
+ * an error message and exits a failure code.
+ */
+{
+    with_assert->type           = type;
+    with_assert->is_open        = true;
+    with_assert->is_capturing   = false;
+    with_assert->line_number    = line_number;
+    with_assert->custom_message = custom_message;
+    with_assert->max_value      = max_value;
+    with_assert->child_pid      = -1;
+    with_assert->results_fd     = -1;
+    with_assert->target_fd      = -1;
+    with_assert->saved_fd       = -1;
+    with_assert->capture_fd     = -1;
+
+    //Check for ignore:
+    if(ignore) return true;
+
+    if(!alloc_hooks_are_active())
+        capture_error("The allocation hooks are not active. Link the test with " CTEST_ALLOC_HOOKS_LINK_FLAGS ".", line_number);
+    with_assert->initial_alloc_counters = get_alloc_counters();
+    return true;
+}
+
+
+static void evaluate_alloc_count(with_assert_struct *with_assert)
+/**
+ * Description: This function compares the allocations made by the thread
+ * during the block with the maximum and prints the result.
+ */
+{
+    //------------------------------------------------------------------------------
+    //Define and initialize the variables:
+    int counter;
+    size_t num_of_allocations, bytes_allocated, num_of_frees, value;
+    alloc_counters_struct final_alloc_counters = get_alloc_counters();
+    assert_result_struct assert_result = {
+                         true,                                                      //was_successful
+                         with_assert->line_number,                                  //line_number
+                         get_result_details_buffer(),                               //result_details[MAX_CHARS]
+                         "",                                                        //assert_name
+                         "",                                                        //std_message
+                         with_assert->custom_message                                //custom_message
+                                         };
+
+    if(with_assert->type == WITH_MAX_ALLOCATIONS)
+    {
+        assert_result.assert_name = "WITH_ASSERT_MAX_ALLOCATIONS";
+        assert_result.std_message = "The block SHOULD ALLOCATE memory at most the maximum number of times.";
+    }
+    else
+    {
+        assert_result.assert_name = "WITH_ASSERT_MAX_BYTES_ALLOCATED";
+        assert_result.std_message = "The block SHOULD ALLOCATE at most the maximum number of bytes.";
+    }
+
+    //------------------------------------------------------------------------------
+    //Check for ignore:
+    if(ignore)
+        goto print;
+
+    //------------------------------------------------------------------------------
+    //Execute the test:
+    num_of_allocations = final_alloc_counters.num_of_allocations - with_assert->initial_alloc_counters.num_of_allocations;
+    bytes_allocated    = final_alloc_counters.bytes_allocated - with_assert->initial_alloc_counters.bytes_allocated;
+    num_of_frees       = final_alloc_counters.num_of_frees - with_assert->initial_alloc_counters.num_of_frees;
+    value = with_assert->type == WITH_MAX_ALLOCATIONS ? num_of_allocations : bytes_allocated;
+    assert_result.was_successful = value <= with_assert->max_value;
+
+    //Check if it is necessary to generate highly verbose details in case of fail:
+    if(failure_details_are_needed(&assert_result))
+    {
+        counter = snprintf(assert_result.result_details,
+                    MAX_CHARS,
+                    "> %-17s: %zu\n"\
+                    "> %-17s: %zu\n"\
+                    "> %-17s: %zu\n"\
+                    "> %-17s: %zu\n",
+                    "maximum",
+                    with_assert->max_value,
+                    "allocations",
+                    num_of_allocations,
+                    "bytes allocated",
+                    bytes_allocated,
+                    "frees",
+                    num_of_frees
+                    );
+
+        //------------------------------------------------------------------------------
+        //Check for error:
+        if (counter < 0)
+            capture_error("Error while generating the result message.", with_assert->line_number);
+        //------------------------------------------------------------------------------
+    }
+
+    //------------------------------------------------------------------------------
+    //Print the result:
+print:
+    print_assert_result(&assert_result);
+}
+
+
+static void capture_error(char msg[], int line_number)
+/**
+ * Description: This function prints the error message 'msg' and exits with a
+ * failure code.
+ */
+{
+    fprintf(stderr, "\nError (WITH_ASSERT block at line %d): %s\n", line_number, msg);
+    exit(EXIT_FAILURE);
+}
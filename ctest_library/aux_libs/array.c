@@ -2,6 +2,7 @@
 #include "array.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include "internal_alloc.h" //Must be the last include.
 
 
 //Definitions of functions:
@@ -5,6 +5,7 @@
 #include "hash_function.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include "internal_alloc.h" //Must be the last include.
 
 
 //Definitions of the functions:
@@ -209,6 +210,7 @@ bool D_delete_element(T_element key, T_dict *target_dict)
 	{
 		if(found_element->item.key.type != NULL_TYPE) T_free_element(&(found_element->item.key));
 		if(found_element->item.value.type != NULL_TYPE) T_free_element(&(found_element->item.value));
+		free(found_element);
 
 		target_dict->num_of_items--;
 		result = true;
@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include "types.h"
 #include "linked_list.h"
+#include "internal_alloc.h" //Must be the last include.
 
 
 //Declaration of local functions:
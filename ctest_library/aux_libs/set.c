@@ -3,6 +3,7 @@
 #include "array.h"
 #include "dict.h"
 #include <stdio.h>
+#include "internal_alloc.h" //Must be the last include.
 
 T_set *S_create_set(T_hash_type table_size)
 /**
@@ -15,6 +15,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include "internal_alloc.h" //Must be the last include.
 
 //Auxilliary functions:
 int is_white_space(char s)
@@ -22,6 +23,19 @@ int is_white_space(char s)
     return (s == ' ' || s == '\t' || s == '\n');
 }
 
+static char *append_str(char *end, char src[])
+/**
+ * Description: This function copies 'src' (with its '\0') to 'end', the end of
+ * a string, and returns the new end of the string. Unlike strcat, it does not
+ * search for the end, so building a string with it is linear.
+ */
+{
+    size_t length = strlen(src);
+
+    memcpy(end, src, length + 1);
+    return end + length;
+}
+
 //Function definitions:
 char *break_line(char text[], size_t max_text_length, char first_prefix[], char prefix[], char suffix[], size_t line_length)
 /**
@@ -56,10 +70,7 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
  *
  * Output: (char *) --> String with each line properly formatted.
  *
- * Time Complexity: O(text_length^2) 
- *     --> Squared complexity is not a problem considering the text_length is not too large.
- *     If it is necessary to makes this function faster, optimize the concatenation of the 
- *     final result.
+ * Time Complexity: O(text_length + num_of_lines * line_length)
  *
  * Space Complexity: O(text_length)
  */
@@ -67,7 +78,7 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
     //Variables:
     word  *my_words;
     size_t current_line_length, word_index, white_spaces_to_add, num_of_words;
-    char *formatted_lines;
+    char *formatted_lines, *end;
 
 
     //Get the words from text:
@@ -91,14 +102,15 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
     }    
     
     //Allocate memory for the result:
-    formatted_lines = calloc(line_length * num_of_words, sizeof *formatted_lines); //Worst case: one word per line
+    formatted_lines = calloc((line_length + 1) * (num_of_words + 1) + 1, sizeof *formatted_lines); //Worst case: empty first line and one word per line (+ '\n' per line and '\0')
+    end = formatted_lines;
     
 
     /*Format the first line*/
     word_index = 0;
     
     //Add the prefix:
-    strcat(formatted_lines, first_prefix);
+    end = append_str(end, first_prefix);
     current_line_length = strlen(first_prefix) + strlen(suffix); //Suffix will be added at the end
     while(current_line_length < line_length)
     {
@@ -109,7 +121,7 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
             
 
             while(white_spaces_to_add-- > 0)
-                strcat(formatted_lines, " ");
+                end = append_str(end, " ");
 
             //Update the current line length:
             current_line_length = line_length;
@@ -117,7 +129,7 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
         }else //It is possible to add a new word
         {
             //Add the new word:
-            strcat(formatted_lines, my_words[word_index].string);
+            end = append_str(end, my_words[word_index].string);
 
             //Update current line length:
             current_line_length += my_words[word_index++].length;
@@ -125,15 +137,15 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
             //Add a whitespace:
             if (current_line_length < line_length) 
             {
-                strcat(formatted_lines, " ");
+                end = append_str(end, " ");
                 current_line_length++;
             }
         }
     }
 
     //Finish the first line:
-    strcat(formatted_lines, suffix);
-    strcat(formatted_lines, "\n");
+    end = append_str(end, suffix);
+    end = append_str(end, "\n");
     
 
     /*Format the remaining lines*/
@@ -141,7 +153,7 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
     while(my_words[word_index].string != NULL)
     {
         //Add the prefix:
-        strcat(formatted_lines, prefix);
+        end = append_str(end, prefix);
         current_line_length = strlen(prefix) + strlen(suffix); //Suffix will be added at the end
 
         //Check if the next word is impossible to add:
@@ -161,7 +173,7 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
                 
 
                 while(white_spaces_to_add-- > 0)
-                    strcat(formatted_lines, " ");
+                    end = append_str(end, " ");
 
                 //Update the current line length:
                 current_line_length = line_length;
@@ -169,7 +181,7 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
             }else //It is possible to add a new word
             {
                 //Add the new word:
-                strcat(formatted_lines, my_words[word_index].string);
+                end = append_str(end, my_words[word_index].string);
 
                 //Update current line length:
                 current_line_length += my_words[word_index++].length;
@@ -177,15 +189,15 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
                 //Add a whitespace:
                 if (current_line_length < line_length) 
                 {
-                    strcat(formatted_lines, " ");
+                    end = append_str(end, " ");
                     current_line_length++;
                 }
             }
         }
 
     //Finish the first line:
-    strcat(formatted_lines, suffix);
-    strcat(formatted_lines, "\n");
+    end = append_str(end, suffix);
+    end = append_str(end, "\n");
 
     }
 
@@ -404,6 +416,7 @@ char *merge_str(char *str_arr[], char sep[], char end[])
  * Description: This function returns all the strings from the array 'str_arr' 
  * merged. They are separated by the string 'sep' and finished by the string 
  * 'end'. 'str_arr' must be NULL terminated, otherwise the behavior is undefined. 
+ * A NULL 'str_arr' is equivalent to an empty array.
  *     The 'sep' and 'end' have default values equal to the empty string when they 
  * are NULL.
  *
@@ -416,29 +429,29 @@ char *merge_str(char *str_arr[], char sep[], char end[])
  *
  * Output: (char *) --> The resultant merged string.
  *
- * Time Complexity: O(total_chars_of(str_arr)^2)
- *     --> This function is not critical to the performance of the program, so it 
- *     will not be optimized.
+ * Time Complexity: O(total_chars_of(str_arr))
  *
  * Space Complexity: O(total_chars_of(str_arr))
  */
 {
     size_t total_chars, i, sep_size;
-    char *merged_str;
+    char *merged_str, *merged_end;
+    static char *empty_str_arr[] = {NULL};
 
     //Check for default values:
     if(sep == NULL) sep = "";
     if(end == NULL) end = "";
+    if(str_arr == NULL) str_arr = empty_str_arr;
     
     
 
     //Count the number of chars of str_arr:
     i           = 0;
-    total_chars = 0;
+    total_chars = strlen(end);
     sep_size = strlen(sep);
     while(str_arr[i] != NULL)
         total_chars += strlen(str_arr[i++]) + sep_size;
-    total_chars += strlen(end) - sep_size;
+    if(i > 0) total_chars -= sep_size;
     //Allocate memory for the result:
     merged_str = calloc(total_chars + 1, sizeof *merged_str);
     if(merged_str == NULL)
@@ -450,13 +463,14 @@ char *merge_str(char *str_arr[], char sep[], char end[])
 
     //Merge:
     i = 0;
+    merged_end = merged_str;
     while(str_arr[i] != NULL)
     {
-        strcat(merged_str, str_arr[i]);
+        merged_end = append_str(merged_end, str_arr[i]);
         if(str_arr[++i] != NULL) //if true, sep is necessary
-            strcat(merged_str, sep);
+            merged_end = append_str(merged_end, sep);
     }
-    strcat(merged_str, end);
+    append_str(merged_end, end);
     
     //Return the result:
     return merged_str;
@@ -568,3 +582,86 @@ return_result:
     return result;
 
 }
+
+
+char *TF_time_to_str(double seconds, char str[], size_t size)
+/**
+ * Description: This function writes the duration 'seconds' in 'str' using the
+ * most readable unit (ns, us, ms or s), with 3 decimal places.
+ *
+ * Input: (double) seconds --> The duration.
+ *        (char []) str --> The buffer that receives the text.
+ *        (size_t) size --> The size of 'str'.
+ *
+ * Output: (char *) --> 'str'.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+    if(seconds < 1e-6)      snprintf(str, size, "%.3f ns", seconds * 1e9);
+    else if(seconds < 1e-3) snprintf(str, size, "%.3f us", seconds * 1e6);
+    else if(seconds < 1)    snprintf(str, size, "%.3f ms", seconds * 1e3);
+    else                    snprintf(str, size, "%.3f s", seconds);
+    return str;
+}
+
+
+char *TF_bytes_to_str(double bytes, char str[], size_t size)
+/**
+ * Description: This function writes the amount 'bytes' in 'str' using the most
+ * readable binary unit (B, KiB, MiB or GiB). Units other than B have 3 decimal
+ * places.
+ *
+ * Input: (double) bytes --> The amount of bytes (it may be negative).
+ *        (char []) str --> The buffer that receives the text.
+ *        (size_t) size --> The size of 'str'.
+ *
+ * Output: (char *) --> 'str'.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+    double magnitude = bytes < 0 ? -bytes : bytes;
+
+    if(magnitude < 1024)                      snprintf(str, size, "%.0f B", bytes);
+    else if(magnitude < 1024.0 * 1024)        snprintf(str, size, "%.3f KiB", bytes / 1024);
+    else if(magnitude < 1024.0 * 1024 * 1024) snprintf(str, size, "%.3f MiB", bytes / (1024.0 * 1024));
+    else                                      snprintf(str, size, "%.3f GiB", bytes / (1024.0 * 1024 * 1024));
+    return str;
+}
+
+
+char *TF_count_to_str(long long count, char str[], size_t size)
+/**
+ * Description: This function writes 'count' in 'str' with a comma between the
+ * groups of 3 digits (e.g. 999,997).
+ *
+ * Input: (long long) count --> The number.
+ *        (char []) str --> The buffer that receives the text.
+ *        (size_t) size --> The size of 'str'.
+ *
+ * Output: (char *) --> 'str'.
+ *
+ * Time Complexity: O(number of digits)
+ *
+ * Space Complexity: O(1)
+ */
+{
+    char digits[32];
+    size_t num_of_digits, i, j = 0;
+    int first;
+
+    first = count < 0 ? 1 : 0;
+    num_of_digits = (size_t) snprintf(digits, sizeof digits, "%lld", count);
+    for(i = 0; i < num_of_digits && j + 1 < size; i++)
+    {
+        if(i > (size_t) first && (num_of_digits - i) % 3 == 0 && j + 2 < size) str[j++] = ',';
+        str[j++] = digits[i];
+    }
+    if(size > 0) str[j] = '\0';
+    return str;
+}
@@ -20,6 +20,9 @@ char *break_line(char text[], size_t max_text_length, char first_prefix[], char
 word *get_words(char text[], size_t max_chars, size_t *num_of_words_read);
 char *merge_str(char *str_arr[], char sep[], char end[]);
 bool TF_generate_array_of_alligned_sizes(size_t ** input_list_of_lists_of_sizes[], size_t **result_list_of_alligned_sizes_address, char **error_msg, size_t min_width);
+char *TF_time_to_str(double seconds, char str[], size_t size);
+char *TF_bytes_to_str(double bytes, char str[], size_t size);
+char *TF_count_to_str(long long count, char str[], size_t size);
 #endif
 
 
@@ -0,0 +1,238 @@
+/**
+ * Title: BENCH
+ */
+
+/**
+ * Description: This file contains the implementation of the micro-benchmark
+ * harness (CTEST_BENCH). A benchmark is a state machine driven by
+ * bench_next_sample(), which is called before each sample of the body:
+ * 	CALIBRATION: the number of iterations per sample is doubled until one
+ * sample takes at least 'bench_config.min_sample_time';
+ * 	WARMUP: samples are executed and discarded until 'bench_config.warmup_time'
+ * has passed. The number of iterations is then recomputed from the fastest
+ * iteration seen, so a preempted calibration sample does not make the samples
+ * too short;
+ * 	MEASUREMENT: 'bench_config.num_of_samples' samples are recorded. If they 
+ * are enabled, the performance counters (see bench_perf.c) run during this phase;
+ * in the noise control mode (see bench_noise.c), a sample with a context switch
+ * is discarded and taken again;
+ * 	FINISHED: the statistics are computed, compared with the baseline (see
+ * bench_baseline.c) and sent to the reporters (see reporter.h).
+ */
+
+//Includes:
+#include "globals.h"
+#include "bench.h"
+#include "ctest_trace.h"
+#include "reporter.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+//Define global variables:
+bench_config_struct bench_config = {.min_sample_time = 5e-4, .warmup_time = 1e-2, .num_of_samples = 100, .max_p_value = 0.01, .max_slowdown = 0.05, .cpu = -1};
+
+//Local variables:
+static ctest_bench_stats last_bench_stats;
+
+//Local auxiliary functions:
+static void compute_bench_stats(bench_struct *bench, ctest_bench_stats *stats);
+
+
+//Function definitions:
+bool bench_next_sample(bench_struct *bench)
+/**
+ * Description: This function ends the current sample of the benchmark (if any)
+ * and prepares the next one (see the description of this file). It must not be
+ * called directly: it is called by CTEST_BENCH.
+ *
+ * Input: (bench_struct *) bench --> The state of the benchmark.
+ *
+ * Output: (bool) --> true if another sample must be executed. In that case, the
+ *         timer of the sample is started just before returning.
+ *
+ * Time Complexity: O(1), except for the last call: O(num_of_samples * log(num_of_samples)).
+ *
+ * Space Complexity: O(1)
+ */
+{
+	double now, elapsed_time;
+	size_t num_of_samples = bench_config.num_of_samples;
+	bench_baseline_result_struct baseline;
+
+	now = bench_get_time();
+	elapsed_time = now - bench->sample_start_time;
+	if(num_of_samples == 0) num_of_samples = 1;
+	if(num_of_samples > MAX_BENCH_SAMPLES) num_of_samples = MAX_BENCH_SAMPLES;
+
+	if(bench->phase != BENCH_MEASUREMENT && bench->iterations > 0 && (bench->min_iteration_time == 0 || elapsed_time / bench->iterations < bench->min_iteration_time))
+		bench->min_iteration_time = elapsed_time / bench->iterations;
+
+	switch(bench->phase)
+	{
+		case BENCH_CALIBRATION:
+			if(bench->iterations == 0) //First call: start the calibration.
+			{
+				bench->iterations = 1;
+				bench->start_time = now;
+				bench_noise_begin();
+				bench->cpu = bench_noise_get_cpu();
+				break;
+			}
+			if(elapsed_time < bench_config.min_sample_time && bench->iterations < ((size_t) -1) / 2)
+			{
+				bench->iterations *= 2;
+				break;
+			}
+			bench->phase = BENCH_WARMUP;
+			bench->warmup_end_time = now + bench_config.warmup_time;
+			//fallthrough
+		case BENCH_WARMUP:
+			if(now < bench->warmup_end_time) break;
+			bench->phase = BENCH_MEASUREMENT;
+			if(bench->min_iteration_time > 0 && bench->min_iteration_time * bench->iterations < bench_config.min_sample_time)
+				bench->iterations = bench_config.min_sample_time / bench->min_iteration_time + 1;
+			bench->has_perf_counters = perf_counters_are_enabled();
+			if(bench->has_perf_counters) perf_group_start(&bench->perf_group);
+			break;
+		case BENCH_MEASUREMENT:
+			if(bench_noise_discard_sample(bench->sample_start_switches, &bench->num_of_discarded, num_of_samples)) break;
+			bench->samples[bench->num_of_samples++] = elapsed_time / bench->iterations;
+			if(bench->num_of_samples < num_of_samples) break;
+			bench->phase = BENCH_FINISHED;
+			perf_group_stop(&bench->perf_group, &bench->perf);
+			bench_noise_end();
+			compute_bench_stats(bench, &last_bench_stats);
+			bench_check_baseline(&last_bench_stats, &baseline);
+			reporters_bench(&last_bench_stats, &baseline);
+			bench_report_baseline(&last_bench_stats, &baseline);
+			trace_complete_event("benchmark", last_bench_stats.name, bench->start_time, bench_get_time());
+			return false;
+		case BENCH_FINISHED:
+			return false;
+	}
+
+	bench->sample_start_switches = bench_noise_get_switches();
+	bench->sample_start_time = bench_get_time();
+	return true;
+}
+
+
+const ctest_bench_stats *get_last_bench_stats()
+/**
+ * Description: This function returns the statistics of the last finished
+ * CTEST_BENCH. They are valid until the next benchmark finishes.
+ *
+ * Input: (void)
+ *
+ * Output: (const ctest_bench_stats *) --> The statistics.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return &last_bench_stats;
+}
+
+
+double bench_get_time()
+/**
+ * Description: This function returns the time of CLOCK_MONOTONIC in seconds.
+ *
+ * Input: (void)
+ *
+ * Output: (double) --> The time.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+
+int bench_compare_doubles(const void *a, const void *b)
+/**
+ * Description: This function compares two doubles for qsort() (ascending order).
+ *
+ * Input: (const void *) a, b --> Addresses of the doubles.
+ *
+ * Output: (int) --> Negative, zero or positive if *a is less than, equal to or
+ *         greater than *b.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	double x = *(const double *) a, y = *(const double *) b;
+
+	return (x > y) - (x < y);
+}
+
+
+double bench_get_sorted_median(const double sorted_values[], size_t num_of_values)
+/**
+ * Description: This function returns the median of an array sorted in ascending
+ * order.
+ *
+ * Input: (const double []) sorted_values --> The sorted array (not empty).
+ *        (size_t) num_of_values --> The size of the array.
+ *
+ * Output: (double) --> The median.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(num_of_values % 2) return sorted_values[num_of_values / 2];
+	return (sorted_values[num_of_values / 2 - 1] + sorted_values[num_of_values / 2]) / 2;
+}
+
+//Definitions of the local auxiliary functions:
+static void compute_bench_stats(bench_struct *bench, ctest_bench_stats *stats)
+/**
+ * Description: This function computes the statistics of the samples of 'bench'.
+ * The p99 is computed with the nearest-rank method.
+ */
+{
+	double deviations[MAX_BENCH_SAMPLES], sum = 0;
+	size_t i, n = bench->num_of_samples;
+
+	memset(stats, 0, sizeof *stats);
+	snprintf(stats->name, MAX_BENCH_NAME, "%s", bench->name ? bench->name : "");
+	stats->line_number = bench->line_number;
+	stats->num_of_samples = n;
+	stats->iterations_per_sample = bench->iterations;
+	stats->items_per_iteration = bench->items_per_iteration;
+	stats->has_perf_counters = bench->has_perf_counters;
+	stats->perf = bench->perf;
+	stats->num_of_discarded = bench->num_of_discarded;
+	stats->cpu = bench->cpu;
+	memcpy(stats->samples, bench->samples, n * sizeof *stats->samples);
+	qsort(stats->samples, n, sizeof *stats->samples, bench_compare_doubles);
+
+	for(i = 0; i < n; i++) sum += stats->samples[i];
+	stats->min    = stats->samples[0];
+	stats->mean   = sum / n;
+	stats->median = bench_get_sorted_median(stats->samples, n);
+	stats->p99    = stats->samples[(99 * n + 99) / 100 - 1]; //ceil(0.99 * n) - 1
+
+	for(i = 0; i < n; i++) deviations[i] = stats->samples[i] > stats->median ? stats->samples[i] - stats->median : stats->median - stats->samples[i];
+	qsort(deviations, n, sizeof *deviations, bench_compare_doubles);
+	stats->mad = bench_get_sorted_median(deviations, n);
+
+	if(stats->median > 0)
+	{
+		stats->bytes_per_second = bench->bytes_per_iteration / stats->median;
+		stats->items_per_second = bench->items_per_iteration / stats->median;
+	}
+}
@@ -0,0 +1,351 @@
+/**
+ * Title: BENCH BASELINE
+ */
+
+/**
+ * Description: This file contains the comparison of the benchmarks with a
+ * baseline stored in a local text file. Each line of the file is an entry:
+ *
+ * 	<fingerprint>\t<suite>/<module>/<benchmark>\t<num_of_samples>\t<samples>\n
+ *
+ * The fingerprint identifies the machine (OS, architecture, CPU model and number
+ * of CPUs), so one file may keep the baselines of many machines. The samples are
+ * the seconds per iteration of each sample, sorted. A new run is compared with
+ * the entry using the one-sided Mann-Whitney U test: it is a regression if the
+ * p-value is less than 'bench_config.max_p_value' and the median grew more than
+ * 'bench_config.max_slowdown'. Each comparison is an assertion of the module.
+ */
+
+//Includes:
+#define _GNU_SOURCE
+#include "globals.h"
+#include "bench.h"
+#include "assert.h"
+#include "ctest_functions.h"
+#include "text_formatting.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Local macros:
+#define MAX_KEY (3 * MAX_NAME + MAX_BENCH_NAME)
+#define FINGERPRINT_SIZE 17
+
+//Local auxiliary functions:
+static char *get_baseline_path();
+static bool is_update_mode();
+static char *get_machine_fingerprint();
+static void get_bench_key(const ctest_bench_stats *stats, char key[]);
+static bool read_entry(char path[], char fingerprint[], char key[], double samples[], size_t *num_of_samples);
+static void write_entry(char path[], char fingerprint[], char key[], const ctest_bench_stats *stats);
+static bool parse_entry_header(char line[], char fingerprint[], char key[], char **samples_str);
+static double mann_whitney_p_value(const double baseline[], size_t n1, const double current[], size_t n2);
+static void baseline_error(char msg[], char path[]);
+
+
+//Function definitions:
+void bench_check_baseline(const ctest_bench_stats *stats, bench_baseline_result_struct *result)
+/**
+ * Description: This function compares 'stats' with its entry in the baseline
+ * file. In update mode, the entry is replaced by 'stats' instead. If no baseline
+ * file was configured, nothing is done.
+ *
+ * Input: (const ctest_bench_stats *) stats --> The statistics of the benchmark.
+ *        (bench_baseline_result_struct *) result --> Receives the comparison.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(size_of_the_baseline_file + num_of_samples)
+ *
+ * Space Complexity: O(MAX_BENCH_SAMPLES)
+ */
+{
+	char *path = get_baseline_path(), key[MAX_KEY];
+	double baseline_samples[MAX_BENCH_SAMPLES];
+	size_t n;
+
+	memset(result, 0, sizeof *result);
+	if(path == NULL || stats->num_of_samples == 0) return;
+	get_bench_key(stats, key);
+
+	if(is_update_mode())
+	{
+		write_entry(path, get_machine_fingerprint(), key, stats);
+		result->was_updated = true;
+		return;
+	}
+
+	if(!read_entry(path, get_machine_fingerprint(), key, baseline_samples, &n) || n == 0) return;
+
+	result->was_found      = true;
+	result->num_of_samples = n;
+	result->median         = bench_get_sorted_median(baseline_samples, n);
+	result->ratio          = result->median > 0 ? stats->median / result->median : 1;
+	result->p_value        = mann_whitney_p_value(baseline_samples, n, stats->samples, stats->num_of_samples);
+	result->is_regression  = result->p_value < bench_config.max_p_value && result->ratio > 1 + bench_config.max_slowdown;
+}
+
+
+void bench_report_baseline(const ctest_bench_stats *stats, const bench_baseline_result_struct *result)
+/**
+ * Description: This function prints the comparison with the baseline as an
+ * assertion of the current module. A regression is a fail. Benchmarks without a
+ * baseline entry are not reported.
+ *
+ * Input: (const ctest_bench_stats *) stats --> The statistics of the benchmark.
+ *        (const bench_baseline_result_struct *) result --> The comparison.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	char baseline_str[32], current_str[32];
+	assert_result_struct assert_result = {
+		true,                                                       //was_successful
+		stats->line_number,                                         //line_number
+		get_result_details_buffer(),                                //result_details[MAX_CHARS]
+		"CTEST_BENCH (baseline)",                                   //assert_name
+		"The benchmark SHOULD NOT BE SLOWER than its baseline.",    //std_message
+		(char *) stats->name                                        //custom_message
+	};
+
+	if(!result->was_found) return;
+	if(ignore) goto print;
+
+	assert_result.was_successful = !result->is_regression;
+	if(failure_details_are_needed(&assert_result))
+	{
+		snprintf(assert_result.result_details, MAX_CHARS,
+				"> baseline median : %s (%zu samples)\n"\
+				"> current median  : %s (%zu samples)\n"\
+				"> ratio           : %.3f (max: %.3f)\n"\
+				"> p-value         : %.3g (max: %.3g)\n",
+				TF_time_to_str(result->median, baseline_str, sizeof baseline_str), result->num_of_samples,
+				TF_time_to_str(stats->median, current_str, sizeof current_str), stats->num_of_samples,
+				result->ratio, 1 + bench_config.max_slowdown,
+				result->p_value, bench_config.max_p_value);
+	}
+
+print:
+	print_assert_result(&assert_result);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static char *get_baseline_path()
+{
+	if(bench_config.baseline_path != NULL) return bench_config.baseline_path;
+	return getenv("CTEST_BENCH_BASELINE");
+}
+
+
+static bool is_update_mode()
+{
+	char *value = getenv("CTEST_BENCH_UPDATE_BASELINE");
+
+	return bench_config.update_baseline || (value != NULL && strcmp(value, "1") == 0);
+}
+
+
+static char *get_machine_fingerprint()
+/**
+ * Description: This function returns the fingerprint of the machine: the 64-bit
+ * FNV-1a hash (in hexadecimal) of the OS, architecture, CPU model and number of
+ * online CPUs. It is computed only once.
+ */
+{
+	static char fingerprint[FINGERPRINT_SIZE] = "";
+	char description[1024], line[512], cpu_model[512] = "";
+	struct utsname machine;
+	uint64_t hash = 14695981039346656037ULL;
+	FILE *cpuinfo;
+	size_t i;
+
+	if(fingerprint[0] != '\0') return fingerprint;
+
+	if(uname(&machine) < 0)
+	{
+		strcpy(machine.sysname, "unknown");
+		strcpy(machine.machine, "unknown");
+	}
+	cpuinfo = fopen("/proc/cpuinfo", "r");
+	if(cpuinfo != NULL)
+	{
+		while(fgets(line, sizeof line, cpuinfo) != NULL)
+		{
+			if(strncmp(line, "model name", 10) == 0)
+			{
+				snprintf(cpu_model, sizeof cpu_model, "%s", line);
+				break;
+			}
+		}
+		fclose(cpuinfo);
+	}
+	snprintf(description, sizeof description, "%s|%s|%s|%ld", machine.sysname, machine.machine, cpu_model, sysconf(_SC_NPROCESSORS_ONLN));
+
+	for(i = 0; description[i] != '\0'; i++)
+	{
+		hash ^= (unsigned char) description[i];
+		hash *= 1099511628211ULL;
+	}
+	snprintf(fingerprint, FINGERPRINT_SIZE, "%016llx", (unsigned long long) hash);
+	return fingerprint;
+}
+
+
+static void get_bench_key(const ctest_bench_stats *stats, char key[])
+/**
+ * Description: This function writes "<suite>/<module>/<benchmark>" in 'key'.
+ * Tabs and new lines are replaced by spaces, because they separate the fields of
+ * the file.
+ */
+{
+	size_t i;
+
+	snprintf(key, MAX_KEY, "%s/%s/%s", suite_ctest_info.suite_name, suite_ctest_info.module_name, stats->name);
+	for(i = 0; key[i] != '\0'; i++)
+		if(key[i] == '\t' || key[i] == '\n') key[i] = ' ';
+}
+
+
+static bool read_entry(char path[], char fingerprint[], char key[], double samples[], size_t *num_of_samples)
+/**
+ * Description: This function reads the samples of the entry with 'fingerprint'
+ * and 'key'. A missing file is the same as an empty file.
+ *
+ * Output: (bool) --> true if the entry was found.
+ */
+{
+	FILE *file = fopen(path, "r");
+	char *line = NULL, *samples_str, *end;
+	size_t line_size = 0;
+	bool was_found = false;
+	double sample;
+
+	if(file == NULL) return false;
+	while(!was_found && getline(&line, &line_size, file) > 0)
+	{
+		if(!parse_entry_header(line, fingerprint, key, &samples_str)) continue;
+
+		was_found = true;
+		*num_of_samples = 0;
+		while(*num_of_samples < MAX_BENCH_SAMPLES)
+		{
+			sample = strtod(samples_str, &end);
+			if(end == samples_str) break;
+			samples[(*num_of_samples)++] = sample;
+			samples_str = end;
+		}
+	}
+	free(line);
+	fclose(file);
+	return was_found;
+}
+
+
+static void write_entry(char path[], char fingerprint[], char key[], const ctest_bench_stats *stats)
+/**
+ * Description: This function replaces (or adds) the entry with 'fingerprint' and
+ * 'key' by the samples of 'stats'. The file is written to a temporary file that
+ * is renamed, so an interrupted update does not corrupt the baseline.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char tmp_path[4096], *line = NULL, *samples_str;
+	size_t line_size = 0, i;
+	FILE *file, *tmp_file;
+
+	snprintf(tmp_path, sizeof tmp_path, "%s.tmp", path);
+	tmp_file = fopen(tmp_path, "w");
+	if(tmp_file == NULL) baseline_error("Error while creating the baseline file", tmp_path);
+
+	//Copy the other entries:
+	file = fopen(path, "r");
+	if(file != NULL)
+	{
+		while(getline(&line, &line_size, file) > 0)
+			if(!parse_entry_header(line, fingerprint, key, &samples_str)) fputs(line, tmp_file);
+		free(line);
+		fclose(file);
+	}
+
+	//Write the new entry:
+	fprintf(tmp_file, "%s\t%s\t%zu\t", fingerprint, key, stats->num_of_samples);
+	for(i = 0; i < stats->num_of_samples; i++)
+		fprintf(tmp_file, i + 1 < stats->num_of_samples ? "%.6e " : "%.6e\n", stats->samples[i]);
+
+	if(fclose(tmp_file) != 0) baseline_error("Error while writing the baseline file", tmp_path);
+	if(rename(tmp_path, path) < 0) baseline_error("Error while replacing the baseline file", path);
+}
+
+
+static bool parse_entry_header(char line[], char fingerprint[], char key[], char **samples_str)
+/**
+ * Description: This function checks if 'line' is the entry with 'fingerprint'
+ * and 'key'. If it is, '*samples_str' points to the samples of the entry.
+ */
+{
+	size_t fingerprint_length = strlen(fingerprint), key_length = strlen(key);
+	char *num_of_samples_str;
+
+	if(strncmp(line, fingerprint, fingerprint_length) != 0 || line[fingerprint_length] != '\t') return false;
+	line += fingerprint_length + 1;
+	if(strncmp(line, key, key_length) != 0 || line[key_length] != '\t') return false;
+	num_of_samples_str = line + key_length + 1;
+	*samples_str = strchr(num_of_samples_str, '\t');
+	if(*samples_str == NULL) return false;
+	(*samples_str)++;
+	return true;
+}
+
+
+static double mann_whitney_p_value(const double baseline[], size_t n1, const double current[], size_t n2)
+/**
+ * Description: This function returns the one-sided p-value of the Mann-Whitney U
+ * test for the hypothesis "the current samples are greater (slower) than the
+ * baseline samples". Both arrays must be sorted. The normal approximation is
+ * used, with the correction for ties and for continuity.
+ *
+ * Time Complexity: O(n1 + n2)
+ */
+{
+	size_t i = 0, j = 0, rank = 1, count1, count2, tie;
+	double rank_sum2 = 0, tie_sum = 0, u2, mean, sigma, n = n1 + n2, z, value;
+
+	//Merge the sorted arrays, giving the average rank to the ties:
+	while(i < n1 || j < n2)
+	{
+		value = (j >= n2 || (i < n1 && baseline[i] <= current[j])) ? baseline[i] : current[j];
+		for(count1 = 0; i < n1 && baseline[i] == value; i++) count1++;
+		for(count2 = 0; j < n2 && current[j] == value; j++) count2++;
+		tie = count1 + count2;
+		rank_sum2 += count2 * (rank + (tie - 1) / 2.0);
+		tie_sum += (double) tie * tie * tie - tie;
+		rank += tie;
+	}
+
+	u2 = rank_sum2 - n2 * (n2 + 1) / 2.0;
+	mean = n1 * n2 / 2.0;
+	sigma = sqrt(n1 * n2 / 12.0 * ((n + 1) - tie_sum / (n * (n - 1))));
+	if(sigma == 0) return 1;
+	z = (u2 - mean - 0.5) / sigma;
+	return 0.5 * erfc(z / sqrt(2));
+}
+
+
+static void baseline_error(char msg[], char path[])
+{
+	fprintf(stderr, "%s: %s.\n", msg, path);
+	exit(EXIT_FAILURE);
+}
@@ -0,0 +1,231 @@
+/**
+ * Title: BENCH COMPARE
+ */
+
+/**
+ * Description: This file contains the comparative benchmark of two functions
+ * (CTEST_BENCH_COMPARE) and its assertion (ASSERT_FASTER_BY). The number of
+ * iterations per sample is calibrated for each function. Then, the samples are
+ * measured in pairs (one of A and one of B), alternating the order of each pair
+ * (AB, BA, AB, ...). The speedup is the median of the ratios of the pairs and
+ * its confidence interval is given by the order statistics of the ratios (it
+ * does not depend on the distribution of the ratios). In the noise control mode
+ * (see bench_noise.c), a pair with a context switch is discarded and taken again.
+ */
+
+//Includes:
+#include "globals.h"
+#include "bench.h"
+#include "assert.h"
+#include "text_formatting.h"
+#include "ctest_trace.h"
+#include "reporter.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+//Local variables:
+static ctest_bench_comparison last_comparison;
+static bool has_comparison = false;
+
+//Local auxiliary functions:
+static size_t calibrate(void (*fn)(void *), void *input);
+static double run_sample(void (*fn)(void *), void *input, size_t iterations);
+
+
+//Function definitions:
+void bench_compare(char a_name[], void (*a_fn)(void *), char b_name[], void (*b_fn)(void *), void *input, int line_number)
+/**
+ * Description: This function executes the comparative benchmark of 'a_fn' and
+ * 'b_fn' (see CTEST_BENCH_COMPARE) and reports the result. The number of pairs of
+ * samples is 'bench_config.num_of_samples'.
+ *
+ * Input: (char []) a_name, b_name --> The names of the functions.
+ *        (void (*)(void *)) a_fn, b_fn --> The functions.
+ *        (void *) input --> The input of both functions.
+ *        (int) line_number --> The number of the line of CTEST_BENCH_COMPARE.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(num_of_samples * log(num_of_samples)), plus the samples.
+ *
+ * Space Complexity: O(MAX_BENCH_SAMPLES)
+ */
+{
+	double a_samples[MAX_BENCH_SAMPLES], b_samples[MAX_BENCH_SAMPLES], ratios[MAX_BENCH_SAMPLES];
+	double start_time = bench_get_time(), warmup_end_time, z = 1.96; //95% confidence.
+	size_t n = bench_config.num_of_samples, i, low, high;
+	uint64_t start_switches;
+	char name[MAX_TRACE_NAME];
+	ctest_bench_comparison *comparison = &last_comparison;
+
+	if(n == 0) n = 1;
+	if(n > MAX_BENCH_SAMPLES) n = MAX_BENCH_SAMPLES;
+
+	memset(comparison, 0, sizeof *comparison);
+	snprintf(comparison->a_name, MAX_BENCH_NAME, "%s", a_name);
+	snprintf(comparison->b_name, MAX_BENCH_NAME, "%s", b_name);
+	comparison->line_number    = line_number;
+	comparison->num_of_samples = n;
+	bench_noise_begin();
+	comparison->cpu            = bench_noise_get_cpu();
+	comparison->a_iterations   = calibrate(a_fn, input);
+	comparison->b_iterations   = calibrate(b_fn, input);
+
+	//Warmup:
+	warmup_end_time = bench_get_time() + bench_config.warmup_time;
+	while(bench_get_time() < warmup_end_time)
+	{
+		run_sample(a_fn, input, comparison->a_iterations);
+		run_sample(b_fn, input, comparison->b_iterations);
+	}
+
+	//Interleaved samples:
+	for(i = 0; i < n;)
+	{
+		start_switches = bench_noise_get_switches();
+		if(i % 2 == 0)
+		{
+			a_samples[i] = run_sample(a_fn, input, comparison->a_iterations);
+			b_samples[i] = run_sample(b_fn, input, comparison->b_iterations);
+		}
+		else
+		{
+			b_samples[i] = run_sample(b_fn, input, comparison->b_iterations);
+			a_samples[i] = run_sample(a_fn, input, comparison->a_iterations);
+		}
+		if(bench_noise_discard_sample(start_switches, &comparison->num_of_discarded, n)) continue;
+		ratios[i] = b_samples[i] > 0 ? a_samples[i] / b_samples[i] : 1;
+		i++;
+	}
+	bench_noise_end();
+
+	//Statistics:
+	qsort(a_samples, n, sizeof *a_samples, bench_compare_doubles);
+	qsort(b_samples, n, sizeof *b_samples, bench_compare_doubles);
+	qsort(ratios, n, sizeof *ratios, bench_compare_doubles);
+	comparison->a_median = bench_get_sorted_median(a_samples, n);
+	comparison->b_median = bench_get_sorted_median(b_samples, n);
+	comparison->speedup  = bench_get_sorted_median(ratios, n);
+
+	//Ranks (1-based) of the confidence interval of the median: floor(n/2 - z*sqrt(n)/2)
+	//and ceil(n/2 + z*sqrt(n)/2) + 1 (normal approximation of the binomial):
+	low  = (n - z * sqrt(n)) / 2 >= 1 ? (size_t) floor((n - z * sqrt(n)) / 2) - 1 : 0;
+	high = (size_t) ceil((n + z * sqrt(n)) / 2);
+	if(high > n - 1) high = n - 1;
+	comparison->speedup_low  = ratios[low];
+	comparison->speedup_high = ratios[high];
+
+	has_comparison = true;
+	reporters_bench_comparison(comparison);
+	//Each name is truncated, so both fit in the name of the event:
+	snprintf(name, sizeof name, "%.*s vs %.*s", (MAX_TRACE_NAME - 5) / 2, comparison->a_name, (MAX_TRACE_NAME - 5) / 2, comparison->b_name);
+	trace_complete_event("benchmark", name, start_time, bench_get_time());
+}
+
+
+const ctest_bench_comparison *get_last_bench_comparison()
+/**
+ * Description: This function returns the result of the last CTEST_BENCH_COMPARE.
+ *
+ * Input: (void)
+ *
+ * Output: (const ctest_bench_comparison *) --> The result, or NULL if there was
+ *         no comparison.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return has_comparison ? &last_comparison : NULL;
+}
+
+
+void assert_bench_fasterBy(double min_ratio, int line_number, char custom_message[])
+/**
+ * Description: This function checks if, in the last CTEST_BENCH_COMPARE, B was
+ * faster than A by at least 'min_ratio': the lower bound of the confidence
+ * interval of the speedup must be greater or equal to 'min_ratio'.
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (double) min_ratio --> The minimum speedup of B over A (e.g. 1.2).
+ *        (int) line_number --> The number of the line on which this function was written in the
+ *        source code.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (void)
+ *
+ * Error handling: If there is no comparison, this function prints an error
+ * message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	assert_result_struct assert_result = {
+		true,                                                            //was_successful
+		line_number,                                                     //line_number
+		get_result_details_buffer(),                                     //result_details[MAX_CHARS]
+		"ASSERT_FASTER_BY",                                              //assert_name
+		"B SHOULD BE FASTER than A by at least the minimum ratio.",      //std_message
+		custom_message                                                   //custom_message
+	};
+	char a_str[32], b_str[32];
+
+	if(ignore) goto print;
+	if(!has_comparison)
+	{
+		fprintf(stderr, "Error: ASSERT_FASTER_BY without CTEST_BENCH_COMPARE (at line %d).\n", line_number);
+		exit(EXIT_FAILURE);
+	}
+
+	assert_result.was_successful = last_comparison.speedup_low >= min_ratio;
+	if(failure_details_are_needed(&assert_result))
+	{
+		snprintf(assert_result.result_details, MAX_CHARS,
+				"> A (%s) : %s per call\n"\
+				"> B (%s) : %s per call\n"\
+				"> speedup (A/B)  : %.3f [%.3f, %.3f] (95%% CI)\n"\
+				"> minimum        : %.3f\n",
+				last_comparison.a_name, TF_time_to_str(last_comparison.a_median, a_str, sizeof a_str),
+				last_comparison.b_name, TF_time_to_str(last_comparison.b_median, b_str, sizeof b_str),
+				last_comparison.speedup, last_comparison.speedup_low, last_comparison.speedup_high,
+				min_ratio);
+	}
+
+print:
+	print_assert_result(&assert_result);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static size_t calibrate(void (*fn)(void *), void *input)
+/**
+ * Description: This function returns the number of iterations that makes one
+ * sample of 'fn' take at least 'bench_config.min_sample_time'.
+ */
+{
+	size_t iterations = 1;
+
+	while(run_sample(fn, input, iterations) * iterations < bench_config.min_sample_time && iterations < ((size_t) -1) / 2)
+		iterations *= 2;
+	return iterations;
+}
+
+
+static double run_sample(void (*fn)(void *), void *input, size_t iterations)
+/**
+ * Description: This function calls 'fn' 'iterations' times and returns the time
+ * per call in seconds.
+ */
+{
+	double start_time = bench_get_time();
+	size_t i;
+
+	for(i = 0; i < iterations; i++) fn(input);
+	return (bench_get_time() - start_time) / iterations;
+}
@@ -0,0 +1,273 @@
+/**
+ * Title: BENCH COMPLEXITY
+ */
+
+/**
+ * Description: This file contains the empirical complexity assertion
+ * (ASSERT_COMPLEXITY). The callback is timed over a geometric series of input
+ * sizes (min_n, 2*min_n, 4*min_n, ..., up to max_n). For each size, the number of
+ * calls per sample is calibrated like in CTEST_BENCH and the time per call is the
+ * median of COMPLEXITY_SAMPLES samples. The times are then fitted to the models
+ * t(n) = c * f(n), with f(n) in {1, log n, n, n log n, n^2, n^3}. The fit is
+ * made in log space, so every size has the same weight no matter how fast it
+ * is, and with medians, so one disturbed size does not change it. The best fit
+ * is the model with the smallest error; a simpler model within
+ * COMPLEXITY_TOLERANCE of it is preferred, so the noise does not promote a fit
+ * to a more expensive model. In the noise control mode (see bench_noise.c), a
+ * sample with a context switch is discarded and taken again.
+ */
+
+//Includes:
+#include "globals.h"
+#include "bench.h"
+#include "assert.h"
+#include "text_formatting.h"
+#include "ctest_trace.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+//Local macros:
+#define COMPLEXITY_SAMPLES 11     //Samples per size (odd, so the median is a sample).
+#define COMPLEXITY_TOLERANCE 1.1  //A simpler model is preferred if its error is at most 10% greater.
+
+//Local variables:
+static ctest_complexity_fit last_fit;
+static bool has_fit = false;
+static char *complexity_names[] = {"O(1)", "O(log n)", "O(n)", "O(n log n)", "O(n^2)", "O(n^3)"};
+
+//Local auxiliary functions:
+static double time_size(void (*fn)(void *, size_t), void *input, size_t n, size_t *num_of_discarded);
+static double run_sample(void (*fn)(void *, size_t), void *input, size_t n, size_t iterations);
+static double model(complexity_class complexity, size_t n);
+static void fit_models(ctest_complexity_fit *fit);
+
+
+//Function definitions:
+void assert_complexity(void (*fn)(void *, size_t), void *input, size_t min_n, size_t max_n, complexity_class bound, int line_number, char custom_message[])
+/**
+ * Description: This function checks if the running time of 'fn' grows at most
+ * like 'bound' (see the description of this file). The callback receives 'input'
+ * and the size 'n' of the problem. The work done by the callback for a given 'n'
+ * must not change between calls: inputs must be prepared in advance (for
+ * example, in 'input') or be cheap to build compared to the operation.
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (void (*)(void *, size_t)) fn --> The function whose complexity is checked.
+ *        (void *) input --> The input of the function.
+ *        (size_t) min_n, max_n --> The smallest and the largest sizes. 'max_n' must
+ *        be at least 4 * 'min_n' (3 sizes) and 'min_n' at least 1.
+ *        (complexity_class) bound --> The declared bound.
+ *        (int) line_number --> The number of the line on which this function was written in the
+ *        source code.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (void)
+ *
+ * Error handling: If the sizes or the bound are invalid, this function prints an
+ * error message and exits a failure code.
+ *
+ * Time Complexity: O(num_of_sizes), plus the samples.
+ *
+ * Space Complexity: O(MAX_COMPLEXITY_SIZES)
+ */
+{
+	assert_result_struct assert_result = {
+		true,                                                            //was_successful
+		line_number,                                                     //line_number
+		get_result_details_buffer(),                                     //result_details[MAX_CHARS]
+		"ASSERT_COMPLEXITY",                                             //assert_name
+		"The RUNNING TIME SHOULD GROW at most like the declared bound.", //std_message
+		custom_message                                                   //custom_message
+	};
+	ctest_complexity_fit *fit = &last_fit;
+	char time_str[32];
+	double start_time;
+	size_t i, n, length;
+
+	if(ignore) goto print;
+	if(min_n == 0 || max_n / 4 < min_n || bound < COMPLEXITY_O_1 || bound > COMPLEXITY_O_N3)
+	{
+		fprintf(stderr, "Error: invalid arguments of ASSERT_COMPLEXITY (at line %d).\n", line_number);
+		exit(EXIT_FAILURE);
+	}
+
+	//Time each size:
+	start_time = bench_get_time();
+	memset(fit, 0, sizeof *fit);
+	fit->line_number = line_number;
+	bench_noise_begin();
+	for(n = min_n; n <= max_n && fit->num_of_sizes < MAX_COMPLEXITY_SIZES; n = n > ((size_t) -1) / 2 ? max_n + 1 : 2 * n)
+	{
+		fit->sizes[fit->num_of_sizes] = n;
+		fit->times[fit->num_of_sizes++] = time_size(fn, input, n, &fit->num_of_discarded);
+	}
+	bench_noise_end();
+	fit_models(fit);
+	has_fit = true;
+	trace_complete_event("benchmark", "ASSERT_COMPLEXITY", start_time, bench_get_time());
+
+	assert_result.was_successful = fit->best_fit <= bound;
+	if(failure_details_are_needed(&assert_result))
+	{
+		length = snprintf(assert_result.result_details, MAX_CHARS,
+				"> declared bound : %s\n"\
+				"> best fit       : %s\n"\
+				"> model        coefficient    log error\n",
+				complexity_names[bound], complexity_names[fit->best_fit]);
+		for(i = COMPLEXITY_O_1; i <= COMPLEXITY_O_N3 && length < MAX_CHARS; i++)
+			length += snprintf(assert_result.result_details + length, MAX_CHARS - length,
+					"> %-12s %-14.4e %.4f\n", complexity_names[i], fit->coefficients[i], fit->errors[i]);
+		if(length < MAX_CHARS)
+			length += snprintf(assert_result.result_details + length, MAX_CHARS - length, "> %-12s time per call\n", "size");
+		for(i = 0; i < fit->num_of_sizes && length < MAX_CHARS; i++)
+			length += snprintf(assert_result.result_details + length, MAX_CHARS - length,
+					"> %-12zu %s\n", fit->sizes[i], TF_time_to_str(fit->times[i], time_str, sizeof time_str));
+	}
+
+print:
+	print_assert_result(&assert_result);
+}
+
+
+const ctest_complexity_fit *get_last_complexity_fit()
+/**
+ * Description: This function returns the result of the last ASSERT_COMPLEXITY
+ * that was not ignored.
+ *
+ * Input: (void)
+ *
+ * Output: (const ctest_complexity_fit *) --> The result, or NULL if there was
+ *         no fit.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return has_fit ? &last_fit : NULL;
+}
+
+
+char *complexity_to_str(complexity_class complexity)
+/**
+ * Description: This function returns the name of 'complexity' (e.g. "O(n log n)").
+ *
+ * Input: (complexity_class) complexity --> The complexity class.
+ *
+ * Output: (char *) --> The name, or "?" if the class is invalid.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(complexity < COMPLEXITY_O_1 || complexity > COMPLEXITY_O_N3) return "?";
+	return complexity_names[complexity];
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static double time_size(void (*fn)(void *, size_t), void *input, size_t n, size_t *num_of_discarded)
+/**
+ * Description: This function returns the median time per call of 'fn' for the
+ * size 'n'. The number of calls per sample is doubled until one sample takes at
+ * least 'bench_config.min_sample_time' (this also warms the callback up). The
+ * samples discarded by the noise control mode are added to 'num_of_discarded'.
+ */
+{
+	double samples[COMPLEXITY_SAMPLES];
+	size_t iterations = 1, i, size_discarded = 0;
+	uint64_t start_switches;
+
+	while(run_sample(fn, input, n, iterations) * iterations < bench_config.min_sample_time && iterations < ((size_t) -1) / 2)
+		iterations *= 2;
+	for(i = 0; i < COMPLEXITY_SAMPLES;)
+	{
+		start_switches = bench_noise_get_switches();
+		samples[i] = run_sample(fn, input, n, iterations);
+		if(!bench_noise_discard_sample(start_switches, &size_discarded, COMPLEXITY_SAMPLES)) i++;
+	}
+	*num_of_discarded += size_discarded;
+	qsort(samples, COMPLEXITY_SAMPLES, sizeof *samples, bench_compare_doubles);
+	return bench_get_sorted_median(samples, COMPLEXITY_SAMPLES);
+}
+
+
+static double run_sample(void (*fn)(void *, size_t), void *input, size_t n, size_t iterations)
+/**
+ * Description: This function calls 'fn' 'iterations' times and returns the time
+ * per call in seconds.
+ */
+{
+	double start_time = bench_get_time();
+	size_t i;
+
+	for(i = 0; i < iterations; i++) fn(input, n);
+	return (bench_get_time() - start_time) / iterations;
+}
+
+
+static double model(complexity_class complexity, size_t n)
+/**
+ * Description: This function returns f(n) of the model 'complexity'. log2(n) is
+ * at least 1, so f(n) is never 0.
+ */
+{
+	switch(complexity)
+	{
+		case COMPLEXITY_O_1:       return 1;
+		case COMPLEXITY_O_LOG_N:   return n > 2 ? log2((double) n) : 1;
+		case COMPLEXITY_O_N:       return n;
+		case COMPLEXITY_O_N_LOG_N: return n > 2 ? n * log2((double) n) : n;
+		case COMPLEXITY_O_N2:      return (double) n * n;
+		case COMPLEXITY_O_N3:      return (double) n * n * n;
+	}
+	return 0;
+}
+
+
+static void fit_models(ctest_complexity_fit *fit)
+/**
+ * Description: This function fits each model to the times of 'fit' and selects
+ * the best fit. The fit is made in log space: ln(c) is the median of the
+ * residuals r_i = ln(t_i) - ln(f(n_i)) and the error is the median of
+ * |r_i - ln(c)|. Medians make a single disturbed size (e.g. preempted) harmless.
+ * A time of 0 (below the resolution of the clock) is replaced by the smallest
+ * positive time.
+ */
+{
+	double min_time = 0, residuals[MAX_COMPLEXITY_SIZES], log_coefficient;
+	size_t i, n = fit->num_of_sizes;
+	int complexity;
+
+	for(i = 0; i < n; i++)
+		if(fit->times[i] > 0 && (min_time == 0 || fit->times[i] < min_time)) min_time = fit->times[i];
+	if(min_time == 0) min_time = 1e-9;
+
+	for(complexity = COMPLEXITY_O_1; complexity <= COMPLEXITY_O_N3; complexity++)
+	{
+		for(i = 0; i < n; i++)
+			residuals[i] = log(fit->times[i] > 0 ? fit->times[i] : min_time) - log(model(complexity, fit->sizes[i]));
+		qsort(residuals, n, sizeof *residuals, bench_compare_doubles);
+		log_coefficient = bench_get_sorted_median(residuals, n);
+		fit->coefficients[complexity] = exp(log_coefficient);
+
+		for(i = 0; i < n; i++) residuals[i] = fabs(residuals[i] - log_coefficient);
+		qsort(residuals, n, sizeof *residuals, bench_compare_doubles);
+		fit->errors[complexity] = bench_get_sorted_median(residuals, n);
+	}
+
+	//Best fit (the simplest model close to the smallest error):
+	fit->best_fit = COMPLEXITY_O_1;
+	for(complexity = COMPLEXITY_O_1; complexity <= COMPLEXITY_O_N3; complexity++)
+		if(fit->errors[complexity] < fit->errors[fit->best_fit]) fit->best_fit = complexity;
+	for(complexity = COMPLEXITY_O_1; complexity < (int) fit->best_fit; complexity++)
+		if(fit->errors[complexity] <= fit->errors[fit->best_fit] * COMPLEXITY_TOLERANCE)
+		{
+			fit->best_fit = complexity;
+			break;
+		}
+}
@@ -0,0 +1,520 @@
+/**
+ * Title: BENCH LATENCY
+ */
+
+/**
+ * Description: This file contains the latency recorder and its assertions
+ * (assert_latency_percentileLess). The samples (in nanoseconds) are counted in a
+ * log-linear histogram, like HdrHistogram: the values below
+ * 2^LATENCY_SUB_BUCKET_BITS have one bucket each and every following power of 2
+ * is split in 2^(LATENCY_SUB_BUCKET_BITS - 1) buckets. So the memory is constant,
+ * the insertion is O(1) and the relative error of a value is below
+ * 2^-(LATENCY_SUB_BUCKET_BITS - 1) (< 1%).
+ *     Each thread records into its own histogram (allocated on its first
+ * sample), so recording does not need locks; the histograms are merged when
+ * they are read. The histograms of a recorder are indexed by the slot of the
+ * thread, taken on its first sample and given back when the thread exits, so a
+ * later thread reuses it (and keeps adding to its histogram). The threads beyond
+ * MAX_LATENCY_THREADS alive at once share one histogram updated with atomic
+ * additions.
+ */
+
+//Includes:
+#include "globals.h"
+#include "bench.h"
+#include "assert.h"
+#include "text_formatting.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Local macros:
+#define LATENCY_SUB_BUCKET_BITS 8
+#define LATENCY_HALF_SUB_BUCKETS (1 << (LATENCY_SUB_BUCKET_BITS - 1))
+#define LATENCY_NUM_OF_BUCKETS ((64 - LATENCY_SUB_BUCKET_BITS + 2) * LATENCY_HALF_SUB_BUCKETS)
+#define LATENCY_BAR_WIDTH 30
+
+//Definition of types:
+typedef struct {
+	uint64_t counts[LATENCY_NUM_OF_BUCKETS];
+	uint64_t total_count;
+	uint64_t min;
+	uint64_t max;
+} latency_histogram;
+
+struct ctest_latency_recorder {
+	latency_histogram *thread_histograms[MAX_LATENCY_THREADS]; //Indexed by the slot of the thread.
+	latency_histogram shared_histogram;                        //Threads without a slot (its min starts at UINT64_MAX).
+};
+
+//Local variables:
+static _Thread_local int thread_slot = -1;                      //MAX_LATENCY_THREADS if the thread has no slot.
+static int num_of_thread_slots = 0;                             //Slots ever taken.
+static int free_slots[MAX_LATENCY_THREADS];                     //Slots given back by the threads that exited.
+static int num_of_free_slots = 0;
+static pthread_mutex_t slots_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t slot_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t slot_key;                                  //Its destructor gives the slot back.
+
+//Local auxiliary functions:
+static void create_slot_key();
+static int take_thread_slot();
+static void release_thread_slot(void *slot);
+static size_t get_bucket_index(uint64_t value);
+static uint64_t get_bucket_lowest_value(size_t index);
+static uint64_t get_bucket_highest_value(size_t index);
+static void merge_histograms(ctest_latency_recorder *recorder, latency_histogram *result);
+static uint64_t get_percentile(latency_histogram *histogram, double percentile);
+static size_t print_histogram(latency_histogram *histogram, char str[], size_t size);
+
+
+//Function definitions:
+ctest_latency_recorder *latency_recorder_create()
+/**
+ * Description: This function creates an empty latency recorder.
+ *
+ * Memory allocation: The user must call latency_recorder_delete after using the
+ * recorder.
+ *
+ * Input: (void)
+ *
+ * Output: (ctest_latency_recorder *) --> The recorder.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(LATENCY_NUM_OF_BUCKETS)
+ *
+ * Space Complexity: O(LATENCY_NUM_OF_BUCKETS)
+ */
+{
+	ctest_latency_recorder *recorder = calloc(1, sizeof *recorder);
+
+	if(recorder == NULL)
+	{
+		fprintf(stderr, "Error while allocating the latency recorder.\n");
+		exit(EXIT_FAILURE);
+	}
+	recorder->shared_histogram.min = UINT64_MAX;
+	return recorder;
+}
+
+
+void latency_recorder_delete(ctest_latency_recorder *recorder)
+/**
+ * Description: This function frees 'recorder' and its histograms. No thread may
+ * be recording into it.
+ *
+ * Input: (ctest_latency_recorder *) recorder --> The recorder (NULL is ignored).
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(MAX_LATENCY_THREADS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+
+	if(recorder == NULL) return;
+	for(i = 0; i < MAX_LATENCY_THREADS; i++) free(recorder->thread_histograms[i]);
+	free(recorder);
+}
+
+
+void latency_recorder_reset(ctest_latency_recorder *recorder)
+/**
+ * Description: This function discards every sample of 'recorder'. No thread may
+ * be recording into it.
+ *
+ * Input: (ctest_latency_recorder *) recorder --> The recorder.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(MAX_LATENCY_THREADS * LATENCY_NUM_OF_BUCKETS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+
+	for(i = 0; i < MAX_LATENCY_THREADS; i++)
+		if(recorder->thread_histograms[i] != NULL) memset(recorder->thread_histograms[i], 0, sizeof *recorder->thread_histograms[i]);
+	memset(&recorder->shared_histogram, 0, sizeof recorder->shared_histogram);
+	recorder->shared_histogram.min = UINT64_MAX;
+}
+
+
+void latency_recorder_record(ctest_latency_recorder *recorder, uint64_t nanoseconds)
+/**
+ * Description: This function records one sample. It may be called from many
+ * threads at the same time.
+ *
+ * Input: (ctest_latency_recorder *) recorder --> The recorder.
+ *        (uint64_t) nanoseconds --> The latency.
+ *
+ * Output: (void)
+ *
+ * Error handling: If the histogram of the thread can not be allocated, this
+ * function prints an error message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1), except for the first sample of a thread: O(LATENCY_NUM_OF_BUCKETS).
+ */
+{
+	size_t index = get_bucket_index(nanoseconds);
+	latency_histogram *histogram;
+	uint64_t value;
+
+	if(thread_slot < 0) thread_slot = take_thread_slot();
+
+	if(thread_slot >= MAX_LATENCY_THREADS) //Shared histogram: atomic updates.
+	{
+		histogram = &recorder->shared_histogram;
+		__atomic_fetch_add(&histogram->counts[index], 1, __ATOMIC_RELAXED);
+		__atomic_fetch_add(&histogram->total_count, 1, __ATOMIC_RELAXED);
+		value = __atomic_load_n(&histogram->min, __ATOMIC_RELAXED);
+		while(nanoseconds < value && !__atomic_compare_exchange_n(&histogram->min, &value, nanoseconds, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+		value = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
+		while(nanoseconds > value && !__atomic_compare_exchange_n(&histogram->max, &value, nanoseconds, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+		return;
+	}
+
+	//Histogram of the thread: only this thread writes it, so the atomic stores are plain stores.
+	histogram = __atomic_load_n(&recorder->thread_histograms[thread_slot], __ATOMIC_ACQUIRE);
+	if(histogram == NULL)
+	{
+		histogram = calloc(1, sizeof *histogram);
+		if(histogram == NULL)
+		{
+			fprintf(stderr, "Error while allocating the histogram of the latency recorder.\n");
+			exit(EXIT_FAILURE);
+		}
+		__atomic_store_n(&recorder->thread_histograms[thread_slot], histogram, __ATOMIC_RELEASE);
+	}
+	__atomic_store_n(&histogram->counts[index], histogram->counts[index] + 1, __ATOMIC_RELAXED);
+	if(histogram->total_count == 0 || nanoseconds < histogram->min) __atomic_store_n(&histogram->min, nanoseconds, __ATOMIC_RELAXED);
+	if(nanoseconds > histogram->max) __atomic_store_n(&histogram->max, nanoseconds, __ATOMIC_RELAXED);
+	__atomic_store_n(&histogram->total_count, histogram->total_count + 1, __ATOMIC_RELAXED);
+}
+
+
+uint64_t latency_recorder_count(ctest_latency_recorder *recorder)
+/**
+ * Description: This function returns the number of samples of 'recorder'.
+ *
+ * Input: (ctest_latency_recorder *) recorder --> The recorder.
+ *
+ * Output: (uint64_t) --> The number of samples.
+ *
+ * Time Complexity: O(MAX_LATENCY_THREADS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	uint64_t count = __atomic_load_n(&recorder->shared_histogram.total_count, __ATOMIC_RELAXED);
+	latency_histogram *histogram;
+	size_t i;
+
+	for(i = 0; i < MAX_LATENCY_THREADS; i++)
+		if((histogram = __atomic_load_n(&recorder->thread_histograms[i], __ATOMIC_ACQUIRE)) != NULL)
+			count += __atomic_load_n(&histogram->total_count, __ATOMIC_RELAXED);
+	return count;
+}
+
+
+uint64_t latency_recorder_percentile(ctest_latency_recorder *recorder, double percentile)
+/**
+ * Description: This function returns the given percentile of the samples of
+ * 'recorder'. The value is the highest value of its bucket (the result is never
+ * less than the exact percentile and exceeds it by less than 1%), limited to
+ * the maximum sample.
+ *
+ * Input: (ctest_latency_recorder *) recorder --> The recorder.
+ *        (double) percentile --> The percentile (0 to 100, e.g. 99.9).
+ *
+ * Output: (uint64_t) --> The percentile in nanoseconds (0 if there are no samples).
+ *
+ * Time Complexity: O(MAX_LATENCY_THREADS * LATENCY_NUM_OF_BUCKETS)
+ *
+ * Space Complexity: O(LATENCY_NUM_OF_BUCKETS)
+ */
+{
+	latency_histogram histogram;
+
+	merge_histograms(recorder, &histogram);
+	return get_percentile(&histogram, percentile);
+}
+
+
+uint64_t latency_get_time_ns()
+/**
+ * Description: This function returns the time of CLOCK_MONOTONIC in nanoseconds.
+ *
+ * Input: (void)
+ *
+ * Output: (uint64_t) --> The time.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t) time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+
+void assert_latency_percentileLess(ctest_latency_recorder *recorder, double percentile, uint64_t max_nanoseconds, int line_number, char custom_message[])
+/**
+ * Description: This function checks if the given percentile of the samples of
+ * 'recorder' is less than 'max_nanoseconds' (see latency_recorder_percentile).
+ * The histograms of all the threads are merged, so the recording threads must
+ * have finished. A recorder without samples fails.
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (ctest_latency_recorder *) recorder --> The recorder.
+ *        (double) percentile --> The percentile (0 to 100, e.g. 99.9).
+ *        (uint64_t) max_nanoseconds --> The limit.
+ *        (int) line_number --> The number of the line on which this function was written in the
+ *        source code.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(MAX_LATENCY_THREADS * LATENCY_NUM_OF_BUCKETS)
+ *
+ * Space Complexity: O(LATENCY_NUM_OF_BUCKETS)
+ */
+{
+	assert_result_struct assert_result = {
+		true,                                                            //was_successful
+		line_number,                                                     //line_number
+		get_result_details_buffer(),                                     //result_details[MAX_CHARS]
+		"assert_latency_percentileLess",                                 //assert_name
+		"The PERCENTILE of the latency SHOULD BE LESS than the limit.",  //std_message
+		custom_message                                                   //custom_message
+	};
+	latency_histogram histogram;
+	uint64_t value;
+	char value_str[32], limit_str[32];
+	size_t length;
+
+	if(ignore) goto print;
+
+	merge_histograms(recorder, &histogram);
+	value = get_percentile(&histogram, percentile);
+	assert_result.was_successful = histogram.total_count > 0 && value < max_nanoseconds;
+	if(failure_details_are_needed(&assert_result))
+	{
+		length = snprintf(assert_result.result_details, MAX_CHARS,
+				"> p%-8g : %s (limit: %s)\n"\
+				"> samples   : %llu\n",
+				percentile, TF_time_to_str(value * 1e-9, value_str, sizeof value_str), TF_time_to_str(max_nanoseconds * 1e-9, limit_str, sizeof limit_str),
+				(unsigned long long) histogram.total_count);
+		if(histogram.total_count > 0 && length < MAX_CHARS)
+			print_histogram(&histogram, assert_result.result_details + length, MAX_CHARS - length);
+	}
+
+print:
+	print_assert_result(&assert_result);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void create_slot_key()
+/**
+ * Description: This function creates the key whose destructor gives back the
+ * slot of an exiting thread.
+ */
+{
+	if(pthread_key_create(&slot_key, release_thread_slot) != 0)
+	{
+		fprintf(stderr, "Error while creating the key of the latency recorder.\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+
+static int take_thread_slot()
+/**
+ * Description: This function returns a slot for the calling thread: one given
+ * back by a thread that exited, else a new one, else MAX_LATENCY_THREADS (no
+ * slot). It is called on the first sample of the thread.
+ */
+{
+	int slot = MAX_LATENCY_THREADS;
+
+	pthread_once(&slot_key_once, create_slot_key);
+	pthread_mutex_lock(&slots_mutex);
+	if(num_of_free_slots > 0) slot = free_slots[--num_of_free_slots];
+	else if(num_of_thread_slots < MAX_LATENCY_THREADS) slot = num_of_thread_slots++;
+	pthread_mutex_unlock(&slots_mutex);
+
+	//The value of the key is the slot + 1 (a NULL value has no destructor call):
+	if(slot < MAX_LATENCY_THREADS) pthread_setspecific(slot_key, (void *) (intptr_t) (slot + 1));
+	return slot;
+}
+
+
+static void release_thread_slot(void *slot)
+/**
+ * Description: This function gives back the slot of an exiting thread. The
+ * mutex also orders the last samples of the thread before the first samples of
+ * the next thread with the slot.
+ */
+{
+	pthread_mutex_lock(&slots_mutex);
+	free_slots[num_of_free_slots++] = (int) (intptr_t) slot - 1;
+	pthread_mutex_unlock(&slots_mutex);
+}
+
+
+static size_t get_bucket_index(uint64_t value)
+/**
+ * Description: This function returns the index of the bucket of 'value'. Above
+ * 2^LATENCY_SUB_BUCKET_BITS, the value is shifted until it has
+ * LATENCY_SUB_BUCKET_BITS bits (its top bit is always set, so the bucket is
+ * given by the shift and the remaining LATENCY_SUB_BUCKET_BITS - 1 bits).
+ */
+{
+	int shift;
+
+	if(value < 2 * LATENCY_HALF_SUB_BUCKETS) return value;
+	shift = 63 - __builtin_clzll(value) - (LATENCY_SUB_BUCKET_BITS - 1);
+	return (size_t) shift * LATENCY_HALF_SUB_BUCKETS + (value >> shift);
+}
+
+
+static uint64_t get_bucket_lowest_value(size_t index)
+/**
+ * Description: This function returns the lowest value of the bucket 'index'.
+ */
+{
+	size_t shift;
+
+	if(index < 2 * LATENCY_HALF_SUB_BUCKETS) return index;
+	shift = index / LATENCY_HALF_SUB_BUCKETS - 1;
+	return (uint64_t) (index - shift * LATENCY_HALF_SUB_BUCKETS) << shift;
+}
+
+
+static uint64_t get_bucket_highest_value(size_t index)
+/**
+ * Description: This function returns the highest value of the bucket 'index'.
+ */
+{
+	size_t shift;
+
+	if(index < 2 * LATENCY_HALF_SUB_BUCKETS) return index;
+	shift = index / LATENCY_HALF_SUB_BUCKETS - 1;
+	return ((uint64_t) (index - shift * LATENCY_HALF_SUB_BUCKETS + 1) << shift) - 1;
+}
+
+
+static void merge_histograms(ctest_latency_recorder *recorder, latency_histogram *result)
+/**
+ * Description: This function writes in 'result' the sum of the histograms of
+ * 'recorder'.
+ */
+{
+	latency_histogram *histograms[MAX_LATENCY_THREADS + 1], *histogram;
+	size_t i, j, num_of_histograms = 0;
+	uint64_t count;
+
+	memset(result, 0, sizeof *result);
+	histograms[num_of_histograms++] = &recorder->shared_histogram;
+	for(i = 0; i < MAX_LATENCY_THREADS; i++)
+		if((histogram = __atomic_load_n(&recorder->thread_histograms[i], __ATOMIC_ACQUIRE)) != NULL)
+			histograms[num_of_histograms++] = histogram;
+
+	for(i = 0; i < num_of_histograms; i++)
+	{
+		histogram = histograms[i];
+		if((count = __atomic_load_n(&histogram->total_count, __ATOMIC_RELAXED)) == 0) continue;
+		if(result->total_count == 0 || __atomic_load_n(&histogram->min, __ATOMIC_RELAXED) < result->min) result->min = __atomic_load_n(&histogram->min, __ATOMIC_RELAXED);
+		if(__atomic_load_n(&histogram->max, __ATOMIC_RELAXED) > result->max) result->max = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
+		result->total_count += count;
+		for(j = 0; j < LATENCY_NUM_OF_BUCKETS; j++) result->counts[j] += __atomic_load_n(&histogram->counts[j], __ATOMIC_RELAXED);
+	}
+}
+
+
+static uint64_t get_percentile(latency_histogram *histogram, double percentile)
+/**
+ * Description: This function returns the percentile of 'histogram' (see
+ * latency_recorder_percentile). The rank of the percentile is
+ * ceil(percentile / 100 * total_count), at least 1.
+ */
+{
+	uint64_t rank, cumulative_count = 0, value;
+	size_t i;
+
+	if(histogram->total_count == 0) return 0;
+	if(percentile >= 100) return histogram->max;
+	if(percentile < 0) percentile = 0;
+	rank = (uint64_t) (percentile / 100 * histogram->total_count);
+	if(rank < percentile / 100 * histogram->total_count || rank == 0) rank++;
+
+	for(i = 0; i < LATENCY_NUM_OF_BUCKETS; i++)
+	{
+		cumulative_count += histogram->counts[i];
+		if(cumulative_count >= rank) break;
+	}
+	value = get_bucket_highest_value(i < LATENCY_NUM_OF_BUCKETS ? i : LATENCY_NUM_OF_BUCKETS - 1);
+	return value < histogram->max ? value : histogram->max;
+}
+
+
+static size_t print_histogram(latency_histogram *histogram, char str[], size_t size)
+/**
+ * Description: This function writes in 'str' the histogram grouped by powers of
+ * 2, from the group of the minimum to the group of the maximum. Each line has
+ * the range, the count, the cumulative percentage and a bar; a run of empty
+ * groups is printed as "...". It returns the
+ * number of chars written (at most 'size' - 1).
+ */
+{
+	uint64_t group_counts[64] = {0}, max_group_count = 0, cumulative_count = 0;
+	char low_str[32], high_str[32], bar[LATENCY_BAR_WIDTH + 1];
+	int group, min_group, max_group, bar_length;
+	size_t i, length = 0;
+
+	for(i = 0; i < LATENCY_NUM_OF_BUCKETS; i++)
+	{
+		if(histogram->counts[i] == 0) continue;
+		group = get_bucket_lowest_value(i) == 0 ? 0 : 63 - __builtin_clzll(get_bucket_lowest_value(i));
+		group_counts[group] += histogram->counts[i];
+	}
+	min_group = histogram->min == 0 ? 0 : 63 - __builtin_clzll(histogram->min);
+	max_group = histogram->max == 0 ? 0 : 63 - __builtin_clzll(histogram->max);
+	for(group = min_group; group <= max_group; group++)
+		if(group_counts[group] > max_group_count) max_group_count = group_counts[group];
+
+	length += snprintf(str + length, size - length, "> %-23s %12s %8s\n", "range", "count", "cum.");
+	for(group = min_group; group <= max_group && length < size; group++)
+	{
+		if(group_counts[group] == 0) //A run of empty groups is printed as one line.
+		{
+			if(group_counts[group - 1] != 0) length += snprintf(str + length, size - length, "> ...\n");
+			continue;
+		}
+		cumulative_count += group_counts[group];
+		bar_length = (int) ((group_counts[group] * LATENCY_BAR_WIDTH + max_group_count - 1) / max_group_count);
+		memset(bar, '#', bar_length);
+		bar[bar_length] = '\0';
+		TF_time_to_str((group == 63 ? UINT64_MAX : 2ULL << group) * 1e-9, high_str, sizeof high_str);
+		length += snprintf(str + length, size - length, "> [%10s, %10s) %12llu %7.3f%% %s\n",
+				TF_time_to_str((group == 0 ? 0 : 1ULL << group) * 1e-9, low_str, sizeof low_str), high_str,
+				(unsigned long long) group_counts[group], 100.0 * cumulative_count / histogram->total_count, bar);
+	}
+	return length < size ? length : size - 1;
+}
@@ -0,0 +1,315 @@
+/**
+ * Title: BENCH NOISE
+ */
+
+/**
+ * Description: This file contains the noise control mode of the timing-based
+ * measures (CTEST_BENCH, CTEST_BENCH_COMPARE and ASSERT_COMPLEXITY). It is
+ * opt-in: it is used only if 'bench_config.noise_control' is true or the
+ * environment variable CTEST_BENCH_NOISE_CONTROL is "1". While a measure runs:
+ * 	- the calling thread is pinned to one CPU with sched_setaffinity(), so the
+ * scheduler does not migrate it (and its caches) between samples. The CPU is
+ * 'bench_config.cpu' (or CTEST_BENCH_CPU); if it is -1, the first CPU of
+ * /sys/devices/system/cpu/isolated allowed to the thread is selected, otherwise
+ * the last allowed CPU (the CPU 0 usually receives most of the interrupts);
+ * 	- if 'bench_config.raise_priority' is true, the nice value of the thread is
+ * set to -20 (it needs CAP_SYS_NICE);
+ * 	- a warning is sent to the reporters (see reporter.h) once if the frequency
+ * governor of the CPU is not "performance", and once if the thread can not be
+ * pinned or its priority can not be raised;
+ * 	- a sample during which the thread was switched out (voluntary or
+ * involuntary context switches of getrusage(RUSAGE_THREAD)) is discarded and
+ * taken again. At most as many samples as requested are discarded, so a busy
+ * machine makes the measure at most twice as long.
+ * The affinity and the priority are restored at the end of the measure, or by
+ * bench_noise_abort() if the measure crashed.
+ */
+
+//Includes:
+#define _GNU_SOURCE
+#include "globals.h"
+#include "bench.h"
+#include "reporter.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+//Local variables:
+static int noise_depth = 0;            //Nested measures (the mode is entered by the outermost).
+static int pinned_cpu = -1;
+static cpu_set_t old_affinity;
+static bool has_old_affinity = false;
+static int old_nice;
+static bool has_old_nice = false;
+static bool was_governor_checked = false;
+static bool was_pinning_warned = false;
+static bool was_priority_warned = false;
+
+//Local auxiliary functions:
+static int select_cpu(cpu_set_t *allowed);
+static void check_governor(int cpu);
+
+
+//Function definitions:
+bool bench_noise_is_enabled()
+/**
+ * Description: This function says if the timing-based measures must use the
+ * noise control mode.
+ *
+ * Input: (void)
+ *
+ * Output: (bool) --> true if 'bench_config.noise_control' is true or the
+ *         environment variable CTEST_BENCH_NOISE_CONTROL is "1".
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	char *value = getenv("CTEST_BENCH_NOISE_CONTROL");
+
+	return bench_config.noise_control || (value != NULL && strcmp(value, "1") == 0);
+}
+
+
+void bench_noise_begin()
+/**
+ * Description: This function enters the noise control mode (see the
+ * description of this file), if it is enabled. Each call must be paired with a
+ * call of bench_noise_end().
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(number of CPUs)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	cpu_set_t pinned_set;
+	char message[128];
+	pid_t tid;
+	int cpu;
+
+	if(noise_depth++ > 0 || !bench_noise_is_enabled()) return;
+
+	//Pin the thread:
+	has_old_affinity = sched_getaffinity(0, sizeof old_affinity, &old_affinity) == 0;
+	cpu = has_old_affinity ? select_cpu(&old_affinity) : bench_config.cpu;
+	if(cpu >= 0)
+	{
+		CPU_ZERO(&pinned_set);
+		CPU_SET(cpu, &pinned_set);
+		if(sched_setaffinity(0, sizeof pinned_set, &pinned_set) == 0) pinned_cpu = cpu;
+		else if(!was_pinning_warned)
+		{
+			was_pinning_warned = true;
+			snprintf(message, sizeof message, "the thread can not be pinned to the CPU %d (%s).", cpu, strerror(errno));
+			reporters_warning("noise control", message);
+		}
+	}
+
+	//Raise the priority:
+	if(bench_config.raise_priority)
+	{
+		tid = syscall(SYS_gettid);
+		errno = 0;
+		old_nice = getpriority(PRIO_PROCESS, tid);
+		has_old_nice = errno == 0;
+		if(has_old_nice && setpriority(PRIO_PROCESS, tid, -20) < 0 && !was_priority_warned)
+		{
+			was_priority_warned = true;
+			snprintf(message, sizeof message, "the priority of the thread can not be raised (%s).", strerror(errno));
+			reporters_warning("noise control", message);
+		}
+	}
+
+	check_governor(pinned_cpu >= 0 ? pinned_cpu : sched_getcpu());
+}
+
+
+void bench_noise_end()
+/**
+ * Description: This function leaves the noise control mode entered by
+ * bench_noise_begin(), restoring the affinity and the priority of the thread.
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(noise_depth == 0 || --noise_depth > 0) return;
+
+	if(pinned_cpu >= 0 && has_old_affinity) sched_setaffinity(0, sizeof old_affinity, &old_affinity);
+	if(has_old_nice) setpriority(PRIO_PROCESS, syscall(SYS_gettid), old_nice);
+	pinned_cpu = -1;
+	has_old_affinity = false;
+	has_old_nice = false;
+}
+
+
+void bench_noise_abort()
+/**
+ * Description: This function leaves the noise control mode, whatever the number
+ * of nested measures. It is called by record_module_crash(): a contained crash
+ * inside a measure skips its bench_noise_end().
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(noise_depth == 0) return;
+	noise_depth = 1;
+	bench_noise_end();
+}
+
+
+int bench_noise_get_cpu()
+/**
+ * Description: This function returns the CPU to which the thread is pinned by
+ * the noise control mode.
+ *
+ * Input: (void)
+ *
+ * Output: (int) --> The CPU, or -1 if the thread is not pinned.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return pinned_cpu;
+}
+
+
+uint64_t bench_noise_get_switches()
+/**
+ * Description: This function returns the number of context switches (voluntary
+ * and involuntary) of the calling thread, if the noise control mode is active.
+ * It is called before each sample.
+ *
+ * Input: (void)
+ *
+ * Output: (uint64_t) --> The context switches (0 outside the mode).
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	struct rusage usage;
+
+	if(noise_depth == 0 || !bench_noise_is_enabled()) return 0;
+	if(getrusage(RUSAGE_THREAD, &usage) < 0) return 0;
+	return (uint64_t) usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+
+bool bench_noise_discard_sample(uint64_t start_switches, size_t *num_of_discarded, size_t max_discarded)
+/**
+ * Description: This function is called after a sample. It says if the sample
+ * must be discarded because the thread was switched out during it.
+ *
+ * Input: (uint64_t) start_switches --> bench_noise_get_switches() before the sample.
+ *        (size_t *) num_of_discarded --> The samples discarded by the measure. It
+ *        is incremented if the sample is discarded.
+ *        (size_t) max_discarded --> The maximum number of samples discarded by the
+ *        measure. After that, every sample is kept.
+ *
+ * Output: (bool) --> true if the sample must be discarded and taken again.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(noise_depth == 0 || *num_of_discarded >= max_discarded || !bench_noise_is_enabled()) return false;
+	if(bench_noise_get_switches() == start_switches) return false;
+	(*num_of_discarded)++;
+	return true;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static int select_cpu(cpu_set_t *allowed)
+/**
+ * Description: This function returns the CPU of the mode (see the description
+ * of this file), or -1 if the configured CPU is not allowed to the thread.
+ */
+{
+	char isolated[256], *token, *saveptr;
+	int cpu, first, last;
+	FILE *isolated_file;
+
+	if(bench_config.cpu >= 0 || getenv("CTEST_BENCH_CPU") != NULL)
+	{
+		cpu = bench_config.cpu >= 0 ? bench_config.cpu : atoi(getenv("CTEST_BENCH_CPU"));
+		return cpu < CPU_SETSIZE && CPU_ISSET(cpu, allowed) ? cpu : -1;
+	}
+
+	//Isolated CPUs (e.g. "2-3,6"):
+	isolated_file = fopen("/sys/devices/system/cpu/isolated", "r");
+	if(isolated_file != NULL)
+	{
+		if(fgets(isolated, sizeof isolated, isolated_file) != NULL)
+		{
+			for(token = strtok_r(isolated, ",\n", &saveptr); token != NULL; token = strtok_r(NULL, ",\n", &saveptr))
+			{
+				if(sscanf(token, "%d-%d", &first, &last) < 2) last = first;
+				for(cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+				{
+					if(CPU_ISSET(cpu, allowed))
+					{
+						fclose(isolated_file);
+						return cpu;
+					}
+				}
+			}
+		}
+		fclose(isolated_file);
+	}
+
+	for(cpu = CPU_SETSIZE - 1; cpu >= 0; cpu--) if(CPU_ISSET(cpu, allowed)) return cpu;
+	return -1;
+}
+
+
+static void check_governor(int cpu)
+/**
+ * Description: This function sends a warning to the reporters if the frequency
+ * governor of 'cpu' is not "performance". It is checked once per process;
+ * nothing is reported if the CPU has no frequency scaling (e.g. virtual machines).
+ */
+{
+	char path[96], governor[32] = "", message[128];
+	FILE *governor_file;
+
+	if(was_governor_checked || cpu < 0) return;
+	was_governor_checked = true;
+
+	snprintf(path, sizeof path, "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cpu);
+	governor_file = fopen(path, "r");
+	if(governor_file == NULL) return;
+	if(fgets(governor, sizeof governor, governor_file) != NULL) governor[strcspn(governor, "\n")] = '\0';
+	fclose(governor_file);
+
+	if(strcmp(governor, "performance") == 0) return;
+	snprintf(message, sizeof message, "the frequency governor of the CPU %d is \"%s\", not \"performance\".", cpu, governor);
+	reporters_warning("noise control", message);
+}
@@ -0,0 +1,338 @@
+/**
+ * Title: BENCH PERF
+ */
+
+/**
+ * Description: This file contains the performance counters of the modules and
+ * of CTEST_BENCH, read with perf_event_open(2). They are opt-in: they are used
+ * only if 'bench_config.perf_counters' is true or the environment variable
+ * CTEST_PERF_COUNTERS is "1".
+ *     The counters are opened as two groups, so the counters of a group are
+ * always scheduled together and their ratios (e.g. instructions per cycle) are
+ * consistent:
+ * 	HARDWARE: instructions, cycles, cache misses and branch misses, counted in
+ * user space only (allowed by the default perf_event_paranoid);
+ * 	SOFTWARE: page faults and context switches. The kernel is excluded only if
+ * the kernel forbids counting it (a context switch happens in the kernel).
+ * A counter that can not be opened (e.g. no PMU in a virtual machine, or
+ * perf_event_paranoid > 2) is marked as not available and the others are still
+ * used, so the hardware counters degrade cleanly to the software ones. If the
+ * kernel multiplexes a group, its values are scaled by enabled / running time.
+ *     The counters measure the calling thread only.
+ */
+
+//Includes:
+#include "globals.h"
+#include "bench.h"
+#include "assert.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+//Local variables:
+static const struct {
+	char *label;
+	uint32_t type;
+	uint64_t config;
+	int group;
+} perf_events[NUM_OF_PERF_COUNTERS] = {
+	[PERF_COUNTER_INSTRUCTIONS]     = {"INSTRUCTIONS:", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 0},
+	[PERF_COUNTER_CYCLES]           = {"CYCLES:", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 0},
+	[PERF_COUNTER_CACHE_MISSES]     = {"CACHE MISSES:", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, 0},
+	[PERF_COUNTER_BRANCH_MISSES]    = {"BRANCH MISSES:", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, 0},
+	[PERF_COUNTER_PAGE_FAULTS]      = {"PAGE FAULTS:", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, 1},
+	[PERF_COUNTER_CONTEXT_SWITCHES] = {"CTX SWITCHES:", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, 1},
+};
+
+//Local auxiliary functions:
+static int open_perf_event(perf_counter_id id, int group_fd, bool exclude_kernel);
+static void read_perf_group(perf_group_struct *group, int g, ctest_perf_counters *counters);
+
+
+//Function definitions:
+bool perf_counters_are_enabled()
+/**
+ * Description: This function says if the modules and the benchmarks must be
+ * measured with the performance counters.
+ *
+ * Input: (void)
+ *
+ * Output: (bool) --> true if 'bench_config.perf_counters' is true or the
+ *         environment variable CTEST_PERF_COUNTERS is "1".
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	char *value = getenv("CTEST_PERF_COUNTERS");
+
+	return bench_config.perf_counters || (value != NULL && strcmp(value, "1") == 0);
+}
+
+
+void perf_group_start(perf_group_struct *group)
+/**
+ * Description: This function opens the counters (see the description of this
+ * file) and starts them from zero.
+ *
+ * Input: (perf_group_struct *) group --> Receives the counters. It must be
+ *        stopped by perf_group_stop().
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(NUM_OF_PERF_COUNTERS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+	int g;
+	bool exclude_kernel;
+
+	for(g = 0; g < 2; g++)
+	{
+		group->leader_fds[g] = -1;
+		group->num_of_members[g] = 0;
+	}
+
+	for(i = 0; i < NUM_OF_PERF_COUNTERS; i++)
+	{
+		g = perf_events[i].group;
+		exclude_kernel = perf_events[i].type == PERF_TYPE_HARDWARE;
+		group->fds[i] = open_perf_event(i, group->leader_fds[g], exclude_kernel);
+		if(group->fds[i] < 0 && !exclude_kernel && (errno == EACCES || errno == EPERM))
+			group->fds[i] = open_perf_event(i, group->leader_fds[g], true);
+		if(group->fds[i] < 0) continue;
+
+		if(group->leader_fds[g] < 0) group->leader_fds[g] = group->fds[i];
+		group->members[g][group->num_of_members[g]++] = i;
+	}
+
+	group->is_open = true;
+	for(g = 0; g < 2; g++)
+	{
+		if(group->leader_fds[g] < 0) continue;
+		ioctl(group->leader_fds[g], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(group->leader_fds[g], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+}
+
+
+void perf_group_stop(perf_group_struct *group, ctest_perf_counters *counters)
+/**
+ * Description: This function stops and closes the counters started by
+ * perf_group_start() and returns their values.
+ *
+ * Input: (perf_group_struct *) group --> The counters. Nothing is done if they
+ *        were not started.
+ *        (ctest_perf_counters *) counters --> Receives the values.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(NUM_OF_PERF_COUNTERS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+	int g;
+
+	memset(counters, 0, sizeof *counters);
+	if(!group->is_open) return;
+
+	for(g = 0; g < 2; g++)
+	{
+		if(group->leader_fds[g] < 0) continue;
+		ioctl(group->leader_fds[g], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		read_perf_group(group, g, counters);
+	}
+	for(i = 0; i < NUM_OF_PERF_COUNTERS; i++) if(group->fds[i] >= 0) close(group->fds[i]);
+	group->is_open = false;
+}
+
+
+void perf_print_counters(FILE *file, const ctest_perf_counters *counters, double num_of_iterations)
+/**
+ * Description: This function prints the counters in the style of the module
+ * summary (see reporter_console.c). The counters that are not available are
+ * printed as "n/a".
+ *
+ * Input: (FILE *) file --> The stream;
+ *        (const ctest_perf_counters *) counters --> The values.
+ *        (double) num_of_iterations --> If greater than 0, the values are
+ *        printed per iteration (benchmarks). Otherwise, the totals are printed.
+ *
+ * Output: (void)
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(NUM_OF_PERF_COUNTERS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	char str[64];
+	size_t i;
+	int n;
+	double ipc;
+
+	for(i = 0; i < NUM_OF_PERF_COUNTERS; i++)
+	{
+		if(!counters->is_available[i]) snprintf(str, sizeof str, "n/a");
+		else if(num_of_iterations > 0) snprintf(str, sizeof str, "%.3f / iteration", counters->values[i] / num_of_iterations);
+		else snprintf(str, sizeof str, "%llu", (unsigned long long) counters->values[i]);
+
+		if(i == PERF_COUNTER_CYCLES && counters->is_available[PERF_COUNTER_INSTRUCTIONS] && counters->is_available[PERF_COUNTER_CYCLES] && counters->values[i] > 0)
+		{
+			ipc = (double) counters->values[PERF_COUNTER_INSTRUCTIONS] / counters->values[i];
+			snprintf(str + strlen(str), sizeof str - strlen(str), " (IPC %.2f)", ipc);
+		}
+
+		n = fprintf(file, "    -> %-16s%-54s \n", perf_events[i].label, str);
+		if (n < 0)
+		{
+			fprintf(stderr, "Error while printing the performance counters.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+
+double bench_get_perf_iterations(const ctest_bench_stats *stats)
+/**
+ * Description: This function returns the number of iterations measured by the
+ * performance counters of a benchmark. The counters also run during the samples
+ * discarded by the noise control mode, so their iterations are included.
+ *
+ * Input: (const ctest_bench_stats *) stats --> The statistics of the benchmark.
+ *
+ * Output: (double) --> The iterations.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return (double) (stats->num_of_samples + stats->num_of_discarded) * stats->iterations_per_sample;
+}
+
+
+void assert_bench_instructionsPerItemLess(double max_instructions, int line_number, char custom_message[])
+/**
+ * Description: This function checks if the last CTEST_BENCH executed less than
+ * 'max_instructions' instructions (user space) per item. The items of one
+ * iteration are set by CTEST_BENCH_SET_ITEMS (1 if it was not used). If the
+ * instructions are not available (the kernel forbids hardware counters), the
+ * result is ignored.
+ *     If 'ignore' is true, this function will not test anything.
+ *
+ * Input: (double) max_instructions --> The maximum number of instructions per item.
+ *        (int) line_number --> The number of the line on which this function was written in the
+ *        source code.
+ *        (char []) custom_message --> Personalized message that will be printed if the test fails.
+ *
+ * Output: (void)
+ *
+ * Error handling: If the last benchmark was not measured with the performance
+ * counters, this function prints an error message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	assert_result_struct assert_result = {
+		true,                                                                 //was_successful
+		line_number,                                                          //line_number
+		get_result_details_buffer(),                                          //result_details[MAX_CHARS]
+		"ASSERT_INSTRUCTIONS_PER_ITEM_LESS",                                  //assert_name
+		"The instructions per item SHOULD BE LESS than the maximum.",         //std_message
+		custom_message                                                        //custom_message
+	};
+	const ctest_bench_stats *stats = get_last_bench_stats();
+	double num_of_items, instructions_per_item;
+	bool previous_ignore = ignore;
+
+	if(ignore) goto print;
+	if(!stats->has_perf_counters)
+	{
+		fprintf(stderr, "Error: ASSERT_INSTRUCTIONS_PER_ITEM_LESS without a CTEST_BENCH measured with the performance counters (at line %d). Set bench_config.perf_counters or CTEST_PERF_COUNTERS=1.\n", line_number);
+		exit(EXIT_FAILURE);
+	}
+	if(!stats->perf.is_available[PERF_COUNTER_INSTRUCTIONS])
+	{
+		//Degrades to an ignored result:
+		ignore = true;
+		print_assert_result(&assert_result);
+		ignore = previous_ignore;
+		return;
+	}
+
+	num_of_items = bench_get_perf_iterations(stats) * (stats->items_per_iteration ? stats->items_per_iteration : 1);
+	instructions_per_item = stats->perf.values[PERF_COUNTER_INSTRUCTIONS] / num_of_items;
+	assert_result.was_successful = instructions_per_item < max_instructions;
+	if(failure_details_are_needed(&assert_result))
+	{
+		snprintf(assert_result.result_details, MAX_CHARS,
+				"> benchmark    : %s\n"\
+				"> instructions : %.3f per item\n"\
+				"> maximum      : %.3f per item\n",
+				stats->name, instructions_per_item, max_instructions);
+	}
+
+print:
+	print_assert_result(&assert_result);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static int open_perf_event(perf_counter_id id, int group_fd, bool exclude_kernel)
+/**
+ * Description: This function opens the counter 'id' of the calling thread. The
+ * leader of a group (group_fd == -1) starts disabled.
+ */
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof attr);
+	attr.size           = sizeof attr;
+	attr.type           = perf_events[id].type;
+	attr.config         = perf_events[id].config;
+	attr.disabled       = group_fd < 0;
+	attr.exclude_kernel = exclude_kernel;
+	attr.exclude_hv     = 1;
+	attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+
+static void read_perf_group(perf_group_struct *group, int g, ctest_perf_counters *counters)
+/**
+ * Description: This function reads the group 'g' (the values are in the order
+ * of opening) and scales them if the group was multiplexed.
+ */
+{
+	uint64_t buffer[3 + NUM_OF_PERF_COUNTERS]; //{nr, time_enabled, time_running, values[nr]}
+	ssize_t n;
+	size_t i;
+	double scale = 1;
+
+	n = read(group->leader_fds[g], buffer, sizeof buffer);
+	if(n < (ssize_t) (3 * sizeof *buffer) || buffer[0] != group->num_of_members[g]) return;
+	if(buffer[2] == 0) return; //The group was never scheduled.
+	if(buffer[2] < buffer[1]) scale = (double) buffer[1] / buffer[2];
+
+	for(i = 0; i < group->num_of_members[g]; i++)
+	{
+		counters->is_available[group->members[g][i]] = true;
+		counters->values[group->members[g][i]] = buffer[3 + i] * scale;
+	}
+}
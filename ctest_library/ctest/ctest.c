@@ -10,22 +10,66 @@
  */
 
 //Includes:
+#define _GNU_SOURCE
 #include "globals.h"
 #include "ctest_functions.h"
+#include "ctest_trace.h"
+#include "reporter.h"
 #include "text_formatting.h"
+#include "assert.h"
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "internal_alloc.h" //Must be the last include.
 
 //Define global variables:
-suite_ctest_info_struct suite_ctest_info;
+suite_ctest_info_struct suite_ctest_info = {.module_child_pid = -1, .module_results_fd = -1};
 ctest_info_struct ctest_info;
 
+//Local variables:
+static const int crash_signals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGABRT};
+#define NUM_OF_CRASH_SIGNALS (sizeof crash_signals / sizeof *crash_signals)
+static struct sigaction previous_crash_actions[NUM_OF_CRASH_SIGNALS];
+static pid_t crash_handler_pid = -1;
+static char crash_stack[1 << 16]; //Alternate stack: a stack overflow may be contained too.
+static struct {
+	long long heap_delta;
+	ctest_perf_counters perf;
+} *child_report = NULL; //Shared with the child of the module, which writes its measures.
+
+//Local auxiliary functions:
+static bool fork_module_child();
+static void merge_module_child();
+static void arm_crash_handlers();
+static void disarm_crash_handlers();
+static void crash_handler(int signal_number);
+static double get_wall_time();
+static double get_cpu_time();
+static void measure_module_memory();
+static void check_module_leak();
+static bool is_fail_on_leak_set();
+static void reset_peak_rss();
+static size_t get_peak_rss();
+static void record_module_stats();
+static void report_module_error(char assert_name[], char details[]);
+
 //Function definitions:
 void start_suite(char *name, char *description, char *func_ids[])
 /**
  * Description: This function starts a new suite of tests. It reads the name of
  * the suite, the description and the IDs of the functions that will be tested.
+ * The environment variable CTEST_MAX_FAILURES_PER_SITE, if set, replaces 
+ * 'max_failures_per_site'; CTEST_ASSERT_STATS, if set, replaces 
+ * 'collect_assert_stats' (see assert_stats.c); CTEST_ASSERT_THREADS, if set,
+ * replaces 'assert_num_of_threads' (see parallel.c).
  * 	The body of the test suite must be nested between a start_suite() and 
  * end_suite().
  *
@@ -42,12 +86,15 @@ void start_suite(char *name, char *description, char *func_ids[])
  * Time/Space Complexity: -
  */
 {
-	char *thick_line = "================================================================================"; // Repeat '=' 80 times.
-	char *thin_line = "--------------------------------------------------------------------------------"; // Repeat '=' 80 times.
-	char suite_description[MAX_DESCRIPTION], *aux_str, *merged_str;
-	int n, line_length = 80;
+	int n;
+	char *value = getenv("CTEST_MAX_FAILURES_PER_SITE");
 
 	//Reset global variables related to the suite:
+	if(value != NULL) max_failures_per_site = atoi(value);
+	value = getenv("CTEST_ASSERT_THREADS");
+	if(value != NULL) assert_num_of_threads = atoi(value);
+	reset_failure_sites();
+	assert_stats_start_suite();
 	ctest_info.num_of_results = 0;
 	ctest_info.num_of_fails   = 0;
 	ctest_info.num_of_ignored = 0;
@@ -55,6 +102,10 @@ void start_suite(char *name, char *description, char *func_ids[])
 	ctest_info.total_fails    = 0;
 	ctest_info.total_ignored  = 0;
 	ctest_info.progress[0]    = '\0';
+	ctest_info.progress_length = 0;
+	suite_ctest_info.num_of_modules = 0;
+	suite_ctest_info.suite_start_wall_time = get_wall_time();
+	suite_ctest_info.suite_start_cpu_time  = get_cpu_time();
 	
 	//Initialize variables:
 	n = snprintf(suite_ctest_info.suite_name, MAX_NAME, name);
@@ -63,47 +114,19 @@ void start_suite(char *name, char *description, char *func_ids[])
 		fprintf(stderr, "Error while initializing suite_ctest_info.suite_name.\n");
 		exit(EXIT_FAILURE);
 	}
+	trace_open(suite_ctest_info.suite_name);
+	reporters_open_from_env();
 
-	n = snprintf(suite_description, MAX_DESCRIPTION, description);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while initializing suite_description.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	//Print the starting informations:
-	n = fprintf(stdout, "%s\n||   START SUITE: %-59s ||\n%s\n", thick_line, suite_ctest_info.suite_name, thin_line);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while printing the suite name.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	aux_str = break_line(suite_description, MAX_DESCRIPTION, "||   DESCRIPTION: ", "||   ", " ||", line_length);
-	n = fprintf(stdout, "%s%s\n", aux_str, thin_line);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while printing the suite description.\n");
-		exit(EXIT_FAILURE);
-	}
-	free(aux_str);
-
-	merged_str = merge_str(func_ids, ", ", ".");
-	aux_str = break_line(merged_str, strlen(merged_str), "||   FUNCTIONS COVERED: ", "||   ", " ||", line_length);
-	n = fprintf(stdout, "%s%s\n\n", aux_str, thin_line);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while printing the suite functions ids.\n");
-		exit(EXIT_FAILURE);
-	}
-	free(merged_str);
-	free(aux_str);
+	reporters_suite_start(suite_ctest_info.suite_name, description, func_ids);
 }
 
 
 void end_suite()
 /**
  * Description: This function ends a suite, printing its summary of results.
+ * If CTEST_TRACE is set, the buffered trace events are written (see ctest_trace.c).
+ * If the statistics of the assertions are collected, the sites are reported
+ * first (see assert_stats.c).
  * 
  * Input: (void)
  *
@@ -112,56 +135,32 @@ void end_suite()
  * Time/Space Complexity: -
  */
 {
-	char *thick_line = "================================================================================"; // Repeat '=' 80 times.
-	char *thin_line = "--------------------------------------------------------------------------------"; // Repeat '=' 80 times.
-	int n;
+	ctest_suite_stats stats;
+
+	report_suppressed_failures();
+	assert_stats_end_suite();
+	snprintf(stats.suite_name, MAX_NAME, "%s", suite_ctest_info.suite_name);
+	stats.num_of_results = ctest_info.total_results;
+	stats.num_of_fails   = ctest_info.total_fails;
+	stats.num_of_ignored = ctest_info.total_ignored;
+	stats.wall_time      = get_wall_time() - suite_ctest_info.suite_start_wall_time;
+	stats.cpu_time       = get_cpu_time() - suite_ctest_info.suite_start_cpu_time;
+	reporters_suite_end(&stats);
+	trace_complete_event("suite", suite_ctest_info.suite_name, suite_ctest_info.suite_start_wall_time, suite_ctest_info.suite_start_wall_time + stats.wall_time);
+	trace_flush();
 
-	//Print the starting informations:
-	n = fprintf(stdout, "\n\n%s\n||   SUMMARY OF THE SUITE: %-50s ||\n%s\n", thin_line, suite_ctest_info.suite_name, thin_line);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while printing the suite summary.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	n = fprintf(stdout, "||   -> TOTAL OF CASES: %-53d ||\n%s\n", ctest_info.total_results, thin_line);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while printing the suite summary.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	n = fprintf(stdout, "||   -> SUCCESSES:      %-53d ||\n%s\n", ctest_info.total_results - ctest_info.total_fails - ctest_info.total_ignored, thin_line);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while printing the suite summary.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	n = fprintf(stdout, "||   -> FAILS:          %-53d ||\n%s\n", ctest_info.total_fails, thin_line);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while printing the suite summary.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	n = fprintf(stdout, "||   -> IGNORED:        %-53d ||\n%s\n\n", ctest_info.total_ignored, thick_line);
-	if (n < 0)
-	{
-		fprintf(stderr, "Error while printing the suite summary.\n");
-		exit(EXIT_FAILURE);
-	}
 	//Reset global variables related to the suite:
 	ctest_info.num_of_results       = 0;
 	ctest_info.num_of_fails         = 0;
  	ctest_info.total_results        = 0;
 	ctest_info.total_fails          = 0;
 	suite_ctest_info.suite_name[0]  = '\0';
+	suite_ctest_info.is_checkpoint_set = false;
 }
 
 
 
-void start_module(char *name, char *description, char *func_ids[])
+bool start_module(char *name, char *description, char *func_ids[])
 /**
  * Description: This function starts a new module (modules may be nested inside 
  * suites) of tests. It reads the name of the module, the description and the 
@@ -169,6 +168,8 @@ void start_module(char *name, char *description, char *func_ids[])
  * 	The body of the test module must be nested between a start_module() and 
  * end_module() and nested inside a suite. A module body outside a suite generates
  * an undefined behavior.
+ * 	After CTEST_FIXTURE_CHECKPOINT(), the module is executed by a child process
+ * and the body must be executed only if this function returns true.
  *
  *
  * Input: (char *) name --> The name of the module;
@@ -178,15 +179,17 @@ void start_module(char *name, char *description, char *func_ids[])
  *        in order to indicate the end of the array. If the pointer 'func_ids'
  *        is NULL, it is equivalent to receive no ID.;
  *
- * Output: (void)
+ * Output: (bool) --> true if the body of the module must be executed by this
+ *         process. It is false only in the parent of a checkpointed module.
  *
  * Time/Space Complexity: -
  */
 {
-	char *thick_line = "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~"; // Repeat '~' 80 times.
-	char *thin_line = "................................................................................"; // Repeat '.' 80 times.
-	char module_description[MAX_DESCRIPTION], *aux_str, *merged_str;
-	int n, line_length = 80;
+	int n;
+
+	//The fails of the suite counted per site before the module:
+	report_suppressed_failures();
+	reset_failure_sites();
 
 	//Keep track of the suite results:
 	suite_ctest_info.num_of_suite_results = ctest_info.num_of_results;
@@ -200,8 +203,10 @@ void start_module(char *name, char *description, char *func_ids[])
 	ctest_info.num_of_fails         = 0;
 	ctest_info.num_of_ignored       = 0;
 	ctest_info.print_progress       = true;
+	ctest_info.last_line_number     = 0;
 	suite_ctest_info.module_name[0] = '\0';
 	ctest_info.progress[0]          = '\0';
+	ctest_info.progress_length      = 0;
 	
 	//Initialize variables:
 	n = snprintf(suite_ctest_info.module_name, MAX_NAME, name);
@@ -211,102 +216,549 @@ void start_module(char *name, char *description, char *func_ids[])
 		exit(EXIT_FAILURE);
 	}
 
-	n = snprintf(module_description, MAX_DESCRIPTION, description);
-	if (n < 0)
+	reporters_module_start(suite_ctest_info.module_name, description, func_ids);
+
+	suite_ctest_info.module_start_heap      = get_live_heap_bytes();
+	reset_peak_rss();
+	suite_ctest_info.module_start_wall_time = get_wall_time();
+	suite_ctest_info.module_start_cpu_time  = get_cpu_time();
+	if(suite_ctest_info.is_checkpoint_set && !fork_module_child()) return false;
+	if(perf_counters_are_enabled()) perf_group_start(&suite_ctest_info.module_perf_group);
+	return true;
+}
+
+
+
+void end_module()
+/**
+ * Description: This function ends a module, printing its summary of results.
+ * If the module was executed by a child process, the child exits here and the
+ * parent merges its results before printing the summary. The fails that were
+ * only counted (see max_failures_per_site) are reported first, per site.
+ * 	The summary includes the growth of the live heap during the module (only if
+ * the test is linked with CTEST_ALLOC_HOOKS_LINK_FLAGS) and the peak RSS. If
+ * 'suite_ctest_info.fail_on_leak' is true or the environment variable 
+ * CTEST_FAIL_ON_LEAK is "1", a module whose live heap grew receives one fail.
+ * If the performance counters are enabled (see bench_perf.c), they are printed
+ * too.
+ * 
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time/Space Complexity: -
+ */
+{
+	double summary_start_time, summary_end_time;
+
+	report_suppressed_failures();
+	reset_failure_sites();
+	if(suite_ctest_info.is_module_child)
 	{
-		fprintf(stderr, "Error while initializing module_description.\n");
-		exit(EXIT_FAILURE);
+		perf_group_stop(&suite_ctest_info.module_perf_group, &child_report->perf);
+		child_report->heap_delta = get_live_heap_bytes() - suite_ctest_info.module_start_heap;
+		trace_complete_event("module", suite_ctest_info.module_name, suite_ctest_info.module_start_wall_time, get_wall_time());
+		trace_flush();
+		fflush(NULL);
+		exit(EXIT_SUCCESS);
 	}
+	if(suite_ctest_info.module_child_pid >= 0) merge_module_child();
+	else measure_module_memory();
+	if(suite_ctest_info.is_crash_jump_set) disarm_crash_handlers();
+	check_module_leak();
+	record_module_stats();
+	summary_start_time = get_wall_time();
+	reporters_module_end(&suite_ctest_info.modules_stats[suite_ctest_info.num_of_modules - 1]);
+	summary_end_time = get_wall_time();
+	trace_complete_event("output", "module summary", summary_start_time, summary_end_time);
+	trace_complete_event("module", suite_ctest_info.module_name, suite_ctest_info.module_start_wall_time, summary_end_time);
 
-	//Print the starting informations:
-	n = fprintf(stdout, "\n\n%s\n    START MODULE:      %-54s \n", thick_line, suite_ctest_info.module_name);
-	if (n < 0)
+	//Reset global variables related to the module:
+	ctest_info.num_of_results = suite_ctest_info.num_of_suite_results;
+	ctest_info.num_of_fails   = suite_ctest_info.num_of_suite_fails;
+	ctest_info.num_of_ignored = suite_ctest_info.num_of_suite_ignored;
+	ctest_info.progress[0]    = '\0';
+	strcat(ctest_info.progress, suite_ctest_info.suite_progress);
+	ctest_info.progress_length = strlen(ctest_info.progress);
+	suite_ctest_info.module_name[0]  = '\0';
+	ctest_info.print_progress        = true;
+}
+
+
+
+void fixture_checkpoint()
+/**
+ * Description: This function turns the current process into the checkpoint of
+ * the suite (see CTEST_FIXTURE_CHECKPOINT()). Every module started after this
+ * call is executed by a copy-on-write child of this process, so the fixture 
+ * built before the call is set up only once per suite and each module starts
+ * from the same state. It must be called inside a suite and outside modules.
+ * 
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time/Space Complexity: -
+ */
+{
+	suite_ctest_info.is_checkpoint_set = true;
+}
+
+
+
+bool start_contained_module(char *name, char *description, char *func_ids[])
+/**
+ * Description: This function starts a module (see start_module()) whose crashes 
+ * are contained (see CTEST_MODULE). The handlers of SIGSEGV, SIGBUS, SIGFPE and
+ * SIGABRT are installed until end_module() and jump back to the sigsetjmp() of
+ * CTEST_MODULE.
+ *
+ * Input: The same of start_module().
+ *
+ * Output: (bool) --> The same of start_module().
+ *
+ * Time/Space Complexity: -
+ */
+{
+	if(!start_module(name, description, func_ids)) return false;
+	arm_crash_handlers();
+	return true;
+}
+
+
+
+void record_module_crash()
+/**
+ * Description: This function is called by CTEST_MODULE after the body of the 
+ * module was interrupted by a signal. The streams captured by the open
+ * WITH_ASSERT blocks and the noise control mode of an interrupted measure are
+ * restored first and an open batch or streaming session is discarded, then the
+ * crash is printed and counted as one fail of the module.
+ * 
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time/Space Complexity: -
+ */
+{
+	int signal_number = suite_ctest_info.crash_signal;
+	char details[128];
+
+	disarm_crash_handlers();
+
+	//The blocks interrupted by the crash did not restore their state:
+	with_assert_abort_captures();
+	batch_abort();
+	ctest_stream_abort();
+	bench_noise_abort();
+
+	if(ctest_info.last_line_number > 0)
+		snprintf(details, sizeof details, "The module crashed with signal %d (%s) after the assert at LINE %d.", signal_number, strsignal(signal_number), ctest_info.last_line_number);
+	else
+		snprintf(details, sizeof details, "The module crashed with signal %d (%s) before its first assert.", signal_number, strsignal(signal_number));
+	report_module_error("MODULE CRASH", details);
+}
+
+
+
+ctest_module_stats get_last_module_stats()
+/**
+ * Description: This function returns the stats (times, memory and results) of the last
+ * module ended in the current suite. If no module was ended, the stats are zero.
+ * 
+ * Input: (void)
+ *
+ * Output: (ctest_module_stats) --> The stats of the last module.
+ *
+ * Time/Space Complexity: O(1)
+ */
+{
+	ctest_module_stats empty_stats = {0};
+
+	if(suite_ctest_info.num_of_modules == 0) return empty_stats;
+	return suite_ctest_info.modules_stats[suite_ctest_info.num_of_modules - 1];
+}
+
+
+
+const ctest_module_stats *get_suite_modules_stats(size_t *num_of_modules)
+/**
+ * Description: This function returns the stats of every module ended in the
+ * current (or last) suite, in the order of execution. The array is valid until
+ * the next start_suite() or end_module().
+ * 
+ * Input: (size_t *) num_of_modules --> Receives the number of modules.
+ *
+ * Output: (const ctest_module_stats *) --> The stats of the modules.
+ *
+ * Time/Space Complexity: O(1)
+ */
+{
+	*num_of_modules = suite_ctest_info.num_of_modules;
+	return suite_ctest_info.modules_stats;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static bool fork_module_child()
+/**
+ * Description: This function forks the child that executes the body of the 
+ * current module. The child sends its results through a pipe ('result_pipe_fd').
+ *
+ * Output: (bool) --> true in the child and false in the parent.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	int pipe_fds[2];
+	pid_t pid;
+
+	//The buffers must be empty, otherwise they would be written twice:
+	fflush(NULL);
+
+	if(child_report == NULL)
 	{
-		fprintf(stderr, "Error while printing the suite name.\n");
-		exit(EXIT_FAILURE);
+		child_report = mmap(NULL, sizeof *child_report, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if(child_report == MAP_FAILED)
+		{
+			child_report = NULL;
+			fprintf(stderr, "Error while mapping the memory shared with the child of the module.\n");
+			exit(EXIT_FAILURE);
+		}
 	}
+	memset(child_report, 0, sizeof *child_report);
 
-	aux_str = break_line(module_description, MAX_DESCRIPTION, "    DESCRIPTION:       ", "    ", " ", line_length);
-	n = fprintf(stdout, "%s", aux_str);
-	if (n < 0)
+	if(pipe2(pipe_fds, O_CLOEXEC) < 0)
 	{
-		fprintf(stderr, "Error while printing the suite description.\n");
+		fprintf(stderr, "Error while creating the pipe for the results of the module.\n");
 		exit(EXIT_FAILURE);
 	}
-	free(aux_str);
 
-	merged_str = merge_str(func_ids, ", ", ".");
-	aux_str = break_line(merged_str, strlen(merged_str), "    FUNCTIONS COVERED: ", "    ", " ", line_length);
-	n = fprintf(stdout, "%s%s", aux_str, thin_line);
-	if (n < 0)
+	pid = fork();
+	if(pid < 0)
 	{
-		fprintf(stderr, "Error while printing the suite functions ids.\n");
+		fprintf(stderr, "Error while creating the child process of the module.\n");
 		exit(EXIT_FAILURE);
 	}
-	free(merged_str);
-	free(aux_str);
-}
 
+	if(pid == 0)
+	{
+		close(pipe_fds[0]);
+		suite_ctest_info.is_module_child = true;
+		result_pipe_fd = pipe_fds[1];
+		trace_after_fork(suite_ctest_info.module_name);
+		return true;
+	}
+
+	close(pipe_fds[1]);
+	suite_ctest_info.module_child_pid  = pid;
+	suite_ctest_info.module_results_fd = pipe_fds[0];
+	return false;
+}
 
 
-void end_module()
+static void merge_module_child()
 /**
- * Description: This function ends a module, printing its summary of results.
- * 
- * Input: (void)
+ * Description: This function merges the results sent by the child of the current
+ * module and waits for its termination. If the child did not reach end_module()
+ * (it crashed or called exit()), the module receives one more fail. The heap
+ * delta and the counters of the module are written by the child, and the peak
+ * RSS is the one of the child.
  *
- * Output: (void)
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char results[MAX_RESULTS], details[128];
+	ssize_t n;
+	int child_status;
+	struct rusage child_usage;
+
+	//Read the results until the child closes the pipe:
+	while((n = read(suite_ctest_info.module_results_fd, results, sizeof results)) != 0)
+	{
+		if(n < 0)
+		{
+			if(errno == EINTR) continue;
+			fprintf(stderr, "Error while reading the results of the module.\n");
+			exit(EXIT_FAILURE);
+		}
+		merge_assert_results(results, n);
+	}
+	close(suite_ctest_info.module_results_fd);
+	suite_ctest_info.module_results_fd = -1;
+
+	while(wait4(suite_ctest_info.module_child_pid, &child_status, 0, &child_usage) < 0)
+	{
+		if(errno != EINTR)
+		{
+			fprintf(stderr, "Error while waiting for the child process of the module.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	suite_ctest_info.module_child_pid = -1;
+	suite_ctest_info.module_heap_delta = child_report->heap_delta;
+	suite_ctest_info.module_perf       = child_report->perf;
+	suite_ctest_info.module_peak_rss   = (size_t) child_usage.ru_maxrss * 1024;
+
+	if(WIFEXITED(child_status) && WEXITSTATUS(child_status) == EXIT_SUCCESS) return;
+
+	if(WIFSIGNALED(child_status))
+		snprintf(details, sizeof details, "The module was terminated by signal %d (%s).", WTERMSIG(child_status), strsignal(WTERMSIG(child_status)));
+	else
+		snprintf(details, sizeof details, "The module exited with status %d before end_module().", WEXITSTATUS(child_status));
+	report_module_error(WIFSIGNALED(child_status) ? "MODULE CRASH" : "MODULE EXIT", details);
+}
+
+
+static void arm_crash_handlers()
+/**
+ * Description: This function installs crash_handler() for the crash signals.
  *
- * Time/Space Complexity: -
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
  */
 {
-	char *thick_line = "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~"; // Repeat '~' 80 times.
-	char *thin_line = "................................................................................"; // Repeat '.' 80 times.
-	int n;
+	struct sigaction action;
+	stack_t alternate_stack = {.ss_sp = crash_stack, .ss_size = sizeof crash_stack, .ss_flags = 0};
+	size_t i;
 
-	//Print the starting informations:
-	n = fprintf(stdout, "\n%s\n    SUMMARY OF THE MODULE: %-50s \n", thin_line, suite_ctest_info.module_name);
-	if (n < 0)
+	if(sigaltstack(&alternate_stack, NULL) < 0)
 	{
-		fprintf(stderr, "Error while printing the module summary.\n");
+		fprintf(stderr, "Error while setting the stack of the crash handler.\n");
 		exit(EXIT_FAILURE);
 	}
 
-	n = fprintf(stdout, "    -> TOTAL OF CASES: %-54d \n", ctest_info.num_of_results);
-	if (n < 0)
+	memset(&action, 0, sizeof action);
+	action.sa_handler = crash_handler;
+	action.sa_flags = SA_ONSTACK;
+	sigemptyset(&action.sa_mask);
+	for(i = 0; i < NUM_OF_CRASH_SIGNALS; i++)
 	{
-		fprintf(stderr, "Error while printing the module summary.\n");
-		exit(EXIT_FAILURE);
+		if(sigaction(crash_signals[i], &action, &previous_crash_actions[i]) < 0)
+		{
+			fprintf(stderr, "Error while installing the crash handler.\n");
+			exit(EXIT_FAILURE);
+		}
 	}
+	crash_handler_pid = getpid();
+	suite_ctest_info.is_crash_jump_set = true;
+}
 
-	n = fprintf(stdout, "    -> SUCCESSES:      %-54d \n", ctest_info.num_of_results - ctest_info.num_of_fails - ctest_info.num_of_ignored);
-	if (n < 0)
+
+static void disarm_crash_handlers()
+/**
+ * Description: This function restores the handlers replaced by 
+ * arm_crash_handlers().
+ */
+{
+	size_t i;
+
+	suite_ctest_info.is_crash_jump_set = false;
+	for(i = 0; i < NUM_OF_CRASH_SIGNALS; i++) sigaction(crash_signals[i], &previous_crash_actions[i], NULL);
+}
+
+
+static void crash_handler(int signal_number)
+/**
+ * Description: This function jumps back to CTEST_MODULE. Child processes (e.g. 
+ * the body of WITH_ASSERT_SIGNAL_EQUAL) inherit the handler, but the jump is 
+ * valid only in the process that armed it, so the default action is taken in
+ * the others.
+ */
+{
+	if(!suite_ctest_info.is_crash_jump_set || getpid() != crash_handler_pid)
 	{
-		fprintf(stderr, "Error while printing the module summary.\n");
-		exit(EXIT_FAILURE);
+		signal(signal_number, SIG_DFL);
+		raise(signal_number);
+		return;
 	}
+	suite_ctest_info.is_crash_jump_set = false;
+	suite_ctest_info.crash_signal = signal_number;
+	siglongjmp(suite_ctest_info.crash_jump_buffer, 1);
+}
 
-	n = fprintf(stdout, "    -> FAILS:          %-54d \n", ctest_info.num_of_fails);
-	if (n < 0)
+
+static double get_wall_time()
+/**
+ * Description: This function returns the time of CLOCK_MONOTONIC in seconds.
+ */
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+static double get_cpu_time()
+/**
+ * Description: This function returns the CPU time, in seconds, used by this 
+ * thread plus the CPU time used by the child processes that were waited for
+ * (checkpointed modules and WITH_ASSERT_EXIT_STATUS_* blocks).
+ */
+{
+	struct timespec time;
+	struct rusage children_usage;
+	double cpu_time;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+	cpu_time = time.tv_sec + time.tv_nsec * 1e-9;
+	if(getrusage(RUSAGE_CHILDREN, &children_usage) == 0)
 	{
-		fprintf(stderr, "Error while printing the module summary.\n");
-		exit(EXIT_FAILURE);
+		cpu_time += children_usage.ru_utime.tv_sec + children_usage.ru_utime.tv_usec * 1e-6;
+		cpu_time += children_usage.ru_stime.tv_sec + children_usage.ru_stime.tv_usec * 1e-6;
 	}
+	return cpu_time;
+}
 
-	n = fprintf(stdout, "    -> IGNORED:        %-54d \n%s\n\n", ctest_info.num_of_ignored, thick_line);
-	if (n < 0)
+
+static void measure_module_memory()
+/**
+ * Description: This function measures the heap delta, the peak RSS and the 
+ * counters of the current module, executed by this process.
+ */
+{
+	perf_group_stop(&suite_ctest_info.module_perf_group, &suite_ctest_info.module_perf);
+	suite_ctest_info.module_heap_delta = get_live_heap_bytes() - suite_ctest_info.module_start_heap;
+	suite_ctest_info.module_peak_rss   = get_peak_rss();
+}
+
+
+static void check_module_leak()
+/**
+ * Description: This function gives one fail to the current module if its live
+ * heap grew and the leaks must fail (see end_module()).
+ *
+ * Error handling: If the leaks must fail and the allocation hooks are not 
+ * active, this function prints an error message and exits a failure code.
+ */
+{
+	char details[128];
+
+	if(!is_fail_on_leak_set()) return;
+	if(!alloc_hooks_are_active())
 	{
-		fprintf(stderr, "Error while printing the module summary.\n");
+		fprintf(stderr, "CTEST_FAIL_ON_LEAK needs the allocation hooks. Link the test with %s.\n", CTEST_ALLOC_HOOKS_LINK_FLAGS);
 		exit(EXIT_FAILURE);
 	}
+	if(suite_ctest_info.module_heap_delta <= 0) return;
 
-	//Reset global variables related to the module:
-	ctest_info.num_of_results = suite_ctest_info.num_of_suite_results;
-	ctest_info.num_of_fails   = suite_ctest_info.num_of_suite_fails;
-	ctest_info.num_of_ignored = suite_ctest_info.num_of_suite_ignored;
-	ctest_info.progress[0]    = '\0';
-	strcat(ctest_info.progress, suite_ctest_info.suite_progress);
-	suite_ctest_info.module_name[0]  = '\0';
-	ctest_info.print_progress        = true;
+	snprintf(details, sizeof details, "The module leaked %lld bytes of heap.", suite_ctest_info.module_heap_delta);
+	report_module_error("HEAP LEAK", details);
+}
+
+
+static bool is_fail_on_leak_set()
+{
+	char *value = getenv("CTEST_FAIL_ON_LEAK");
+
+	return suite_ctest_info.fail_on_leak || (value != NULL && strcmp(value, "1") == 0);
+}
+
+
+static void reset_peak_rss()
+/**
+ * Description: This function resets the peak RSS of the process (VmHWM), so 
+ * get_peak_rss() returns the peak of the current module. If the kernel does not
+ * allow it (Linux < 4.0), the peak is the one of the whole process.
+ */
+{
+	int fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+
+	if(fd < 0) return;
+	if(write(fd, "5", 1) < 0) {} //The peak is not reset: nothing else to do.
+	close(fd);
+}
+
+
+static size_t get_peak_rss()
+/**
+ * Description: This function returns the peak RSS of the process in bytes, 
+ * read from VmHWM of /proc/self/status or, if it is not available, from 
+ * getrusage().
+ */
+{
+	char line[128];
+	unsigned long long peak_kb;
+	struct rusage usage;
+	FILE *status_file = fopen("/proc/self/status", "r");
+
+	if(status_file != NULL)
+	{
+		while(fgets(line, sizeof line, status_file) != NULL)
+		{
+			if(sscanf(line, "VmHWM: %llu kB", &peak_kb) == 1)
+			{
+				fclose(status_file);
+				return (size_t) peak_kb * 1024;
+			}
+		}
+		fclose(status_file);
+	}
+	if(getrusage(RUSAGE_SELF, &usage) == 0) return (size_t) usage.ru_maxrss * 1024;
+	return 0;
 }
 
+
+static void record_module_stats()
+/**
+ * Description: This function appends the stats of the current module to 
+ * 'suite_ctest_info.modules_stats'.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	ctest_module_stats *module_stats;
+	size_t new_capacity;
+
+	if(suite_ctest_info.num_of_modules == suite_ctest_info.modules_stats_capacity)
+	{
+		new_capacity = suite_ctest_info.modules_stats_capacity ? 2 * suite_ctest_info.modules_stats_capacity : 16;
+		module_stats = realloc(suite_ctest_info.modules_stats, new_capacity * sizeof *module_stats);
+		if(module_stats == NULL)
+		{
+			fprintf(stderr, "Error while allocating the stats of the modules.\n");
+			exit(EXIT_FAILURE);
+		}
+		suite_ctest_info.modules_stats = module_stats;
+		suite_ctest_info.modules_stats_capacity = new_capacity;
+	}
+
+	module_stats = &suite_ctest_info.modules_stats[suite_ctest_info.num_of_modules++];
+	snprintf(module_stats->module_name, MAX_NAME, "%s", suite_ctest_info.module_name);
+	module_stats->wall_time      = get_wall_time() - suite_ctest_info.module_start_wall_time;
+	module_stats->cpu_time       = get_cpu_time() - suite_ctest_info.module_start_cpu_time;
+	module_stats->heap_delta     = suite_ctest_info.module_heap_delta;
+	module_stats->peak_rss       = suite_ctest_info.module_peak_rss;
+	module_stats->perf           = suite_ctest_info.module_perf;
+	module_stats->num_of_results = ctest_info.num_of_results;
+	module_stats->num_of_fails   = ctest_info.num_of_fails;
+	module_stats->num_of_ignored = ctest_info.num_of_ignored;
+}
+
+
+static void report_module_error(char assert_name[], char details[])
+/**
+ * Description: This function counts an error of the module found by ctest (a
+ * crash, an exit before end_module() or a leak) as one fail and sends it to the
+ * reporters.
+ */
+{
+	assert_result_struct assert_result = {
+		false,                                                           //was_successful
+		ctest_info.last_line_number,                                     //line_number
+		get_result_details_buffer(),                                     //result_details[MAX_CHARS]
+		assert_name,                                                     //assert_name
+		"The module SHOULD END without errors.",                         //std_message
+		NULL                                                             //custom_message
+	};
+
+	snprintf(assert_result.result_details, MAX_CHARS, "%s", details);
+	merge_assert_results("F", 1);
+	reporters_assert(&assert_result, REPORT_ERROR);
+}
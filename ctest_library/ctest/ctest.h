@@ -3,5 +3,8 @@
 
 #include "ctest_functions.h"
 #include "assert.h"
+#include "bench.h"
+#include "alloc_hooks.h"
+#include "reporter.h"
 
 #endif
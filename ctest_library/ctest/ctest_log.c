@@ -0,0 +1,438 @@
+/**
+ * Title: CTEST LOG
+ */
+
+/**
+ * Description: This file contains the reader of the binary result log (see the
+ * format in ctest_log.h). The file is mapped in memory and the trailer gives the
+ * index of the modules and of the suites, so a query reads only the entries of
+ * the modules it needs: e.g. the fails of one module of a log with hundreds of
+ * millions of results. The strings returned point into the mapping and are
+ * valid until ctest_log_close().
+ */
+
+//Includes:
+#include "globals.h"
+#include "ctest_log.h"
+#include "reporter.h"
+#include "text_formatting.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Definition of types:
+struct ctest_log {
+	const unsigned char *data;
+	size_t size;
+	uint32_t num_of_entries;
+	uint32_t first_index_entry;
+	uint32_t num_of_index_entries;
+	uint32_t *modules;        //Index entries of the modules, in order.
+	size_t num_of_modules;
+};
+
+//Local auxiliary functions:
+static const unsigned char *get_entry(const ctest_log *log, uint32_t id);
+static const char *get_string(const ctest_log *log, uint32_t id);
+static uint32_t get_entry_span(const ctest_log *log, uint32_t id);
+static void read_end(const ctest_log *log, uint32_t end_entry, ctest_log_module *stats);
+static uint32_t get_u32(const unsigned char bytes[]);
+static uint64_t get_u64(const unsigned char bytes[]);
+static double get_f64(const unsigned char bytes[]);
+static void invalid_log(const char reason[]);
+
+
+//Function definitions:
+ctest_log *ctest_log_open(char path[])
+/**
+ * Description: This function maps the binary log 'path' in memory and checks
+ * its header and its trailer.
+ *
+ * Memory allocation: The user must call ctest_log_close after using the log.
+ *
+ * Input: (char []) path --> The path of the log.
+ *
+ * Output: (ctest_log *) --> The log.
+ *
+ * Error handling: If the file can not be read or is not a complete binary log
+ * (e.g. the run did not end), this function prints an error message and exits a
+ * failure code.
+ *
+ * Time Complexity: O(number of modules and suites)
+ *
+ * Space Complexity: O(number of modules)
+ */
+{
+	ctest_log *log = calloc(1, sizeof *log);
+	const unsigned char *entry;
+	struct stat file_stat;
+	void *data;
+	uint32_t i;
+	int fd;
+
+	if(log == NULL)
+	{
+		fprintf(stderr, "Error while allocating the binary log.\n");
+		exit(EXIT_FAILURE);
+	}
+	fd = open(path, O_RDONLY);
+	if(fd < 0 || fstat(fd, &file_stat) < 0)
+	{
+		fprintf(stderr, "Error while opening the binary log '%s'.\n", path);
+		exit(EXIT_FAILURE);
+	}
+	if(file_stat.st_size < 2 * LOG_ENTRY_SIZE || file_stat.st_size % LOG_ENTRY_SIZE != 0 || file_stat.st_size / LOG_ENTRY_SIZE > UINT32_MAX)
+		invalid_log("wrong size");
+	data = mmap(NULL, (size_t) file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(data == MAP_FAILED)
+	{
+		fprintf(stderr, "Error while mapping the binary log '%s'.\n", path);
+		exit(EXIT_FAILURE);
+	}
+	log->data           = data;
+	log->size           = (size_t) file_stat.st_size;
+	log->num_of_entries = (uint32_t) (log->size / LOG_ENTRY_SIZE);
+
+	//Header and trailer:
+	if(memcmp(log->data, LOG_MAGIC, 8) != 0) invalid_log("wrong header");
+	if(log->data[8] + 256 * log->data[9] != LOG_VERSION || log->data[10] + 256 * log->data[11] != LOG_ENTRY_SIZE) invalid_log("unsupported version");
+	entry = get_entry(log, log->num_of_entries - 1);
+	if(memcmp(entry, LOG_TRAILER_MAGIC, 8) != 0) invalid_log("no index (the run did not end)");
+	log->first_index_entry    = get_u32(entry + 8);
+	log->num_of_index_entries = get_u32(entry + 12);
+	if((uint64_t) log->first_index_entry + log->num_of_index_entries != log->num_of_entries - 1) invalid_log("wrong index");
+
+	//Modules:
+	log->modules = malloc((log->num_of_index_entries + 1) * sizeof *log->modules);
+	if(log->modules == NULL)
+	{
+		fprintf(stderr, "Error while allocating the binary log.\n");
+		exit(EXIT_FAILURE);
+	}
+	for(i = 0; i < log->num_of_index_entries; i++)
+	{
+		entry = get_entry(log, log->first_index_entry + i);
+		if(entry[0] != LOG_INDEX || get_u32(entry + 8) >= get_u32(entry + 12) || get_u32(entry + 12) + 3 > log->first_index_entry)
+			invalid_log("wrong index");
+		if(get_entry(log, get_u32(entry + 4))[0] == LOG_MODULE) log->modules[log->num_of_modules++] = log->first_index_entry + i;
+	}
+	return log;
+}
+
+
+void ctest_log_close(ctest_log *log)
+/**
+ * Description: This function unmaps the log and frees it.
+ *
+ * Input: (ctest_log *) log --> The log.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(log == NULL) return;
+	munmap((void *) log->data, log->size);
+	free(log->modules);
+	free(log);
+}
+
+
+size_t ctest_log_get_num_of_modules(const ctest_log *log)
+/**
+ * Description: This function returns the number of modules of the log.
+ *
+ * Input: (const ctest_log *) log --> The log.
+ *
+ * Output: (size_t) --> The number of modules.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return log->num_of_modules;
+}
+
+
+ctest_log_module ctest_log_get_module(const ctest_log *log, size_t index)
+/**
+ * Description: This function returns the names and the counters of the module
+ * 'index' (in the order in which the modules ended).
+ *
+ * Input: (const ctest_log *) log --> The log;
+ *        (size_t) index --> The index of the module (less than
+ *        ctest_log_get_num_of_modules()).
+ *
+ * Output: (ctest_log_module) --> The module.
+ *
+ * Error handling: If 'index' is not valid, this function prints an error message
+ * and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	ctest_log_module module;
+	const unsigned char *index_entry, *module_entry;
+
+	if(index >= log->num_of_modules)
+	{
+		fprintf(stderr, "Error: the binary log has no module %zu.\n", index);
+		exit(EXIT_FAILURE);
+	}
+	index_entry  = get_entry(log, log->modules[index]);
+	module_entry = get_entry(log, get_u32(index_entry + 4));
+	read_end(log, get_u32(index_entry + 12), &module);
+	module.module_name = get_string(log, get_u32(module_entry + 4));
+	module.suite_name  = get_string(log, get_u32(module_entry + 8) == 0 ? 0 : get_u32(get_entry(log, get_u32(module_entry + 8)) + 4));
+	return module;
+}
+
+
+size_t ctest_log_find_module(const ctest_log *log, const char module_name[])
+/**
+ * Description: This function returns the index of the first module named
+ * 'module_name'.
+ *
+ * Input: (const ctest_log *) log --> The log;
+ *        (const char []) module_name --> The name of the module.
+ *
+ * Output: (size_t) --> The index of the module or LOG_NOT_FOUND.
+ *
+ * Time Complexity: O(number of modules * length of the names)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	const unsigned char *module_entry;
+	const char *name;
+	size_t i;
+
+	for(i = 0; i < log->num_of_modules; i++)
+	{
+		module_entry = get_entry(log, get_u32(get_entry(log, log->modules[i]) + 4));
+		name = get_string(log, get_u32(module_entry + 4));
+		if(name != NULL && strcmp(name, module_name) == 0) return i;
+	}
+	return LOG_NOT_FOUND;
+}
+
+
+size_t ctest_log_for_each_result(const ctest_log *log, size_t index, char status, void (*callback)(const ctest_log_result *result, void *arg), void *arg)
+/**
+ * Description: This function calls 'callback' with each result of the module
+ * 'index' whose status is 'status' ('\0' for every result), in order. Only the
+ * entries of the module are read.
+ *
+ * Input: (const ctest_log *) log --> The log;
+ *        (size_t) index --> The index of the module;
+ *        (char) status --> '.', 'F', 'I', 'E' or '\0';
+ *        (void (*)(const ctest_log_result *, void *)) callback --> The function
+ *        called with each result (it may be NULL, to count the results);
+ *        (void *) arg --> The second argument of 'callback'.
+ *
+ * Output: (size_t) --> The number of results.
+ *
+ * Error handling: If 'index' is not valid, this function prints an error message
+ * and exits a failure code.
+ *
+ * Time Complexity: O(number of entries of the module)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	const unsigned char *index_entry, *entry, *failure;
+	uint32_t module_id, id, end_entry;
+	ctest_log_result result;
+	size_t num_of_results = 0;
+
+	if(index >= log->num_of_modules)
+	{
+		fprintf(stderr, "Error: the binary log has no module %zu.\n", index);
+		exit(EXIT_FAILURE);
+	}
+	index_entry = get_entry(log, log->modules[index]);
+	module_id   = get_u32(index_entry + 4);
+	end_entry   = get_u32(index_entry + 12);
+
+	for(id = get_u32(index_entry + 8); id < end_entry; id += get_entry_span(log, id))
+	{
+		entry = get_entry(log, id);
+		if(entry[0] != LOG_RESULT || get_u32(entry + 12) != module_id) continue;
+		if(status != '\0' && (char) entry[1] != status) continue;
+
+		num_of_results++;
+		if(callback == NULL) continue;
+		result.status         = (char) entry[1];
+		result.line_number    = (int) get_u32(entry + 4);
+		result.assert_name    = get_string(log, get_u32(entry + 8));
+		result.std_message    = NULL;
+		result.custom_message = NULL;
+		result.details        = NULL;
+		failure = id + 1 < end_entry ? get_entry(log, id + 1) : NULL;
+		if(failure != NULL && failure[0] == LOG_FAILURE)
+		{
+			result.std_message    = get_string(log, get_u32(failure + 4));
+			result.custom_message = get_string(log, get_u32(failure + 8));
+			result.details        = get_string(log, get_u32(failure + 12));
+		}
+		callback(&result, arg);
+	}
+	return num_of_results;
+}
+
+
+void ctest_log_print_summary(const ctest_log *log)
+/**
+ * Description: This function prints the summary of the log like the console:
+ * a line with the counters of each module and the summary of each suite.
+ *
+ * Input: (const ctest_log *) log --> The log.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(number of modules and suites)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	const unsigned char *index_entry, *object_entry;
+	ctest_reporter *console = reporter_console();
+	ctest_log_module stats;
+	ctest_suite_stats suite_stats;
+	char time_str[32];
+	uint32_t i;
+
+	for(i = 0; i < log->num_of_index_entries; i++)
+	{
+		index_entry  = get_entry(log, log->first_index_entry + i);
+		object_entry = get_entry(log, get_u32(index_entry + 4));
+		read_end(log, get_u32(index_entry + 12), &stats);
+		if(object_entry[0] == LOG_MODULE)
+		{
+			fprintf(stdout, "    MODULE: %-32s cases: %-8d fails: %-8d ignored: %-8d wall: %s\n", get_string(log, get_u32(object_entry + 4)),
+					stats.num_of_results, stats.num_of_fails, stats.num_of_ignored, TF_time_to_str(stats.wall_time, time_str, sizeof time_str));
+			continue;
+		}
+		snprintf(suite_stats.suite_name, MAX_NAME, "%s", get_string(log, get_u32(object_entry + 4)));
+		suite_stats.num_of_results = stats.num_of_results;
+		suite_stats.num_of_fails   = stats.num_of_fails;
+		suite_stats.num_of_ignored = stats.num_of_ignored;
+		suite_stats.wall_time      = stats.wall_time;
+		suite_stats.cpu_time       = stats.cpu_time;
+		console->on_suite_end(console, &suite_stats);
+	}
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static const unsigned char *get_entry(const ctest_log *log, uint32_t id)
+/**
+ * Description: This function returns the entry 'id'. The log is invalid if it
+ * does not exist.
+ */
+{
+	if(id >= log->num_of_entries) invalid_log("an id is out of the file");
+	return log->data + (size_t) id * LOG_ENTRY_SIZE;
+}
+
+
+static const char *get_string(const ctest_log *log, uint32_t id)
+/**
+ * Description: This function returns the string 'id' (NULL if 'id' is 0).
+ */
+{
+	const unsigned char *entry;
+	uint32_t length;
+
+	if(id == 0) return NULL;
+	entry  = get_entry(log, id);
+	length = get_u32(entry + 4);
+	if(entry[0] != LOG_STRING || (uint64_t) id + 1 + length / LOG_ENTRY_SIZE >= log->num_of_entries || entry[LOG_ENTRY_SIZE + length] != '\0')
+		invalid_log("wrong string");
+	return (const char *) entry + LOG_ENTRY_SIZE;
+}
+
+
+static uint32_t get_entry_span(const ctest_log *log, uint32_t id)
+/**
+ * Description: This function returns the number of entries of the object that
+ * starts at the entry 'id' (e.g. a string and its chars).
+ */
+{
+	const unsigned char *entry = get_entry(log, id);
+
+	switch(entry[0])
+	{
+		case LOG_STRING:     return 1 + get_u32(entry + 4) / LOG_ENTRY_SIZE + 1;
+		case LOG_MODULE_END:
+		case LOG_SUITE_END:  return 3;
+		default:             return 1;
+	}
+}
+
+
+static void read_end(const ctest_log *log, uint32_t end_entry, ctest_log_module *stats)
+/**
+ * Description: This function reads the counters of the end of a module or of a
+ * suite (the names are not set).
+ */
+{
+	const unsigned char *entry = get_entry(log, end_entry);
+
+	if((entry[0] != LOG_MODULE_END && entry[0] != LOG_SUITE_END) || end_entry + 2 >= log->num_of_entries) invalid_log("wrong end");
+	stats->module_name    = NULL;
+	stats->suite_name     = NULL;
+	stats->num_of_results = (int) get_u32(entry + 8);
+	stats->num_of_fails   = (int) get_u32(entry + 12);
+	stats->num_of_ignored = (int) get_u32(entry + LOG_ENTRY_SIZE);
+	stats->wall_time      = get_f64(entry + LOG_ENTRY_SIZE + 8);
+	stats->cpu_time       = get_f64(entry + 2 * LOG_ENTRY_SIZE);
+	stats->peak_rss       = (size_t) get_u64(entry + 2 * LOG_ENTRY_SIZE + 8);
+}
+
+
+static uint32_t get_u32(const unsigned char bytes[])
+{
+	return (uint32_t) bytes[0] | (uint32_t) bytes[1] << 8 | (uint32_t) bytes[2] << 16 | (uint32_t) bytes[3] << 24;
+}
+
+
+static uint64_t get_u64(const unsigned char bytes[])
+{
+	return (uint64_t) get_u32(bytes) | (uint64_t) get_u32(bytes + 4) << 32;
+}
+
+
+static double get_f64(const unsigned char bytes[])
+{
+	uint64_t bits = get_u64(bytes);
+	double value;
+
+	memcpy(&value, &bits, sizeof value);
+	return value;
+}
+
+
+static void invalid_log(const char reason[])
+/**
+ * Description: This function prints that the binary log is invalid and exits a
+ * failure code.
+ */
+{
+	fprintf(stderr, "Error: invalid binary log (%s).\n", reason);
+	exit(EXIT_FAILURE);
+}
@@ -0,0 +1,452 @@
+/**
+ * Title: CTEST TRACE
+ */
+
+/**
+ * Description: This file contains the trace of the execution in the Chrome
+ * trace-event format (JSON array), which is opened by Perfetto or by
+ * chrome://tracing. It is enabled by the environment variable CTEST_TRACE,
+ * whose value is the path of the file, e.g. CTEST_TRACE=out.json. The suites,
+ * modules, summaries of the modules and benchmarks are complete events ("X")
+ * and the failed assertions are instant events ("i").
+ *     Each thread records its events into its own ring buffer, without locks
+ * (the thread is the only producer). The buffers are written to the file by
+ * end_suite() and at exit, or by their thread when they are full. The file is
+ * opened with O_APPEND, so the child processes of the checkpointed modules write
+ * their own events (with their own pid) to the same file; the events buffered
+ * by the parent are dropped in the child by trace_after_fork(). The closing
+ * bracket of the array is written at exit by the process that opened the file.
+ */
+
+//Includes:
+#define _GNU_SOURCE
+#include "ctest_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Local macros:
+#define TRACE_CHUNK_SIZE 16384   //Bytes written to the file per write().
+#define TRACE_MAX_EVENT_SIZE 512 //Bytes of one formatted event (the name is escaped).
+
+//Definition of types:
+typedef struct {
+	char name[MAX_TRACE_NAME];
+	const char *category;       //String literal.
+	char phase;                 //'X' (complete) or 'i' (instant).
+	double start_time;          //Seconds (CLOCK_MONOTONIC).
+	double duration;            //Seconds (complete events).
+	int line_number;            //Line of the failed assertion (instant events).
+} trace_event;
+
+typedef struct trace_buffer {
+	trace_event events[TRACE_BUFFER_SIZE];
+	uint64_t head;              //Next event written by the thread.
+	uint64_t tail;              //Next event written to the file.
+	pid_t tid;
+	struct trace_buffer *next;  //Next buffer of the list of buffers.
+} trace_buffer;
+
+//Local variables:
+static int trace_fd = -1;
+static pid_t trace_owner_pid = -1;   //Process that opened the file (it closes the array).
+static pid_t trace_pid = -1;         //This process.
+static trace_buffer *buffers = NULL; //Buffers of every thread that recorded an event.
+static _Thread_local trace_buffer *thread_buffer = NULL;
+static bool flush_lock = false;
+
+//Local auxiliary functions:
+static trace_buffer *get_thread_buffer();
+static trace_event *push_event(trace_buffer *buffer);
+static void commit_event(trace_buffer *buffer);
+static void flush_buffer(trace_buffer *buffer);
+static size_t format_event(trace_event *event, pid_t tid, char str[], size_t size);
+static size_t escape_json(const char src[], char dst[], size_t size);
+static void write_process_name(char process_name[]);
+static void write_all(const char str[], size_t size);
+static void lock_flush();
+static void unlock_flush();
+static double get_time();
+static pid_t get_tid();
+static void close_trace();
+
+
+//Function definitions:
+void trace_open(char process_name[])
+/**
+ * Description: This function opens the trace file if the environment variable
+ * CTEST_TRACE is set and the file is not open yet. It is called by start_suite().
+ *
+ * Input: (char []) process_name --> The name of the process in the trace.
+ *
+ * Output: (void)
+ *
+ * Error handling: If the file can not be opened, this function prints an error
+ * message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	char *path = getenv("CTEST_TRACE");
+
+	if(trace_fd >= 0 || path == NULL || path[0] == '\0') return;
+
+	trace_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+	if(trace_fd < 0)
+	{
+		fprintf(stderr, "Error while opening the trace file '%s': %s.\n", path, strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+	trace_owner_pid = trace_pid = getpid();
+	write_all("[\n", 2);
+	write_process_name(process_name);
+	atexit(close_trace);
+}
+
+
+bool trace_is_enabled()
+/**
+ * Description: This function says if the events are being recorded.
+ *
+ * Input: (void)
+ *
+ * Output: (bool) --> true if the trace file is open.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return trace_fd >= 0;
+}
+
+
+void trace_complete_event(const char category[], const char name[], double start_time, double end_time)
+/**
+ * Description: This function records an event with a duration (e.g. a module).
+ * It does nothing if the trace is not enabled.
+ *
+ * Input: (const char []) category --> The category (a string literal, e.g. "module").
+ *        (const char []) name --> The name (truncated to MAX_TRACE_NAME - 1 chars).
+ *        (double) start_time, end_time --> The interval in seconds of CLOCK_MONOTONIC.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1), except when the buffer of the thread is full: O(TRACE_BUFFER_SIZE).
+ *
+ * Space Complexity: O(1)
+ */
+{
+	trace_buffer *buffer;
+	trace_event *event;
+
+	if(trace_fd < 0) return;
+	buffer = get_thread_buffer();
+	event = push_event(buffer);
+	snprintf(event->name, MAX_TRACE_NAME, "%s", name);
+	event->category    = category;
+	event->phase       = 'X';
+	event->start_time  = start_time;
+	event->duration    = end_time > start_time ? end_time - start_time : 0;
+	event->line_number = 0;
+	commit_event(buffer);
+}
+
+
+void trace_instant_event(const char category[], const char name[], int line_number)
+/**
+ * Description: This function records an event without duration at the current
+ * time (e.g. a failed assertion). It does nothing if the trace is not enabled.
+ *
+ * Input: (const char []) category --> The category (a string literal, e.g. "failure").
+ *        (const char []) name --> The name (truncated to MAX_TRACE_NAME - 1 chars).
+ *        (int) line_number --> The line in the source code (0 if none).
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1), except when the buffer of the thread is full: O(TRACE_BUFFER_SIZE).
+ *
+ * Space Complexity: O(1)
+ */
+{
+	trace_buffer *buffer;
+	trace_event *event;
+
+	if(trace_fd < 0) return;
+	buffer = get_thread_buffer();
+	event = push_event(buffer);
+	snprintf(event->name, MAX_TRACE_NAME, "%s", name);
+	event->category    = category;
+	event->phase       = 'i';
+	event->start_time  = get_time();
+	event->duration    = 0;
+	event->line_number = line_number;
+	commit_event(buffer);
+}
+
+
+void trace_flush()
+/**
+ * Description: This function writes the buffered events of every thread to the
+ * trace file. It is called by end_suite() and by the child of a checkpointed
+ * module before it exits.
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(number of buffered events)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	trace_buffer *buffer;
+
+	if(trace_fd < 0) return;
+	lock_flush();
+	for(buffer = __atomic_load_n(&buffers, __ATOMIC_ACQUIRE); buffer != NULL; buffer = buffer->next) flush_buffer(buffer);
+	unlock_flush();
+}
+
+
+void trace_after_fork(char process_name[])
+/**
+ * Description: This function must be called by a child process that records
+ * events (the child of a checkpointed module). It drops the events buffered by
+ * the parent, which would be written twice otherwise, and names the process.
+ *
+ * Input: (char []) process_name --> The name of the child in the trace.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(number of threads that recorded events)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	trace_buffer *buffer;
+
+	if(trace_fd < 0) return;
+	trace_pid = getpid();
+	flush_lock = false; //The lock may have been held by another thread of the parent.
+	for(buffer = buffers; buffer != NULL; buffer = buffer->next) buffer->tail = buffer->head;
+	if(thread_buffer != NULL) thread_buffer->tid = get_tid();
+	write_process_name(process_name);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static trace_buffer *get_thread_buffer()
+/**
+ * Description: This function returns the buffer of the calling thread. It is
+ * allocated and added to the list of buffers on the first event of the thread.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	trace_buffer *buffer = thread_buffer;
+
+	if(buffer != NULL) return buffer;
+
+	buffer = malloc(sizeof *buffer);
+	if(buffer == NULL)
+	{
+		fprintf(stderr, "Error while allocating the trace buffer.\n");
+		exit(EXIT_FAILURE);
+	}
+	buffer->head = buffer->tail = 0;
+	buffer->tid  = get_tid();
+	buffer->next = __atomic_load_n(&buffers, __ATOMIC_RELAXED);
+	while(!__atomic_compare_exchange_n(&buffers, &buffer->next, buffer, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	thread_buffer = buffer;
+	return buffer;
+}
+
+
+static trace_event *push_event(trace_buffer *buffer)
+/**
+ * Description: This function returns the slot of the next event of 'buffer'.
+ * If the buffer is full, it is written to the file first.
+ */
+{
+	if(buffer->head - __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE) >= TRACE_BUFFER_SIZE)
+	{
+		lock_flush();
+		flush_buffer(buffer);
+		unlock_flush();
+	}
+	return &buffer->events[buffer->head % TRACE_BUFFER_SIZE];
+}
+
+
+static void commit_event(trace_buffer *buffer)
+/**
+ * Description: This function publishes the event returned by push_event().
+ */
+{
+	__atomic_store_n(&buffer->head, buffer->head + 1, __ATOMIC_RELEASE);
+}
+
+
+static void flush_buffer(trace_buffer *buffer)
+/**
+ * Description: This function writes the published events of 'buffer' to the
+ * file. The flush lock must be held.
+ */
+{
+	char chunk[TRACE_CHUNK_SIZE];
+	size_t length = 0;
+	uint64_t tail = buffer->tail, head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+
+	for(; tail < head; tail++)
+	{
+		length += format_event(&buffer->events[tail % TRACE_BUFFER_SIZE], buffer->tid, chunk + length, sizeof chunk - length);
+		if(sizeof chunk - length < TRACE_MAX_EVENT_SIZE)
+		{
+			write_all(chunk, length);
+			length = 0;
+		}
+	}
+	write_all(chunk, length);
+	__atomic_store_n(&buffer->tail, tail, __ATOMIC_RELEASE);
+}
+
+
+static size_t format_event(trace_event *event, pid_t tid, char str[], size_t size)
+/**
+ * Description: This function writes 'event' in 'str' as one element of the JSON
+ * array (preceded by a comma) and returns its length. The times are written in
+ * microseconds.
+ */
+{
+	char name[6 * MAX_TRACE_NAME];
+	int n;
+
+	escape_json(event->name, name, sizeof name);
+	if(event->phase == 'X')
+		n = snprintf(str, size, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+				name, event->category, event->start_time * 1e6, event->duration * 1e6, (int) trace_pid, (int) tid);
+	else
+		n = snprintf(str, size, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d,\"args\":{\"line\":%d}}",
+				name, event->category, event->start_time * 1e6, (int) trace_pid, (int) tid, event->line_number);
+	if(n < 0) return 0;
+	return (size_t) n < size ? (size_t) n : size - 1;
+}
+
+
+static size_t escape_json(const char src[], char dst[], size_t size)
+/**
+ * Description: This function copies 'src' to 'dst' as the content of a JSON
+ * string ('"', '\' and the control chars are escaped) and returns its length.
+ */
+{
+	size_t length = 0;
+	unsigned char c;
+
+	for(; *src != '\0' && length + 7 < size; src++)
+	{
+		c = (unsigned char) *src;
+		if(c == '"' || c == '\\') length += snprintf(dst + length, size - length, "\\%c", c);
+		else if(c < 0x20) length += snprintf(dst + length, size - length, "\\u%04x", c);
+		else dst[length++] = c;
+	}
+	dst[length] = '\0';
+	return length;
+}
+
+
+static void write_process_name(char process_name[])
+/**
+ * Description: This function writes the metadata event that names this process.
+ */
+{
+	char str[TRACE_MAX_EVENT_SIZE], name[6 * MAX_TRACE_NAME];
+	int n;
+
+	escape_json(process_name, name, sizeof name);
+	n = snprintf(str, sizeof str, "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+			trace_pid == trace_owner_pid ? "" : ",\n", (int) trace_pid, (int) get_tid(), name);
+	if(n > 0) write_all(str, (size_t) n < sizeof str ? (size_t) n : sizeof str - 1);
+}
+
+
+static void write_all(const char str[], size_t size)
+/**
+ * Description: This function writes 'size' bytes of 'str' to the trace file.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	ssize_t n;
+
+	while(size > 0)
+	{
+		n = write(trace_fd, str, size);
+		if(n < 0)
+		{
+			if(errno == EINTR) continue;
+			fprintf(stderr, "Error while writing the trace file: %s.\n", strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+		str  += n;
+		size -= n;
+	}
+}
+
+
+static void lock_flush()
+{
+	while(__atomic_test_and_set(&flush_lock, __ATOMIC_ACQUIRE)) sched_yield();
+}
+
+
+static void unlock_flush()
+{
+	__atomic_clear(&flush_lock, __ATOMIC_RELEASE);
+}
+
+
+static double get_time()
+/**
+ * Description: This function returns the time of CLOCK_MONOTONIC in seconds.
+ */
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+static pid_t get_tid()
+{
+	return (pid_t) syscall(SYS_gettid);
+}
+
+
+static void close_trace()
+/**
+ * Description: This function writes the pending events and closes the JSON
+ * array. It is registered with atexit() and does nothing in the child processes.
+ */
+{
+	if(trace_fd < 0 || getpid() != trace_owner_pid) return;
+	trace_flush();
+	write_all("\n]\n", 3);
+	close(trace_fd);
+	trace_fd = -1;
+}
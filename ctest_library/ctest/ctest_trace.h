@@ -0,0 +1,18 @@
+#ifndef _CTEST_CTEST_TRACE_H
+#define _CTEST_CTEST_TRACE_H
+
+//Includes:
+#include <stdbool.h>
+
+//Macros:
+#define MAX_TRACE_NAME 64        //Maximum number of chars per event name.
+#define TRACE_BUFFER_SIZE 1024   //Events per thread buffered before a flush.
+
+//Declaration of functions:
+void trace_open(char process_name[]);
+bool trace_is_enabled();
+void trace_complete_event(const char category[], const char name[], double start_time, double end_time);
+void trace_instant_event(const char category[], const char name[], int line_number);
+void trace_flush();
+void trace_after_fork(char process_name[]);
+#endif
@@ -0,0 +1,535 @@
+/**
+ * Title: REPORTER
+ */
+
+/**
+ * Description: This file contains the list of reporters that receive the events
+ * of the execution (see reporter.h). The console reporter (see
+ * reporter_console.c) is registered by default. The first start_suite() also
+ * reads the environment variables:
+ * 	CTEST_CONSOLE=0: the console reporter is removed;
+ * 	CTEST_JUNIT=path: a JUnit XML reporter is added (see reporter_junit.c);
+ * 	CTEST_TAP=path: a TAP 13 reporter is added (see reporter_tap.c);
+ * 	CTEST_JSONL=path: a JSON Lines reporter is added (see reporter_jsonl.c);
+ * 	CTEST_BINLOG=path: a binary log reporter is added (see reporter_binlog.c).
+ * The path "-" is the standard output (except for CTEST_BINLOG). The reporters
+ * created from the environment are deleted at exit by the process that created
+ * them.
+ */
+
+//Includes:
+#include "reporter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Local variables:
+static ctest_reporter *reporters[MAX_REPORTERS];
+static size_t num_of_reporters = 0;
+static bool was_console_added = false;  //The console is added before the first event.
+static bool were_env_reporters_opened = false;
+static ctest_reporter *env_reporters[4];
+static size_t num_of_env_reporters = 0;
+static pid_t env_reporters_pid = -1;
+static bool is_forked_child = false;      //Set in the child processes (see reporter_flush_in_child()).
+static bool was_atfork_registered = false;
+
+//Local auxiliary functions:
+static void add_default_console();
+static void add_env_reporter(char variable[], ctest_reporter *(*create)(char path[]));
+static void delete_env_reporters();
+static void set_forked_child();
+
+
+//Function definitions:
+void reporter_add(ctest_reporter *reporter)
+/**
+ * Description: This function registers 'reporter'. It receives every event
+ * after the registered ones. A reporter registered twice receives the events
+ * once.
+ *
+ * Input: (ctest_reporter *) reporter --> The reporter.
+ *
+ * Output: (void)
+ *
+ * Error handling: If there are MAX_REPORTERS reporters, this function prints an
+ * error message and exits a failure code.
+ *
+ * Time Complexity: O(MAX_REPORTERS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++) if(reporters[i] == reporter) return;
+	if(num_of_reporters == MAX_REPORTERS)
+	{
+		fprintf(stderr, "Error: more than %d reporters.\n", MAX_REPORTERS);
+		exit(EXIT_FAILURE);
+	}
+	reporters[num_of_reporters++] = reporter;
+}
+
+
+void reporter_remove(ctest_reporter *reporter)
+/**
+ * Description: This function unregisters 'reporter' (e.g. the console reporter:
+ * reporter_remove(reporter_console())). It is not deleted.
+ *
+ * Input: (ctest_reporter *) reporter --> The reporter.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(MAX_REPORTERS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters && reporters[i] != reporter; i++);
+	if(i == num_of_reporters) return;
+	for(num_of_reporters--; i < num_of_reporters; i++) reporters[i] = reporters[i + 1];
+}
+
+
+void reporter_delete(ctest_reporter *reporter)
+/**
+ * Description: This function unregisters 'reporter', calls its on_delete hook
+ * (e.g. a file reporter writes its end and closes the file) and frees it. It
+ * must be used only with the reporters created by reporter_*_create().
+ *
+ * Input: (ctest_reporter *) reporter --> The reporter.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(MAX_REPORTERS)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(reporter == NULL) return;
+	reporter_remove(reporter);
+	if(reporter->on_delete != NULL) reporter->on_delete(reporter);
+	free(reporter);
+}
+
+
+void reporters_open_from_env()
+/**
+ * Description: This function applies the environment variables described in
+ * this file. It is called by start_suite() and does something only once per
+ * process.
+ *
+ * Input: (void)
+ *
+ * Output: (void)
+ *
+ * Error handling: If a file can not be opened, this function prints an error
+ * message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	char *console = getenv("CTEST_CONSOLE");
+
+	if(were_env_reporters_opened) return;
+	were_env_reporters_opened = true;
+
+	add_default_console();
+	if(console != NULL && strcmp(console, "0") == 0) reporter_remove(reporter_console());
+	add_env_reporter("CTEST_JUNIT", reporter_junit_create);
+	add_env_reporter("CTEST_TAP", reporter_tap_create);
+	add_env_reporter("CTEST_JSONL", reporter_jsonl_create);
+	add_env_reporter("CTEST_BINLOG", reporter_binlog_create);
+	if(num_of_env_reporters > 0)
+	{
+		env_reporters_pid = getpid();
+		atexit(delete_env_reporters);
+	}
+}
+
+
+FILE *reporter_open_file(char path[])
+/**
+ * Description: This function opens the output of a file reporter. The path "-"
+ * is the standard output.
+ *
+ * Input: (char []) path --> The path of the file.
+ *
+ * Output: (FILE *) --> The stream.
+ *
+ * Error handling: If the file can not be opened, this function prints an error
+ * message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	FILE *file;
+
+	if(!was_atfork_registered)
+	{
+		was_atfork_registered = true;
+		pthread_atfork(NULL, NULL, set_forked_child);
+	}
+	if(strcmp(path, "-") == 0) return stdout;
+	file = fopen(path, "w");
+	if(file == NULL)
+	{
+		fprintf(stderr, "Error while opening the report file '%s'.\n", path);
+		exit(EXIT_FAILURE);
+	}
+	return file;
+}
+
+
+void reporter_close_file(FILE *file)
+/**
+ * Description: This function closes a stream opened by reporter_open_file().
+ * The standard output is only flushed.
+ *
+ * Input: (FILE *) file --> The stream.
+ *
+ * Output: (void)
+ *
+ * Error handling: If a write to the stream failed, this function prints an
+ * error message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	bool has_failed = ferror(file) != 0;
+
+	if(file == stdout) has_failed = fflush(stdout) == EOF || has_failed;
+	else has_failed = fclose(file) == EOF || has_failed;
+	if(has_failed)
+	{
+		fprintf(stderr, "Error while writing a report file.\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+
+void *reporter_alloc_shared(size_t size)
+/**
+ * Description: This function allocates the state of a file reporter in memory
+ * shared with the child processes (e.g. of a module after
+ * CTEST_FIXTURE_CHECKPOINT or of a WITH_SIGNAL block), so the counters updated
+ * by the results of a child are seen by the parent. The memory is zeroed.
+ *
+ * Memory allocation: The memory must be released by reporter_free_shared().
+ *
+ * Input: (size_t) size --> The number of bytes.
+ *
+ * Output: (void *) --> The memory.
+ *
+ * Error handling: If the memory can not be mapped, this function prints an error
+ * message and exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(size)
+ */
+{
+	void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	if(data == MAP_FAILED)
+	{
+		fprintf(stderr, "Error while allocating the state of a reporter.\n");
+		exit(EXIT_FAILURE);
+	}
+	return data;
+}
+
+
+void reporter_free_shared(void *data, size_t size)
+/**
+ * Description: This function releases the memory of reporter_alloc_shared().
+ *
+ * Input: (void *) data --> The memory;
+ *        (size_t) size --> The number of bytes given to reporter_alloc_shared().
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	munmap(data, size);
+}
+
+
+void reporter_flush_in_child(FILE *file)
+/**
+ * Description: This function flushes 'file' if this process is a child (e.g. of
+ * a module after CTEST_FIXTURE_CHECKPOINT or of a WITH_SIGNAL block). A child may
+ * be killed before it flushes its buffers, so a file reporter calls this
+ * function after each event. In the parent process it does nothing.
+ *
+ * Input: (FILE *) file --> The stream.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(1), plus the flush.
+ *
+ * Space Complexity: O(1)
+ */
+{
+	if(is_forked_child) fflush(file);
+}
+
+
+void reporter_write_json_string(FILE *file, const char str[])
+/**
+ * Description: This function writes 'str' to 'file' as a JSON string, with the
+ * quotes. '"', '\' and the control chars are escaped. NULL is written as null.
+ *
+ * Input: (FILE *) file --> The stream.
+ *        (const char []) str --> The string.
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(length of str)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	unsigned char c;
+
+	if(str == NULL)
+	{
+		fputs("null", file);
+		return;
+	}
+	putc('"', file);
+	for(; *str != '\0'; str++)
+	{
+		c = (unsigned char) *str;
+		if(c == '"' || c == '\\') fprintf(file, "\\%c", c);
+		else if(c == '\n') fputs("\\n", file);
+		else if(c == '\t') fputs("\\t", file);
+		else if(c < 0x20) fprintf(file, "\\u%04x", c);
+		else putc(c, file);
+	}
+	putc('"', file);
+}
+
+
+void reporter_write_xml_string(FILE *file, const char str[])
+/**
+ * Description: This function writes 'str' to 'file' as XML text or as the value
+ * of an attribute: '&', '<', '>', '"' and '\'' are escaped and the control chars
+ * that XML 1.0 does not allow are replaced by '?'.
+ *
+ * Input: (FILE *) file --> The stream.
+ *        (const char []) str --> The string (NULL is written as nothing).
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(length of str)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	unsigned char c;
+
+	if(str == NULL) return;
+	for(; *str != '\0'; str++)
+	{
+		c = (unsigned char) *str;
+		switch(c)
+		{
+			case '&':  fputs("&amp;", file);  break;
+			case '<':  fputs("&lt;", file);   break;
+			case '>':  fputs("&gt;", file);   break;
+			case '"':  fputs("&quot;", file); break;
+			case '\'': fputs("&apos;", file); break;
+			default:
+				putc(c < 0x20 && c != '\n' && c != '\t' && c != '\r' ? '?' : c, file);
+		}
+	}
+}
+
+
+void reporters_suite_start(const char name[], const char description[], char *func_ids[])
+/**
+ * Description: These functions send an event to every registered reporter, in
+ * the order of registration. They are called by ctest (start_suite(),
+ * start_module(), print_assert_result(), report_suppressed_failures(),
+ * assert_stats_end_suite(), the benchmarks, the noise control mode, end_module()
+ * and end_suite()).
+ *
+ * Input: The arguments of the hook (see ctest_reporter).
+ *
+ * Output: (void)
+ *
+ * Time Complexity: O(num_of_reporters), plus the hooks.
+ *
+ * Space Complexity: O(1)
+ */
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_suite_start != NULL) reporters[i]->on_suite_start(reporters[i], name, description, func_ids);
+}
+
+
+void reporters_module_start(const char name[], const char description[], char *func_ids[])
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_module_start != NULL) reporters[i]->on_module_start(reporters[i], name, description, func_ids);
+}
+
+
+void reporters_assert(const assert_result_struct *result, char status)
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_assert != NULL) reporters[i]->on_assert(reporters[i], result, status);
+}
+
+
+void reporters_failures_suppressed(const char assert_name[], int line_number, int num_of_suppressed)
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_failures_suppressed != NULL) reporters[i]->on_failures_suppressed(reporters[i], assert_name, line_number, num_of_suppressed);
+}
+
+
+void reporters_assert_stats(const assert_site_stats sites[], size_t num_of_sites)
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_assert_stats != NULL) reporters[i]->on_assert_stats(reporters[i], sites, num_of_sites);
+}
+
+
+void reporters_bench(const ctest_bench_stats *stats, const bench_baseline_result_struct *baseline)
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_bench != NULL) reporters[i]->on_bench(reporters[i], stats, baseline);
+}
+
+
+void reporters_bench_comparison(const ctest_bench_comparison *comparison)
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_bench_comparison != NULL) reporters[i]->on_bench_comparison(reporters[i], comparison);
+}
+
+
+void reporters_warning(const char source[], const char message[])
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_warning != NULL) reporters[i]->on_warning(reporters[i], source, message);
+}
+
+
+void reporters_module_end(const ctest_module_stats *stats)
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_module_end != NULL) reporters[i]->on_module_end(reporters[i], stats);
+}
+
+
+void reporters_suite_end(const ctest_suite_stats *stats)
+{
+	size_t i;
+
+	add_default_console();
+	for(i = 0; i < num_of_reporters; i++)
+		if(reporters[i]->on_suite_end != NULL) reporters[i]->on_suite_end(reporters[i], stats);
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void add_default_console()
+/**
+ * Description: This function registers the console reporter before the first
+ * change of the list, so it is the default and it may be removed.
+ */
+{
+	if(was_console_added) return;
+	was_console_added = true;
+	reporters[num_of_reporters++] = reporter_console();
+}
+
+
+static void add_env_reporter(char variable[], ctest_reporter *(*create)(char path[]))
+/**
+ * Description: This function creates and registers a reporter if the
+ * environment variable 'variable' has a path.
+ */
+{
+	char *path = getenv(variable);
+	ctest_reporter *reporter;
+
+	if(path == NULL || path[0] == '\0') return;
+	reporter = create(path);
+	reporter_add(reporter);
+	env_reporters[num_of_env_reporters++] = reporter;
+}
+
+
+static void delete_env_reporters()
+/**
+ * Description: This function deletes the reporters created from the environment.
+ * It is registered with atexit() and does nothing in the child processes.
+ */
+{
+	size_t i;
+
+	if(getpid() != env_reporters_pid) return;
+	for(i = 0; i < num_of_env_reporters; i++) reporter_delete(env_reporters[i]);
+	num_of_env_reporters = 0;
+}
+
+
+static void set_forked_child()
+/**
+ * Description: This function is registered with pthread_atfork() and marks the
+ * child processes.
+ */
+{
+	is_forked_child = true;
+}
@@ -0,0 +1,85 @@
+#ifndef _CTEST_REPORTER_H
+#define _CTEST_REPORTER_H
+
+//Includes:
+#include <stdio.h>
+#include <stdbool.h>
+#include "globals.h"
+#include "assert.h"
+#include "ctest_functions.h"
+
+//Macros:
+#define MAX_REPORTERS 8   //Maximum number of reporters registered at once.
+
+/**
+ * Description: The status of a result given to on_assert: '.' (success), 'F'
+ * (fail), 'I' (ignored) or 'E' (error of the module found by ctest: crash, exit
+ * before end_module() or leak). An error is counted as a fail; its description
+ * is in 'result_details'.
+ */
+#define REPORT_SUCCESS '.'
+#define REPORT_FAIL 'F'
+#define REPORT_IGNORED 'I'
+#define REPORT_ERROR 'E'
+
+//Definition of types:
+typedef struct {
+	char suite_name[MAX_NAME];
+	int num_of_results;
+	int num_of_fails;
+	int num_of_ignored;
+	double wall_time;   //Seconds between start_suite() and end_suite() (CLOCK_MONOTONIC).
+	double cpu_time;    //Seconds of CPU used by the suite, including its child processes.
+} ctest_suite_stats;
+
+/**
+ * Description: A reporter receives the events of the execution. Each hook may
+ * be NULL. The results of the modules executed by child processes (see
+ * CTEST_FIXTURE_CHECKPOINT) are reported by the child, so a reporter that writes
+ * to a FILE must not keep pending state outside the FILE (the buffers are
+ * flushed before each fork and at the exit of the child).
+ */
+typedef struct ctest_reporter ctest_reporter;
+struct ctest_reporter {
+	void (*on_suite_start)(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+	void (*on_module_start)(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+	void (*on_assert)(ctest_reporter *reporter, const assert_result_struct *result, char status);
+	void (*on_module_end)(ctest_reporter *reporter, const ctest_module_stats *stats);
+	void (*on_suite_end)(ctest_reporter *reporter, const ctest_suite_stats *stats);
+	void (*on_delete)(ctest_reporter *reporter); //Called by reporter_delete() (e.g. to close the file).
+	void *data;                                  //State of the reporter.
+	void (*on_failures_suppressed)(ctest_reporter *reporter, const char assert_name[], int line_number, int num_of_suppressed); //Fails only counted at a site (see max_failures_per_site).
+	void (*on_assert_stats)(ctest_reporter *reporter, const assert_site_stats sites[], size_t num_of_sites); //Sites of the suite, the slowest first (see assert_stats.c).
+	void (*on_bench)(ctest_reporter *reporter, const ctest_bench_stats *stats, const bench_baseline_result_struct *baseline); //End of a CTEST_BENCH.
+	void (*on_bench_comparison)(ctest_reporter *reporter, const ctest_bench_comparison *comparison); //End of a CTEST_BENCH_COMPARE.
+	void (*on_warning)(ctest_reporter *reporter, const char source[], const char message[]); //E.g. of the noise control mode (see bench_noise.c).
+};
+
+//Declaration of functions:
+void reporter_add(ctest_reporter *reporter);
+void reporter_remove(ctest_reporter *reporter);
+void reporter_delete(ctest_reporter *reporter);
+void reporters_open_from_env();
+ctest_reporter *reporter_console();
+ctest_reporter *reporter_junit_create(char path[]);
+ctest_reporter *reporter_tap_create(char path[]);
+ctest_reporter *reporter_jsonl_create(char path[]);
+ctest_reporter *reporter_binlog_create(char path[]);
+FILE *reporter_open_file(char path[]);
+void reporter_close_file(FILE *file);
+void *reporter_alloc_shared(size_t size);
+void reporter_free_shared(void *data, size_t size);
+void reporter_flush_in_child(FILE *file);
+void reporter_write_json_string(FILE *file, const char str[]);
+void reporter_write_xml_string(FILE *file, const char str[]);
+void reporters_suite_start(const char name[], const char description[], char *func_ids[]);
+void reporters_module_start(const char name[], const char description[], char *func_ids[]);
+void reporters_assert(const assert_result_struct *result, char status);
+void reporters_failures_suppressed(const char assert_name[], int line_number, int num_of_suppressed);
+void reporters_assert_stats(const assert_site_stats sites[], size_t num_of_sites);
+void reporters_bench(const ctest_bench_stats *stats, const bench_baseline_result_struct *baseline);
+void reporters_bench_comparison(const ctest_bench_comparison *comparison);
+void reporters_warning(const char source[], const char message[]);
+void reporters_module_end(const ctest_module_stats *stats);
+void reporters_suite_end(const ctest_suite_stats *stats);
+#endif
@@ -0,0 +1,452 @@
+/**
+ * Title: REPORTER BINLOG
+ */
+
+/**
+ * Description: This file contains the reporter that writes the binary result
+ * log (see the format in ctest_log.h). A result is one entry of LOG_ENTRY_SIZE
+ * bytes (two if it failed), so the log of hundreds of millions of results is a
+ * few GiB and may be queried with ctest_log.c without being parsed.
+ *     The names and the messages are interned: each distinct string is written
+ * once and the results refer to it by id. The details of the fails are not
+ * interned. The id of an object is its position in the file, so a child process
+ * (e.g. of a module after CTEST_FIXTURE_CHECKPOINT) writes its own results and
+ * strings to the same file. After a fork, the position is read again from the
+ * descriptor before the next entry of the parent.
+ *     The index of the modules and of the suites is written at the end, by
+ * reporter_delete().
+ */
+
+//Includes:
+#include "globals.h"
+#include "reporter.h"
+#include "ctest_log.h"
+#include "ctest_functions.h"
+#include "dict.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Macros:
+#define STRINGS_TABLE_SIZE 1024
+
+//Definition of types:
+typedef struct {
+	uint32_t id;     //Module or suite.
+	uint32_t first_entry;
+	uint32_t end_entry;
+} index_entry;
+
+typedef struct {
+	FILE *file;
+	uint64_t num_of_entries;      //Position (in entries) of the next entry.
+	unsigned int fork_generation; //Value of 'fork_generation' when the position was read.
+	T_dict *strings;              //Interned string -> id.
+	char **keys;                  //Copies of the interned strings (keys of 'strings').
+	size_t num_of_keys;
+	size_t keys_capacity;
+	const char *last_assert_name; //Cache of the last assert name (the assert names are literals).
+	uint32_t last_assert_id;
+	uint32_t suite_id;            //0 if the suite is not defined yet.
+	uint32_t module_id;           //0 outside modules.
+	index_entry *index;
+	size_t index_size;
+	size_t index_capacity;
+} binlog_data;
+
+//Local variables:
+static unsigned int fork_generation = 0;
+static bool was_atfork_registered = false;
+
+//Local auxiliary functions:
+static void binlog_suite_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void binlog_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void binlog_assert(ctest_reporter *reporter, const assert_result_struct *result, char status);
+static void binlog_module_end(ctest_reporter *reporter, const ctest_module_stats *stats);
+static void binlog_suite_end(ctest_reporter *reporter, const ctest_suite_stats *stats);
+static void binlog_delete(ctest_reporter *reporter);
+static uint32_t write_entry(binlog_data *data, const unsigned char entry[]);
+static uint32_t write_string(binlog_data *data, const char str[]);
+static uint32_t intern_string(binlog_data *data, const char str[]);
+static uint32_t define_suite(binlog_data *data, const char name[]);
+static uint32_t define_module(binlog_data *data, const char name[]);
+static void write_end(binlog_data *data, log_entry_kind kind, uint32_t id, int num_of_results, int num_of_fails, int num_of_ignored, double wall_time, double cpu_time, size_t peak_rss);
+static void add_to_index(binlog_data *data, uint32_t id, uint32_t end_entry);
+static void put_u32(unsigned char bytes[], uint32_t value);
+static void put_u64(unsigned char bytes[], uint64_t value);
+static void put_f64(unsigned char bytes[], double value);
+static void increment_fork_generation();
+
+
+//Function definitions:
+ctest_reporter *reporter_binlog_create(char path[])
+/**
+ * Description: This function creates a reporter that writes the binary result
+ * log (see the description of this file) to 'path'. It must be registered with
+ * reporter_add(). The file must be seekable, so "-" is not accepted.
+ *
+ * Memory allocation: The user must call reporter_delete after using the reporter.
+ * It writes the index and closes the file.
+ *
+ * Input: (char []) path --> The path of the log.
+ *
+ * Output: (ctest_reporter *) --> The reporter.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	ctest_reporter *reporter = malloc(sizeof *reporter);
+	binlog_data *data = calloc(1, sizeof *data);
+	unsigned char header[LOG_ENTRY_SIZE] = LOG_MAGIC;
+
+	if(reporter == NULL || data == NULL)
+	{
+		fprintf(stderr, "Error while allocating the binary log reporter.\n");
+		exit(EXIT_FAILURE);
+	}
+	if(strcmp(path, "-") == 0)
+	{
+		fprintf(stderr, "Error: the binary log must be written to a file.\n");
+		exit(EXIT_FAILURE);
+	}
+	if(!was_atfork_registered)
+	{
+		was_atfork_registered = true;
+		pthread_atfork(NULL, increment_fork_generation, NULL);
+	}
+	data->file            = reporter_open_file(path);
+	data->fork_generation = fork_generation;
+	data->strings         = D_create_dict(STRINGS_TABLE_SIZE);
+	header[8]  = LOG_VERSION & 0xff;
+	header[9]  = LOG_VERSION >> 8;
+	header[10] = LOG_ENTRY_SIZE & 0xff;
+	header[11] = LOG_ENTRY_SIZE >> 8;
+	write_entry(data, header);
+
+	reporter->on_suite_start  = binlog_suite_start;
+	reporter->on_module_start = binlog_module_start;
+	reporter->on_assert       = binlog_assert;
+	reporter->on_module_end   = binlog_module_end;
+	reporter->on_suite_end    = binlog_suite_end;
+	reporter->on_delete       = binlog_delete;
+	reporter->data            = data;
+	reporter->on_failures_suppressed = NULL;
+	reporter->on_assert_stats        = NULL;
+	reporter->on_bench               = NULL;
+	reporter->on_bench_comparison    = NULL;
+	reporter->on_warning             = NULL;
+	return reporter;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void binlog_suite_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+{
+	binlog_data *data = reporter->data;
+
+	data->module_id = 0;
+	data->suite_id  = define_suite(data, name);
+}
+
+
+static void binlog_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+{
+	binlog_data *data = reporter->data;
+
+	data->module_id = define_module(data, name);
+}
+
+
+static void binlog_assert(ctest_reporter *reporter, const assert_result_struct *result, char status)
+/**
+ * Description: This function writes the result entry (and the failure entry of
+ * a fail or error). The module or the suite is defined here if the reporter was
+ * registered after its start.
+ */
+{
+	binlog_data *data = reporter->data;
+	unsigned char entry[LOG_ENTRY_SIZE] = {LOG_RESULT};
+	uint32_t scope_id;
+
+	if(data->suite_id == 0) data->suite_id = define_suite(data, suite_ctest_info.suite_name);
+	if(data->module_id == 0 && suite_ctest_info.module_name[0] != '\0') data->module_id = define_module(data, suite_ctest_info.module_name);
+	scope_id = data->module_id != 0 ? data->module_id : data->suite_id;
+	if(result->assert_name != data->last_assert_name)
+	{
+		data->last_assert_name = result->assert_name;
+		data->last_assert_id   = intern_string(data, result->assert_name);
+	}
+
+	entry[1] = (unsigned char) status;
+	put_u32(entry + 4, (uint32_t) result->line_number);
+	put_u32(entry + 8, data->last_assert_id);
+	put_u32(entry + 12, scope_id);
+	if(status == REPORT_FAIL || status == REPORT_ERROR)
+	{
+		unsigned char failure[LOG_ENTRY_SIZE] = {LOG_FAILURE};
+
+		put_u32(failure + 4, intern_string(data, result->std_message));
+		put_u32(failure + 8, result->custom_message != NULL ? intern_string(data, result->custom_message) : 0);
+		put_u32(failure + 12, write_string(data, result->result_details));
+		write_entry(data, entry);
+		write_entry(data, failure);
+	}
+	else write_entry(data, entry);
+	reporter_flush_in_child(data->file);
+}
+
+
+static void binlog_module_end(ctest_reporter *reporter, const ctest_module_stats *stats)
+{
+	binlog_data *data = reporter->data;
+
+	if(data->module_id == 0) return;
+	write_end(data, LOG_MODULE_END, data->module_id, stats->num_of_results, stats->num_of_fails, stats->num_of_ignored,
+			stats->wall_time, stats->cpu_time, stats->peak_rss);
+	data->module_id = 0;
+}
+
+
+static void binlog_suite_end(ctest_reporter *reporter, const ctest_suite_stats *stats)
+{
+	binlog_data *data = reporter->data;
+
+	if(data->suite_id == 0) return;
+	write_end(data, LOG_SUITE_END, data->suite_id, stats->num_of_results, stats->num_of_fails, stats->num_of_ignored,
+			stats->wall_time, stats->cpu_time, 0);
+	data->suite_id  = 0;
+	data->module_id = 0;
+}
+
+
+static void binlog_delete(ctest_reporter *reporter)
+/**
+ * Description: This function writes the index and the trailer, closes the file
+ * and frees the reporter.
+ */
+{
+	binlog_data *data = reporter->data;
+	unsigned char entry[LOG_ENTRY_SIZE] = LOG_TRAILER_MAGIC;
+	uint32_t first_index_entry = (uint32_t) data->num_of_entries;
+	size_t i;
+
+	for(i = 0; i < data->index_size; i++)
+	{
+		unsigned char index[LOG_ENTRY_SIZE] = {LOG_INDEX};
+
+		put_u32(index + 4, data->index[i].id);
+		put_u32(index + 8, data->index[i].first_entry);
+		put_u32(index + 12, data->index[i].end_entry);
+		write_entry(data, index);
+	}
+	put_u32(entry + 8, first_index_entry);
+	put_u32(entry + 12, (uint32_t) data->index_size);
+	write_entry(data, entry);
+	reporter_close_file(data->file);
+
+	D_delete_dict(&data->strings);
+	for(i = 0; i < data->num_of_keys; i++) free(data->keys[i]);
+	free(data->keys);
+	free(data->index);
+	free(data);
+}
+
+
+static uint32_t write_entry(binlog_data *data, const unsigned char entry[])
+/**
+ * Description: This function writes one entry and returns its position. If a
+ * child process was created since the last entry, the position is read again
+ * from the descriptor (the child may have written to the file).
+ */
+{
+	long offset;
+
+	if(data->fork_generation != fork_generation)
+	{
+		data->fork_generation = fork_generation;
+		offset = fflush(data->file) == 0 ? (long) lseek(fileno(data->file), 0, SEEK_CUR) : -1;
+		if(offset < 0)
+		{
+			fprintf(stderr, "Error while reading the position of the binary log.\n");
+			exit(EXIT_FAILURE);
+		}
+		data->num_of_entries = (uint64_t) offset / LOG_ENTRY_SIZE;
+	}
+	if(data->num_of_entries > UINT32_MAX)
+	{
+		fprintf(stderr, "Error: the binary log has more than %lu entries.\n", (unsigned long) UINT32_MAX);
+		exit(EXIT_FAILURE);
+	}
+	if(fwrite(entry, LOG_ENTRY_SIZE, 1, data->file) != 1)
+	{
+		fprintf(stderr, "Error while writing the binary log.\n");
+		exit(EXIT_FAILURE);
+	}
+	return (uint32_t) data->num_of_entries++;
+}
+
+
+static uint32_t write_string(binlog_data *data, const char str[])
+/**
+ * Description: This function writes the entries of a string and returns its id.
+ */
+{
+	unsigned char entry[LOG_ENTRY_SIZE] = {LOG_STRING};
+	size_t length = strlen(str), i;
+	uint32_t id;
+
+	put_u32(entry + 4, (uint32_t) length);
+	id = write_entry(data, entry);
+	for(i = 0; i <= length; i += LOG_ENTRY_SIZE)
+	{
+		memset(entry, 0, LOG_ENTRY_SIZE);
+		memcpy(entry, str + i, length + 1 - i < LOG_ENTRY_SIZE ? length + 1 - i : LOG_ENTRY_SIZE);
+		write_entry(data, entry);
+	}
+	return id;
+}
+
+
+static uint32_t intern_string(binlog_data *data, const char str[])
+/**
+ * Description: This function returns the id of 'str', writing it if it was not
+ * written by this process yet.
+ */
+{
+	T_element key = {.value.str = (char *) str, .type = STRING}, value = {.type = UNSIGNED_INTEGER};
+	T_element *found = D_get_value(key, data->strings);
+	char **keys;
+
+	if(found != NULL) return (uint32_t) found->value.u_i;
+
+	if(data->num_of_keys == data->keys_capacity)
+	{
+		data->keys_capacity = data->keys_capacity == 0 ? 64 : 2 * data->keys_capacity;
+		keys = realloc(data->keys, data->keys_capacity * sizeof *keys);
+		if(keys == NULL)
+		{
+			fprintf(stderr, "Error while allocating the strings of the binary log.\n");
+			exit(EXIT_FAILURE);
+		}
+		data->keys = keys;
+	}
+	key.value.str = malloc(strlen(str) + 1);
+	if(key.value.str == NULL)
+	{
+		fprintf(stderr, "Error while allocating the strings of the binary log.\n");
+		exit(EXIT_FAILURE);
+	}
+	strcpy(key.value.str, str);
+	data->keys[data->num_of_keys++] = key.value.str;
+	value.value.u_i = write_string(data, str);
+	D_assign_value_to_key(key, value, data->strings);
+	return (uint32_t) value.value.u_i;
+}
+
+
+static uint32_t define_suite(binlog_data *data, const char name[])
+{
+	unsigned char entry[LOG_ENTRY_SIZE] = {LOG_SUITE};
+
+	put_u32(entry + 4, intern_string(data, name));
+	return write_entry(data, entry);
+}
+
+
+static uint32_t define_module(binlog_data *data, const char name[])
+{
+	unsigned char entry[LOG_ENTRY_SIZE] = {LOG_MODULE};
+
+	if(data->suite_id == 0) data->suite_id = define_suite(data, suite_ctest_info.suite_name);
+	put_u32(entry + 4, intern_string(data, name));
+	put_u32(entry + 8, data->suite_id);
+	return write_entry(data, entry);
+}
+
+
+static void write_end(binlog_data *data, log_entry_kind kind, uint32_t id, int num_of_results, int num_of_fails, int num_of_ignored, double wall_time, double cpu_time, size_t peak_rss)
+/**
+ * Description: This function writes the end of a module or of a suite and adds
+ * it to the index.
+ */
+{
+	unsigned char entries[3][LOG_ENTRY_SIZE] = {{kind}};
+	uint32_t end_entry;
+
+	put_u32(entries[0] + 4, id);
+	put_u32(entries[0] + 8, (uint32_t) num_of_results);
+	put_u32(entries[0] + 12, (uint32_t) num_of_fails);
+	put_u32(entries[1], (uint32_t) num_of_ignored);
+	put_f64(entries[1] + 8, wall_time);
+	put_f64(entries[2], cpu_time);
+	put_u64(entries[2] + 8, peak_rss);
+	end_entry = write_entry(data, entries[0]);
+	write_entry(data, entries[1]);
+	write_entry(data, entries[2]);
+	add_to_index(data, id, end_entry);
+}
+
+
+static void add_to_index(binlog_data *data, uint32_t id, uint32_t end_entry)
+{
+	index_entry *index;
+
+	if(data->index_size == data->index_capacity)
+	{
+		data->index_capacity = data->index_capacity == 0 ? 64 : 2 * data->index_capacity;
+		index = realloc(data->index, data->index_capacity * sizeof *index);
+		if(index == NULL)
+		{
+			fprintf(stderr, "Error while allocating the index of the binary log.\n");
+			exit(EXIT_FAILURE);
+		}
+		data->index = index;
+	}
+	data->index[data->index_size++] = (index_entry) {.id = id, .first_entry = id, .end_entry = end_entry};
+}
+
+
+static void put_u32(unsigned char bytes[], uint32_t value)
+{
+	bytes[0] = value & 0xff;
+	bytes[1] = (value >> 8) & 0xff;
+	bytes[2] = (value >> 16) & 0xff;
+	bytes[3] = (value >> 24) & 0xff;
+}
+
+
+static void put_u64(unsigned char bytes[], uint64_t value)
+{
+	put_u32(bytes, (uint32_t) value);
+	put_u32(bytes + 4, (uint32_t) (value >> 32));
+}
+
+
+static void put_f64(unsigned char bytes[], double value)
+{
+	uint64_t bits;
+
+	memcpy(&bits, &value, sizeof bits);
+	put_u64(bytes, bits);
+}
+
+
+static void increment_fork_generation()
+/**
+ * Description: This function is registered with pthread_atfork() and is called
+ * by the parent after each fork.
+ */
+{
+	fork_generation++;
+}
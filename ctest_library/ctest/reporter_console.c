@@ -0,0 +1,658 @@
+/**
+ * Title: REPORTER CONSOLE
+ */
+
+/**
+ * Description: This file contains the console reporter: the boxes of the suites,
+ * modules and benchmarks, the progress of the results, the failure messages and
+ * the warnings, written to the standard output. It is registered by default
+ * (see reporter.c). If 'verbose' is SILENT, only the fails, the errors and the
+ * summary of the suite are printed.
+ */
+
+//Includes:
+#include "globals.h"
+#include "reporter.h"
+#include "ctest_functions.h"
+#include "text_formatting.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Local auxiliary functions:
+static void console_suite_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void console_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void console_assert(ctest_reporter *reporter, const assert_result_struct *result, char status);
+static void console_failures_suppressed(ctest_reporter *reporter, const char assert_name[], int line_number, int num_of_suppressed);
+static void console_assert_stats(ctest_reporter *reporter, const assert_site_stats sites[], size_t num_of_sites);
+static void console_bench(ctest_reporter *reporter, const ctest_bench_stats *stats, const bench_baseline_result_struct *baseline);
+static void console_bench_comparison(ctest_reporter *reporter, const ctest_bench_comparison *comparison);
+static void console_warning(ctest_reporter *reporter, const char source[], const char message[]);
+static void console_module_end(ctest_reporter *reporter, const ctest_module_stats *stats);
+static void console_suite_end(ctest_reporter *reporter, const ctest_suite_stats *stats);
+static void print_slowest_modules(char *thin_line);
+static char *rate_to_str(double rate, char unit[], char str[], size_t size);
+
+//Local variables:
+static ctest_reporter console_reporter = {
+	console_suite_start,  //on_suite_start
+	console_module_start, //on_module_start
+	console_assert,       //on_assert
+	console_module_end,   //on_module_end
+	console_suite_end,    //on_suite_end
+	NULL,                 //on_delete
+	NULL,                 //data
+	console_failures_suppressed, //on_failures_suppressed
+	console_assert_stats, //on_assert_stats
+	console_bench,        //on_bench
+	console_bench_comparison, //on_bench_comparison
+	console_warning       //on_warning
+};
+
+
+//Function definitions:
+ctest_reporter *reporter_console()
+/**
+ * Description: This function returns the console reporter. It must not be
+ * deleted.
+ *
+ * Input: (void)
+ *
+ * Output: (ctest_reporter *) --> The console reporter.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	return &console_reporter;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void console_suite_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+/**
+ * Description: This function prints the name, the description and the IDs of
+ * the functions of the suite.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char *thick_line = "================================================================================"; // Repeat '=' 80 times.
+	char *thin_line = "--------------------------------------------------------------------------------"; // Repeat '=' 80 times.
+	char suite_description[MAX_DESCRIPTION], *aux_str, *merged_str;
+	int n, line_length = 80;
+
+	if(verbose == SILENT) return;
+	n = snprintf(suite_description, MAX_DESCRIPTION, "%s", description);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while initializing suite_description.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	//Print the starting informations:
+	n = fprintf(stdout, "%s\n||   START SUITE: %-59s ||\n%s\n", thick_line, name, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite name.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	aux_str = break_line(suite_description, MAX_DESCRIPTION, "||   DESCRIPTION: ", "||   ", " ||", line_length);
+	n = fprintf(stdout, "%s%s\n", aux_str, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite description.\n");
+		exit(EXIT_FAILURE);
+	}
+	free(aux_str);
+
+	merged_str = merge_str(func_ids, ", ", ".");
+	aux_str = break_line(merged_str, strlen(merged_str), "||   FUNCTIONS COVERED: ", "||   ", " ||", line_length);
+	n = fprintf(stdout, "%s%s\n\n", aux_str, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite functions ids.\n");
+		exit(EXIT_FAILURE);
+	}
+	free(merged_str);
+	free(aux_str);
+}
+
+
+static void console_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+/**
+ * Description: This function prints the name, the description and the IDs of
+ * the functions of the module.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char *thick_line = "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~"; // Repeat '~' 80 times.
+	char *thin_line = "................................................................................"; // Repeat '.' 80 times.
+	char module_description[MAX_DESCRIPTION], *aux_str, *merged_str;
+	int n, line_length = 80;
+
+	if(verbose == SILENT) return;
+	n = snprintf(module_description, MAX_DESCRIPTION, "%s", description);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while initializing module_description.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	//Print the starting informations:
+	n = fprintf(stdout, "\n\n%s\n    START MODULE:      %-54s \n", thick_line, name);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite name.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	aux_str = break_line(module_description, MAX_DESCRIPTION, "    DESCRIPTION:       ", "    ", " ", line_length);
+	n = fprintf(stdout, "%s", aux_str);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite description.\n");
+		exit(EXIT_FAILURE);
+	}
+	free(aux_str);
+
+	merged_str = merge_str(func_ids, ", ", ".");
+	aux_str = break_line(merged_str, strlen(merged_str), "    FUNCTIONS COVERED: ", "    ", " ", line_length);
+	n = fprintf(stdout, "%s%s", aux_str, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite functions ids.\n");
+		exit(EXIT_FAILURE);
+	}
+	free(merged_str);
+	free(aux_str);
+}
+
+
+static void console_assert(ctest_reporter *reporter, const assert_result_struct *result, char status)
+/**
+ * Description: This function prints one result: '.', 'I' or the failure message
+ * (with the standard message, the custom message and the details, according to
+ * 'verbose'). An error of the module is printed as one line. The progress of the
+ * module (without this result) is printed first, if 'ctest_info.print_progress'
+ * is true. It is called after the result was counted. If 'verbose' is SILENT,
+ * it receives only the fails and the errors, which are printed with the name of
+ * the module and without the progress.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	int n, line_length = 80;
+	char *buffer_str;
+
+	//Print the first 'Progress':
+	if(ctest_info.print_progress && verbose != SILENT)
+	{
+		fprintf(stdout, "\n>>> Progress: %.*s", ctest_info.progress_length - 1, ctest_info.progress);
+		ctest_info.print_progress = false;
+	}
+
+	switch(status)
+	{
+		case REPORT_SUCCESS:
+		case REPORT_IGNORED:
+			n = fprintf(stdout, "%c", status);
+			break;
+		case REPORT_ERROR:
+			if(verbose == SILENT) n = fprintf(stdout, "\n>>> MODULE %s: %s\n", suite_ctest_info.module_name, result->result_details);
+			else n = fprintf(stdout, "\n>>> %s", result->result_details);
+			break;
+		default:
+			//Print the header:
+			if(verbose == SILENT)
+				n = fprintf(stdout, "\nFAILURE MESSAGE (Module %s, assert number %d at LINE %d):\n", suite_ctest_info.module_name, ctest_info.num_of_results, result->line_number);
+			else
+				n = fprintf(stdout, "F\n\nFAILURE MESSAGE (Assert number %d at LINE %d):\n", ctest_info.num_of_results, result->line_number);
+			if (n < 0)
+			{
+				fprintf(stderr, "Error while printing the header of the result.\n");
+				exit(EXIT_FAILURE);
+			}
+
+			//Print the assert name:
+			n = fprintf(stdout, "<assert name> --> %s\n", result->assert_name);
+			if (n < 0)
+			{
+				fprintf(stderr, "Error while printing the assert name of the result.\n");
+				exit(EXIT_FAILURE);
+			}
+
+			//Print the std message:
+			if(verbose == MEDIUM || verbose == HIGH)
+			{
+				buffer_str = break_line(result->std_message, MAX_CHARS, "<std msg>     --> ", "    ", "", line_length);
+				n = fprintf(stdout, "%s", buffer_str );
+				if (n < 0)
+				{
+					fprintf(stderr, "Error while printing the stantard message of the result.\n");
+					exit(EXIT_FAILURE);
+				}
+				free(buffer_str);
+			}
+
+			//Print the custom message:
+			if(result->custom_message != NULL && (verbose == MEDIUM || verbose == HIGH))
+			{
+				buffer_str = break_line(result->custom_message, MAX_CHARS, "<custom msg>  --> ", "    ", "", line_length);
+				n = fprintf(stdout, "%s", buffer_str);
+				if (n < 0)
+				{
+					fprintf(stderr, "Error while printing the custom message of the result.\n");
+					exit(EXIT_FAILURE);
+				}
+				free(buffer_str);
+			}
+
+			//Print the details of the failure:
+			if(verbose == HIGH)
+			{
+				n = fprintf(stdout, "<details>     -->\n%s", result->result_details);
+				if (n < 0)
+				{
+					fprintf(stderr, "Error while printing the custom message of the result.\n");
+					exit(EXIT_FAILURE);
+				}
+			}
+
+			//Keep the progress:
+			if(verbose != SILENT) n = fprintf(stdout, "\n>>> Progress: %s", ctest_info.progress);
+	}
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the result.\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+
+static void console_failures_suppressed(ctest_reporter *reporter, const char assert_name[], int line_number, int num_of_suppressed)
+/**
+ * Description: This function prints the number of fails of a site that were only
+ * counted, e.g. "(+999,990 more failures of assert_integer_equal at LINE 42)",
+ * and the progress again.
+ */
+{
+	char count_str[32];
+
+	fprintf(stdout, "\n>>> (+%s more failures of %s at LINE %d)", TF_count_to_str(num_of_suppressed, count_str, sizeof count_str), assert_name, line_number);
+
+	//Keep the progress:
+	if(verbose != SILENT) fprintf(stdout, "\n>>> Progress: %s", ctest_info.progress);
+}
+
+
+static void console_assert_stats(ctest_reporter *reporter, const assert_site_stats sites[], size_t num_of_sites)
+/**
+ * Description: This function prints the NUM_OF_ASSERT_HOTSPOTS sites of the 
+ * suite with the greatest time spent inside their assertions (they are sorted by
+ * assert_stats_end_suite()), before the summary of the suite.
+ */
+{
+	char *thin_line = "--------------------------------------------------------------------------------"; // Repeat '-' 80 times.
+	char title[64], hits_str[32], fails_str[32], time_str[32];
+	size_t i;
+
+	if(num_of_sites == 0) return;
+	snprintf(title, sizeof title, "%zu slowest of %zu sites", num_of_sites < NUM_OF_ASSERT_HOTSPOTS ? num_of_sites : NUM_OF_ASSERT_HOTSPOTS, num_of_sites);
+	fprintf(stdout, "\n\n%s\n||   ASSERT HOTSPOTS:   %-53s ||\n%s\n", thin_line, title, thin_line);
+	fprintf(stdout, "||       %-26s %6s %11s %9s %12s ||\n", "ASSERT", "LINE", "HITS", "FAILS", "TIME");
+	for(i = 0; i < num_of_sites && i < NUM_OF_ASSERT_HOTSPOTS; i++)
+	{
+		fprintf(stdout, "||   %2zu. %-26.26s %6d %11s %9s %12s ||\n", i + 1, sites[i].assert_name, sites[i].line_number,
+				TF_count_to_str((long long) sites[i].num_of_hits, hits_str, sizeof hits_str),
+				TF_count_to_str((long long) sites[i].num_of_fails, fails_str, sizeof fails_str),
+				TF_time_to_str(sites[i].total_ns / 1e9, time_str, sizeof time_str));
+	}
+	fprintf(stdout, "%s\n", thin_line);
+}
+
+
+static void console_bench(ctest_reporter *reporter, const ctest_bench_stats *stats, const bench_baseline_result_struct *baseline)
+/**
+ * Description: This function prints the statistics of a benchmark (and the
+ * comparison with the baseline, if any) in the style of the module summary.
+ * Nothing is printed if 'verbose' is SILENT.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char *thick_line = "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~"; // Repeat '~' 80 times.
+	char *thin_line = "................................................................................"; // Repeat '.' 80 times.
+	char str[64], aux_str[32];
+	int n;
+
+	if(verbose == SILENT) return;
+	n = fprintf(stdout, "\n%s\n    BENCHMARK:         %-54s \n%s\n", thin_line, stats->name, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the benchmark.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	snprintf(str, sizeof str, "%zu samples x %zu iterations", stats->num_of_samples, stats->iterations_per_sample);
+	n = fprintf(stdout, "    -> SAMPLES:        %-54s \n", str);
+	n = n < 0 ? n : fprintf(stdout, "    -> MIN:            %-54s \n", TF_time_to_str(stats->min, aux_str, sizeof aux_str));
+	n = n < 0 ? n : fprintf(stdout, "    -> MEDIAN:         %-54s \n", TF_time_to_str(stats->median, aux_str, sizeof aux_str));
+	n = n < 0 ? n : fprintf(stdout, "    -> MEAN:           %-54s \n", TF_time_to_str(stats->mean, aux_str, sizeof aux_str));
+	n = n < 0 ? n : fprintf(stdout, "    -> MAD:            %-54s \n", TF_time_to_str(stats->mad, aux_str, sizeof aux_str));
+	n = n < 0 ? n : fprintf(stdout, "    -> P99:            %-54s \n", TF_time_to_str(stats->p99, aux_str, sizeof aux_str));
+	if(n >= 0 && stats->bytes_per_second > 0)
+		n = fprintf(stdout, "    -> THROUGHPUT:     %-54s \n", rate_to_str(stats->bytes_per_second, "B/s", str, sizeof str));
+	if(n >= 0 && stats->items_per_second > 0)
+		n = fprintf(stdout, "    -> THROUGHPUT:     %-54s \n", rate_to_str(stats->items_per_second, "items/s", str, sizeof str));
+	if(n >= 0 && baseline->was_found)
+	{
+		snprintf(str, sizeof str, "%s (x%.3f, p = %.2g)", TF_time_to_str(baseline->median, aux_str, sizeof aux_str), baseline->ratio, baseline->p_value);
+		n = fprintf(stdout, "    -> BASELINE:       %-54s \n", str);
+	}
+	if(n >= 0 && baseline->was_updated)
+		n = fprintf(stdout, "    -> BASELINE:       %-54s \n", "updated");
+	if(n >= 0 && (stats->cpu >= 0 || stats->num_of_discarded > 0))
+	{
+		if(stats->cpu >= 0) snprintf(str, sizeof str, "CPU %d, %zu samples discarded", stats->cpu, stats->num_of_discarded);
+		else snprintf(str, sizeof str, "not pinned, %zu samples discarded", stats->num_of_discarded);
+		n = fprintf(stdout, "    -> NOISE CONTROL:  %-54s \n", str);
+	}
+	if(n >= 0 && stats->has_perf_counters) perf_print_counters(stdout, &stats->perf, bench_get_perf_iterations(stats));
+	n = n < 0 ? n : fprintf(stdout, "%s", thick_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the benchmark.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	//The next assertion prints the progress again:
+	ctest_info.print_progress = true;
+}
+
+
+static void console_bench_comparison(ctest_reporter *reporter, const ctest_bench_comparison *comparison)
+/**
+ * Description: This function prints the result of a comparative benchmark in
+ * the style of the module summary. Nothing is printed if 'verbose' is SILENT.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char *thick_line = "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~"; // Repeat '~' 80 times.
+	char *thin_line = "................................................................................"; // Repeat '.' 80 times.
+	char str[2 * MAX_BENCH_NAME + 4], aux_str[32]; //Both names and " vs ".
+	int n;
+
+	if(verbose == SILENT) return;
+	snprintf(str, sizeof str, "%s vs %s", comparison->a_name, comparison->b_name);
+	n = fprintf(stdout, "\n%s\n    COMPARISON:        %-54s \n%s\n", thin_line, str, thin_line);
+	snprintf(str, sizeof str, "%zu pairs of samples", comparison->num_of_samples);
+	n = n < 0 ? n : fprintf(stdout, "    -> SAMPLES:        %-54s \n", str);
+	snprintf(str, sizeof str, "%s per call (%s)", TF_time_to_str(comparison->a_median, aux_str, sizeof aux_str), comparison->a_name);
+	n = n < 0 ? n : fprintf(stdout, "    -> A:              %-54s \n", str);
+	snprintf(str, sizeof str, "%s per call (%s)", TF_time_to_str(comparison->b_median, aux_str, sizeof aux_str), comparison->b_name);
+	n = n < 0 ? n : fprintf(stdout, "    -> B:              %-54s \n", str);
+	snprintf(str, sizeof str, "%.3f [%.3f, %.3f] (95%% CI)", comparison->speedup, comparison->speedup_low, comparison->speedup_high);
+	n = n < 0 ? n : fprintf(stdout, "    -> SPEEDUP (A/B):  %-54s \n", str);
+	if(n >= 0 && (comparison->cpu >= 0 || comparison->num_of_discarded > 0))
+	{
+		if(comparison->cpu >= 0) snprintf(str, sizeof str, "CPU %d, %zu pairs discarded", comparison->cpu, comparison->num_of_discarded);
+		else snprintf(str, sizeof str, "not pinned, %zu pairs discarded", comparison->num_of_discarded);
+		n = fprintf(stdout, "    -> NOISE CONTROL:  %-54s \n", str);
+	}
+	n = n < 0 ? n : fprintf(stdout, "%s", thick_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the comparison.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	//The next assertion prints the progress again:
+	ctest_info.print_progress = true;
+}
+
+
+static void console_warning(ctest_reporter *reporter, const char source[], const char message[])
+/**
+ * Description: This function prints a warning (e.g. of the noise control mode).
+ * Nothing is printed if 'verbose' is SILENT.
+ */
+{
+	if(verbose == SILENT) return;
+	fprintf(stdout, "\n>>> Warning (%s): %s", source, message);
+
+	//The next assertion prints the progress again:
+	ctest_info.print_progress = true;
+}
+
+
+static void console_module_end(ctest_reporter *reporter, const ctest_module_stats *stats)
+/**
+ * Description: This function prints the summary of the module.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char *thick_line = "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~"; // Repeat '~' 80 times.
+	char *thin_line = "................................................................................"; // Repeat '.' 80 times.
+	char time_str[32], heap_str[48];
+	int n;
+
+	if(verbose == SILENT) return;
+
+	//Print the starting informations:
+	n = fprintf(stdout, "\n%s\n    SUMMARY OF THE MODULE: %-50s \n", thin_line, stats->module_name);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "    -> TOTAL OF CASES: %-54d \n", stats->num_of_results);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "    -> SUCCESSES:      %-54d \n", stats->num_of_results - stats->num_of_fails - stats->num_of_ignored);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "    -> FAILS:          %-54d \n", stats->num_of_fails);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "    -> IGNORED:        %-54d \n", stats->num_of_ignored);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "    -> WALL TIME:      %-54s \n", TF_time_to_str(stats->wall_time, time_str, sizeof time_str));
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "    -> CPU TIME:       %-54s \n", TF_time_to_str(stats->cpu_time, time_str, sizeof time_str));
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if(alloc_hooks_are_active()) snprintf(heap_str, sizeof heap_str, "%+lld bytes", stats->heap_delta);
+	else snprintf(heap_str, sizeof heap_str, "n/a (allocation hooks not linked)");
+	n = fprintf(stdout, "    -> HEAP DELTA:     %-54s \n", heap_str);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "    -> PEAK RSS:       %-54s \n", TF_bytes_to_str(stats->peak_rss, heap_str, sizeof heap_str));
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if(perf_counters_are_enabled()) perf_print_counters(stdout, &stats->perf, 0);
+	n = fprintf(stdout, "%s\n\n", thick_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the module summary.\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+
+static void console_suite_end(ctest_reporter *reporter, const ctest_suite_stats *stats)
+/**
+ * Description: This function prints the summary of the suite.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ */
+{
+	char *thick_line = "================================================================================"; // Repeat '=' 80 times.
+	char *thin_line = "--------------------------------------------------------------------------------"; // Repeat '=' 80 times.
+	char time_str[32];
+	int n;
+
+	//Print the starting informations:
+	n = fprintf(stdout, "\n\n%s\n||   SUMMARY OF THE SUITE: %-50s ||\n%s\n", thin_line, stats->suite_name, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "||   -> TOTAL OF CASES: %-53d ||\n%s\n", stats->num_of_results, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "||   -> SUCCESSES:      %-53d ||\n%s\n", stats->num_of_results - stats->num_of_fails - stats->num_of_ignored, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "||   -> FAILS:          %-53d ||\n%s\n", stats->num_of_fails, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "||   -> IGNORED:        %-53d ||\n%s\n", stats->num_of_ignored, thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "||   -> WALL TIME:      %-53s ||\n%s\n", TF_time_to_str(stats->wall_time, time_str, sizeof time_str), thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	n = fprintf(stdout, "||   -> CPU TIME:       %-53s ||\n%s\n", TF_time_to_str(stats->cpu_time, time_str, sizeof time_str), thin_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite summary.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	print_slowest_modules(thin_line);
+	n = fprintf(stdout, "%s\n\n", thick_line);
+	if (n < 0)
+	{
+		fprintf(stderr, "Error while printing the suite summary.\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+
+static void print_slowest_modules(char *thin_line)
+/**
+ * Description: This function prints the NUM_OF_SLOWEST_MODULES modules of the
+ * suite with the greatest wall time, the slowest first.
+ *
+ * Time Complexity: O(NUM_OF_SLOWEST_MODULES * num_of_modules)
+ */
+{
+	size_t slowest[NUM_OF_SLOWEST_MODULES], num_of_slowest = 0, num_of_modules, i, j;
+	const ctest_module_stats *modules_stats = get_suite_modules_stats(&num_of_modules);
+	char wall_time_str[32], cpu_time_str[32];
+
+	if(num_of_modules == 0) return;
+
+	//Insertion in the sorted list of the slowest modules:
+	for(i = 0; i < num_of_modules; i++)
+	{
+		j = num_of_slowest < NUM_OF_SLOWEST_MODULES ? num_of_slowest++ : NUM_OF_SLOWEST_MODULES;
+		while(j > 0 && modules_stats[slowest[j - 1]].wall_time < modules_stats[i].wall_time)
+		{
+			if(j < NUM_OF_SLOWEST_MODULES) slowest[j] = slowest[j - 1];
+			j--;
+		}
+		if(j < NUM_OF_SLOWEST_MODULES) slowest[j] = i;
+	}
+
+	fprintf(stdout, "||   SLOWEST MODULES:   %-53s ||\n", "");
+	for(i = 0; i < num_of_slowest; i++)
+	{
+		fprintf(stdout, "||   %2zu. %-31s wall: %-12s cpu: %-12s ||\n", i + 1, modules_stats[slowest[i]].module_name,
+				TF_time_to_str(modules_stats[slowest[i]].wall_time, wall_time_str, sizeof wall_time_str),
+				TF_time_to_str(modules_stats[slowest[i]].cpu_time, cpu_time_str, sizeof cpu_time_str));
+	}
+	fprintf(stdout, "%s\n", thin_line);
+}
+
+
+static char *rate_to_str(double rate, char unit[], char str[], size_t size)
+/**
+ * Description: This function writes 'rate' in 'str' with a decimal prefix
+ * (k, M, G or T) before 'unit'.
+ */
+{
+	char *prefixes[] = {"", "k", "M", "G", "T"};
+	size_t i = 0;
+
+	while(rate >= 1000 && i < sizeof prefixes / sizeof *prefixes - 1)
+	{
+		rate /= 1000;
+		i++;
+	}
+	snprintf(str, size, "%.3f %s%s", rate, prefixes[i], unit);
+	return str;
+}
@@ -0,0 +1,226 @@
+/**
+ * Title: REPORTER JSONL
+ */
+
+/**
+ * Description: This file contains the JSON Lines reporter. Each event is written
+ * as one JSON object in one line, with the fields "event" ("suite_start",
+ * "module_start", "assert", "failures_suppressed", "assert_stats", "module_end" or
+ * "suite_end"),
+ * "suite", "module" (null outside modules) and "pid", plus the fields of the
+ * event:
+ * 	suite_start/module_start: "description" and "functions";
+ * 	assert: "status" ("success", "fail", "ignored" or "error"), "assert",
+ * "line", "message", "custom_message" and "details" (only for fails/errors);
+ * 	failures_suppressed: "assert", "line" and "count" (the fails of the site that
+ * were only counted, see max_failures_per_site);
+ * 	assert_stats: "assert", "line", "hits", "passes", "fails", "ignored" and
+ * "time" (seconds), one line per site, the slowest first (see assert_stats.c);
+ * 	module_end: "results", "fails", "ignored", "wall_time", "cpu_time",
+ * "heap_delta" and "peak_rss";
+ * 	suite_end: "results", "fails", "ignored", "wall_time" and "cpu_time".
+ * The lines of a module executed by a child process are written by the child.
+ */
+
+//Includes:
+#include "globals.h"
+#include "reporter.h"
+#include "ctest_functions.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Local auxiliary functions:
+static void jsonl_suite_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void jsonl_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void jsonl_assert(ctest_reporter *reporter, const assert_result_struct *result, char status);
+static void jsonl_failures_suppressed(ctest_reporter *reporter, const char assert_name[], int line_number, int num_of_suppressed);
+static void jsonl_assert_stats(ctest_reporter *reporter, const assert_site_stats sites[], size_t num_of_sites);
+static void jsonl_module_end(ctest_reporter *reporter, const ctest_module_stats *stats);
+static void jsonl_suite_end(ctest_reporter *reporter, const ctest_suite_stats *stats);
+static void jsonl_delete(ctest_reporter *reporter);
+static void write_event_start(FILE *file, const char event[]);
+static void write_description(FILE *file, const char description[], char *func_ids[]);
+
+
+//Function definitions:
+ctest_reporter *reporter_jsonl_create(char path[])
+/**
+ * Description: This function creates a JSON Lines reporter (see the description
+ * of this file) that writes to 'path'. It must be registered with reporter_add().
+ *
+ * Memory allocation: The user must call reporter_delete after using the reporter.
+ * It closes the file.
+ *
+ * Input: (char []) path --> The path of the report ("-" for the standard output).
+ *
+ * Output: (ctest_reporter *) --> The reporter.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	ctest_reporter *reporter = malloc(sizeof *reporter);
+
+	if(reporter == NULL)
+	{
+		fprintf(stderr, "Error while allocating the JSON Lines reporter.\n");
+		exit(EXIT_FAILURE);
+	}
+	reporter->on_suite_start  = jsonl_suite_start;
+	reporter->on_module_start = jsonl_module_start;
+	reporter->on_assert       = jsonl_assert;
+	reporter->on_module_end   = jsonl_module_end;
+	reporter->on_suite_end    = jsonl_suite_end;
+	reporter->on_delete       = jsonl_delete;
+	reporter->data            = reporter_open_file(path);
+	reporter->on_failures_suppressed = jsonl_failures_suppressed;
+	reporter->on_assert_stats        = jsonl_assert_stats;
+	reporter->on_bench               = NULL;
+	reporter->on_bench_comparison    = NULL;
+	reporter->on_warning             = NULL;
+	return reporter;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void jsonl_suite_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+{
+	FILE *file = reporter->data;
+
+	write_event_start(file, "suite_start");
+	write_description(file, description, func_ids);
+}
+
+
+static void jsonl_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+{
+	FILE *file = reporter->data;
+
+	write_event_start(file, "module_start");
+	write_description(file, description, func_ids);
+}
+
+
+static void jsonl_assert(ctest_reporter *reporter, const assert_result_struct *result, char status)
+{
+	FILE *file = reporter->data;
+	char *status_name;
+
+	switch(status)
+	{
+		case REPORT_SUCCESS: status_name = "success"; break;
+		case REPORT_IGNORED: status_name = "ignored"; break;
+		case REPORT_ERROR:   status_name = "error";   break;
+		default:             status_name = "fail";
+	}
+	write_event_start(file, "assert");
+	fprintf(file, ",\"status\":\"%s\",\"assert\":", status_name);
+	reporter_write_json_string(file, result->assert_name);
+	fprintf(file, ",\"line\":%d", result->line_number);
+	if(status == REPORT_FAIL || status == REPORT_ERROR)
+	{
+		fputs(",\"message\":", file);
+		reporter_write_json_string(file, result->std_message);
+		fputs(",\"custom_message\":", file);
+		reporter_write_json_string(file, result->custom_message);
+		fputs(",\"details\":", file);
+		reporter_write_json_string(file, result->result_details);
+	}
+	fputs("}\n", file);
+	reporter_flush_in_child(file);
+}
+
+
+static void jsonl_failures_suppressed(ctest_reporter *reporter, const char assert_name[], int line_number, int num_of_suppressed)
+{
+	FILE *file = reporter->data;
+
+	write_event_start(file, "failures_suppressed");
+	fputs(",\"assert\":", file);
+	reporter_write_json_string(file, assert_name);
+	fprintf(file, ",\"line\":%d,\"count\":%d}\n", line_number, num_of_suppressed);
+	reporter_flush_in_child(file);
+}
+
+
+static void jsonl_assert_stats(ctest_reporter *reporter, const assert_site_stats sites[], size_t num_of_sites)
+{
+	FILE *file = reporter->data;
+	size_t i;
+
+	for(i = 0; i < num_of_sites; i++)
+	{
+		write_event_start(file, "assert_stats");
+		fputs(",\"assert\":", file);
+		reporter_write_json_string(file, sites[i].assert_name);
+		fprintf(file, ",\"line\":%d,\"hits\":%llu,\"passes\":%llu,\"fails\":%llu,\"ignored\":%llu,\"time\":%.9f}\n", sites[i].line_number,
+				sites[i].num_of_hits, sites[i].num_of_passes, sites[i].num_of_fails, sites[i].num_of_ignored, sites[i].total_ns / 1e9);
+	}
+}
+
+
+static void jsonl_module_end(ctest_reporter *reporter, const ctest_module_stats *stats)
+{
+	FILE *file = reporter->data;
+
+	write_event_start(file, "module_end");
+	fprintf(file, ",\"results\":%d,\"fails\":%d,\"ignored\":%d,\"wall_time\":%.9f,\"cpu_time\":%.9f,\"heap_delta\":%lld,\"peak_rss\":%zu}\n",
+			stats->num_of_results, stats->num_of_fails, stats->num_of_ignored, stats->wall_time, stats->cpu_time, stats->heap_delta, stats->peak_rss);
+}
+
+
+static void jsonl_suite_end(ctest_reporter *reporter, const ctest_suite_stats *stats)
+{
+	FILE *file = reporter->data;
+
+	write_event_start(file, "suite_end");
+	fprintf(file, ",\"results\":%d,\"fails\":%d,\"ignored\":%d,\"wall_time\":%.9f,\"cpu_time\":%.9f}\n",
+			stats->num_of_results, stats->num_of_fails, stats->num_of_ignored, stats->wall_time, stats->cpu_time);
+}
+
+
+static void jsonl_delete(ctest_reporter *reporter)
+{
+	reporter_close_file(reporter->data);
+}
+
+
+static void write_event_start(FILE *file, const char event[])
+/**
+ * Description: This function writes the beginning of the object of an event:
+ * the fields common to every event, without the closing brace.
+ */
+{
+	fprintf(file, "{\"event\":\"%s\",\"suite\":", event);
+	reporter_write_json_string(file, suite_ctest_info.suite_name);
+	fputs(",\"module\":", file);
+	reporter_write_json_string(file, suite_ctest_info.module_name[0] == '\0' ? NULL : suite_ctest_info.module_name);
+	fprintf(file, ",\"pid\":%ld", (long) getpid());
+}
+
+
+static void write_description(FILE *file, const char description[], char *func_ids[])
+/**
+ * Description: This function writes the fields "description" and "functions" and
+ * closes the object.
+ */
+{
+	size_t i;
+
+	fputs(",\"description\":", file);
+	reporter_write_json_string(file, description);
+	fputs(",\"functions\":[", file);
+	for(i = 0; func_ids != NULL && func_ids[i] != NULL; i++)
+	{
+		if(i > 0) putc(',', file);
+		reporter_write_json_string(file, func_ids[i]);
+	}
+	fputs("]}\n", file);
+}
@@ -0,0 +1,279 @@
+/**
+ * Title: REPORTER JUNIT
+ */
+
+/**
+ * Description: This file contains the JUnit XML reporter. Each module is a
+ * <testsuite> (its package is the suite) and each result is a <testcase> named
+ * after the assertion and its line. Fails and errors have a <failure> element
+ * and ignored results a <skipped/> element. The results outside modules are
+ * grouped in a <testsuite> named after the suite (or after the module, if the
+ * reporter was registered inside it).
+ *     The report is streamed: each element is written when its event happens,
+ * so the memory does not grow with the number of results. The counters of a
+ * <testsuite> are written as zero-padded placeholders and are overwritten at
+ * the end of the module (with pwrite(), which keeps the position of the
+ * stream). If the stream is not seekable (e.g. a pipe), they stay zero. The
+ * counters are the <testcase> elements written (the results that are only
+ * counted have none), kept in memory shared with the child processes.
+ */
+
+//Includes:
+#include "globals.h"
+#include "reporter.h"
+#include "ctest_functions.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Definition of types:
+typedef struct {
+	FILE *file;
+	char testsuite_name[MAX_NAME];
+	bool is_testsuite_open;
+	bool is_implicit;           //The <testsuite> was opened by a result (not by start_module()).
+	long header_offset;         //Position of the <testsuite> tag (-1 if the stream is not seekable).
+	int num_of_tests;           //<testcase> elements of the open <testsuite> (also written by the children).
+	int num_of_failures;
+	int num_of_skipped;
+	double start_time;
+} junit_data;
+
+//Local auxiliary functions:
+static void junit_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void junit_assert(ctest_reporter *reporter, const assert_result_struct *result, char status);
+static void junit_module_end(ctest_reporter *reporter, const ctest_module_stats *stats);
+static void junit_suite_end(ctest_reporter *reporter, const ctest_suite_stats *stats);
+static void junit_delete(ctest_reporter *reporter);
+static void open_testsuite(junit_data *data, const char name[], bool is_implicit);
+static void close_testsuite(junit_data *data, int tests, int failures, int skipped, double time);
+static void close_implicit_testsuite(junit_data *data);
+static size_t format_testsuite_tag(junit_data *data, int tests, int failures, int skipped, double time, char str[], size_t size);
+
+
+//Function definitions:
+ctest_reporter *reporter_junit_create(char path[])
+/**
+ * Description: This function creates a JUnit XML reporter (see the description
+ * of this file) that writes to 'path'. It must be registered with reporter_add().
+ *
+ * Memory allocation: The user must call reporter_delete after using the reporter.
+ * It writes the end of the report and closes the file.
+ *
+ * Input: (char []) path --> The path of the report ("-" for the standard output).
+ *
+ * Output: (ctest_reporter *) --> The reporter.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	ctest_reporter *reporter = malloc(sizeof *reporter);
+	junit_data *data = reporter_alloc_shared(sizeof *data);
+
+	if(reporter == NULL)
+	{
+		fprintf(stderr, "Error while allocating the JUnit reporter.\n");
+		exit(EXIT_FAILURE);
+	}
+	data->file = reporter_open_file(path);
+	data->header_offset = -1;
+	fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n", data->file);
+
+	reporter->on_suite_start  = NULL;
+	reporter->on_module_start = junit_module_start;
+	reporter->on_assert       = junit_assert;
+	reporter->on_module_end   = junit_module_end;
+	reporter->on_suite_end    = junit_suite_end;
+	reporter->on_delete       = junit_delete;
+	reporter->data            = data;
+	reporter->on_failures_suppressed = NULL;
+	reporter->on_assert_stats        = NULL;
+	reporter->on_bench               = NULL;
+	reporter->on_bench_comparison    = NULL;
+	reporter->on_warning             = NULL;
+	return reporter;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void junit_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+{
+	junit_data *data = reporter->data;
+
+	close_implicit_testsuite(data);
+	open_testsuite(data, name, false);
+}
+
+
+static void junit_assert(ctest_reporter *reporter, const assert_result_struct *result, char status)
+/**
+ * Description: This function writes the <testcase> of the result. A result
+ * outside a <testsuite> opens one.
+ */
+{
+	junit_data *data = reporter->data;
+	FILE *file = data->file;
+
+	if(!data->is_testsuite_open)
+		open_testsuite(data, suite_ctest_info.module_name[0] != '\0' ? suite_ctest_info.module_name : suite_ctest_info.suite_name, true);
+	data->num_of_tests++;
+	data->num_of_failures += status == REPORT_FAIL || status == REPORT_ERROR;
+	data->num_of_skipped  += status == REPORT_IGNORED;
+
+	fputs("    <testcase name=\"", file);
+	reporter_write_xml_string(file, result->assert_name);
+	fprintf(file, " (line %d)\" classname=\"", result->line_number);
+	reporter_write_xml_string(file, suite_ctest_info.suite_name);
+	putc('.', file);
+	reporter_write_xml_string(file, data->testsuite_name);
+	switch(status)
+	{
+		case REPORT_SUCCESS:
+			fputs("\"/>\n", file);
+			break;
+		case REPORT_IGNORED:
+			fputs("\">\n      <skipped/>\n    </testcase>\n", file);
+			break;
+		default:
+			fputs("\">\n      <failure message=\"", file);
+			reporter_write_xml_string(file, result->std_message);
+			fprintf(file, "\" type=\"%s\">", status == REPORT_ERROR ? "error" : "failure");
+			if(result->custom_message != NULL)
+			{
+				reporter_write_xml_string(file, result->custom_message);
+				putc('\n', file);
+			}
+			reporter_write_xml_string(file, result->result_details);
+			fputs("</failure>\n    </testcase>\n", file);
+	}
+	reporter_flush_in_child(file);
+}
+
+
+static void junit_module_end(ctest_reporter *reporter, const ctest_module_stats *stats)
+{
+	junit_data *data = reporter->data;
+
+	if(data->is_implicit) close_implicit_testsuite(data);
+	else if(data->is_testsuite_open) close_testsuite(data, data->num_of_tests, data->num_of_failures, data->num_of_skipped, stats->wall_time);
+}
+
+
+static void junit_suite_end(ctest_reporter *reporter, const ctest_suite_stats *stats)
+{
+	close_implicit_testsuite(reporter->data);
+}
+
+
+static void junit_delete(ctest_reporter *reporter)
+/**
+ * Description: This function ends the report and closes the file.
+ */
+{
+	junit_data *data = reporter->data;
+
+	close_implicit_testsuite(data);
+	if(data->is_testsuite_open) close_testsuite(data, 0, 0, 0, 0);
+	fputs("</testsuites>\n", data->file);
+	reporter_close_file(data->file);
+	reporter_free_shared(data, sizeof *data);
+}
+
+
+static void open_testsuite(junit_data *data, const char name[], bool is_implicit)
+/**
+ * Description: This function writes the <testsuite> tag with the placeholders
+ * of the counters and keeps its position.
+ */
+{
+	char tag[512];
+	size_t length;
+
+	snprintf(data->testsuite_name, MAX_NAME, "%s", name);
+	data->is_testsuite_open = true;
+	data->is_implicit       = is_implicit;
+	data->num_of_tests      = 0;
+	data->num_of_failures   = 0;
+	data->num_of_skipped    = 0;
+	data->start_time        = bench_get_time();
+	//The offset of the descriptor, since a child of a module may have written to it:
+	data->header_offset     = fflush(data->file) == 0 ? (long) lseek(fileno(data->file), 0, SEEK_CUR) : -1;
+	length = format_testsuite_tag(data, 0, 0, 0, 0, tag, sizeof tag);
+	fwrite(tag, 1, length, data->file);
+}
+
+
+static void close_testsuite(junit_data *data, int tests, int failures, int skipped, double time)
+/**
+ * Description: This function overwrites the counters of the open <testsuite> and
+ * closes it.
+ */
+{
+	char tag[512];
+	size_t length;
+
+	if(data->header_offset >= 0 && fflush(data->file) == 0)
+	{
+		length = format_testsuite_tag(data, tests, failures, skipped, time, tag, sizeof tag);
+		if(pwrite(fileno(data->file), tag, length, data->header_offset) != (ssize_t) length)
+		{
+			fprintf(stderr, "Error while writing the JUnit report.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	fputs("  </testsuite>\n", data->file);
+	data->is_testsuite_open = false;
+}
+
+
+static void close_implicit_testsuite(junit_data *data)
+/**
+ * Description: This function closes the <testsuite> opened by a result, if it is
+ * open.
+ */
+{
+	if(!data->is_testsuite_open || !data->is_implicit) return;
+	close_testsuite(data, data->num_of_tests, data->num_of_failures, data->num_of_skipped, bench_get_time() - data->start_time);
+}
+
+
+static size_t format_testsuite_tag(junit_data *data, int tests, int failures, int skipped, double time, char str[], size_t size)
+/**
+ * Description: This function writes the <testsuite> tag in 'str' and returns its
+ * length. The length does not depend on the counters, so the tag may be
+ * overwritten in place.
+ */
+{
+	char name[6 * MAX_NAME], package[6 * MAX_NAME];
+	FILE *stream;
+	int n;
+
+	//Escape the names in memory:
+	stream = fmemopen(name, sizeof name, "w");
+	if(stream != NULL)
+	{
+		reporter_write_xml_string(stream, data->testsuite_name);
+		fclose(stream);
+	}
+	stream = fmemopen(package, sizeof package, "w");
+	if(stream != NULL)
+	{
+		reporter_write_xml_string(stream, suite_ctest_info.suite_name);
+		fclose(stream);
+	}
+
+	n = snprintf(str, size, "  <testsuite name=\"%s\" package=\"%s\" tests=\"%010d\" failures=\"%010d\" errors=\"0000000000\" skipped=\"%010d\" time=\"%017.6f\">\n",
+			name, package, tests, failures, skipped, time);
+	if(n < 0) return 0;
+	return (size_t) n < size ? (size_t) n : size - 1;
+}
@@ -0,0 +1,193 @@
+/**
+ * Title: REPORTER TAP
+ */
+
+/**
+ * Description: This file contains the TAP version 13 reporter. Each result is a
+ * test point ("ok" or "not ok", numbered from 1 across the suites); ignored
+ * results have the SKIP directive and fails/errors have a YAML block with the
+ * messages and the details. The suites and the modules are written as comments.
+ * The plan ("1..N") is written at the end, by reporter_delete(). The results that
+ * are only counted (the successes with the SILENT verbosity and the fails beyond
+ * max_failures_per_site, written as one comment per site) have no test point, so
+ * the test points are numbered by a counter of the reporter, in memory shared
+ * with the child processes that write test points too.
+ */
+
+//Includes:
+#include "globals.h"
+#include "reporter.h"
+#include "ctest_functions.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "internal_alloc.h" //Must be the last include.
+
+//Definition of types:
+typedef struct {
+	FILE *file;
+	int num_of_points; //Test points written (by this process and its children).
+} tap_data;
+
+//Local auxiliary functions:
+static void tap_suite_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void tap_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[]);
+static void tap_assert(ctest_reporter *reporter, const assert_result_struct *result, char status);
+static void tap_failures_suppressed(ctest_reporter *reporter, const char assert_name[], int line_number, int num_of_suppressed);
+static void tap_delete(ctest_reporter *reporter);
+static void write_description(FILE *file, const char str[]);
+static void write_yaml_block(FILE *file, const char key[], const char str[]);
+
+
+//Function definitions:
+ctest_reporter *reporter_tap_create(char path[])
+/**
+ * Description: This function creates a TAP 13 reporter (see the description of
+ * this file) that writes to 'path'. It must be registered with reporter_add().
+ *
+ * Memory allocation: The user must call reporter_delete after using the reporter.
+ * It writes the plan and closes the file.
+ *
+ * Input: (char []) path --> The path of the report ("-" for the standard output).
+ *
+ * Output: (ctest_reporter *) --> The reporter.
+ *
+ * Error handling: If an error occurs, this function prints an error message and
+ * exits a failure code.
+ *
+ * Time Complexity: O(1)
+ *
+ * Space Complexity: O(1)
+ */
+{
+	ctest_reporter *reporter = malloc(sizeof *reporter);
+	tap_data *data = reporter_alloc_shared(sizeof *data);
+
+	if(reporter == NULL)
+	{
+		fprintf(stderr, "Error while allocating the TAP reporter.\n");
+		exit(EXIT_FAILURE);
+	}
+	data->file = reporter_open_file(path);
+	fputs("TAP version 13\n", data->file);
+
+	reporter->on_suite_start  = tap_suite_start;
+	reporter->on_module_start = tap_module_start;
+	reporter->on_assert       = tap_assert;
+	reporter->on_module_end   = NULL;
+	reporter->on_suite_end    = NULL;
+	reporter->on_delete       = tap_delete;
+	reporter->data            = data;
+	reporter->on_failures_suppressed = tap_failures_suppressed;
+	reporter->on_assert_stats        = NULL;
+	reporter->on_bench               = NULL;
+	reporter->on_bench_comparison    = NULL;
+	reporter->on_warning             = NULL;
+	return reporter;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void tap_suite_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+{
+	tap_data *data = reporter->data;
+
+	fputs("# Suite: ", data->file);
+	write_description(data->file, name);
+	putc('\n', data->file);
+}
+
+
+static void tap_module_start(ctest_reporter *reporter, const char name[], const char description[], char *func_ids[])
+{
+	tap_data *data = reporter->data;
+
+	fputs("# Module: ", data->file);
+	write_description(data->file, name);
+	putc('\n', data->file);
+}
+
+
+static void tap_assert(ctest_reporter *reporter, const assert_result_struct *result, char status)
+/**
+ * Description: This function writes the test point of the result, numbered
+ * after the test points already written.
+ */
+{
+	tap_data *data = reporter->data;
+	FILE *file = data->file;
+	bool is_fail = status == REPORT_FAIL || status == REPORT_ERROR;
+
+	fprintf(file, "%s %d - ", is_fail ? "not ok" : "ok", ++data->num_of_points);
+	write_description(file, result->assert_name);
+	fprintf(file, " (line %d)", result->line_number);
+	if(status == REPORT_IGNORED) fputs(" # SKIP ignored", file);
+	putc('\n', file);
+	if(is_fail)
+	{
+		fputs("  ---\n", file);
+		write_yaml_block(file, "message", result->std_message);
+		if(result->custom_message != NULL) write_yaml_block(file, "custom_message", result->custom_message);
+		fprintf(file, "  severity: %s\n", status == REPORT_ERROR ? "error" : "fail");
+		write_yaml_block(file, "details", result->result_details);
+		fputs("  ...\n", file);
+	}
+	reporter_flush_in_child(file);
+}
+
+
+static void tap_failures_suppressed(ctest_reporter *reporter, const char assert_name[], int line_number, int num_of_suppressed)
+{
+	tap_data *data = reporter->data;
+
+	fprintf(data->file, "# +%d more failures of ", num_of_suppressed);
+	write_description(data->file, assert_name);
+	fprintf(data->file, " at line %d\n", line_number);
+	reporter_flush_in_child(data->file);
+}
+
+
+static void tap_delete(ctest_reporter *reporter)
+/**
+ * Description: This function writes the plan and closes the file.
+ */
+{
+	tap_data *data = reporter->data;
+
+	fprintf(data->file, "1..%d\n", data->num_of_points);
+	reporter_close_file(data->file);
+	reporter_free_shared(data, sizeof *data);
+}
+
+
+static void write_description(FILE *file, const char str[])
+/**
+ * Description: This function writes 'str' in one line, without the char '#'
+ * (which starts a directive).
+ */
+{
+	for(; *str != '\0'; str++)
+	{
+		if(*str == '#') fputs("\\#", file);
+		else putc(*str == '\n' || *str == '\r' ? ' ' : *str, file);
+	}
+}
+
+
+static void write_yaml_block(FILE *file, const char key[], const char str[])
+/**
+ * Description: This function writes 'str' as a literal block scalar of YAML.
+ */
+{
+	char last = '\0';
+
+	fprintf(file, "  %s: |\n    ", key);
+	for(; *str != '\0'; str++)
+	{
+		putc(*str, file);
+		if(*str == '\n' && str[1] != '\0') fputs("    ", file);
+		last = *str;
+	}
+	if(last != '\n') putc('\n', file);
+}
@@ -3,6 +3,7 @@
 
 //Include libs:
 #include <stdbool.h>
+#include <stddef.h>
 
 
 
@@ -10,18 +11,21 @@
 #define HIGH 2
 #define MEDIUM 1
 #define LOW 0
+#define SILENT -1            //Only the fails and the summary of the suite are printed; a success is only counted.
 #define MAX_RESULTS 500      //Maximum number of results per module.
 
 //Definition of types:
 typedef struct {
 	bool print_progress; //Says if it is necessary to print 'Progress: %s'.
 	char progress[MAX_RESULTS + 1];
+	int progress_length; //Chars in 'progress' (the results that are only counted are not in it).
 	int num_of_results;
 	int num_of_fails;
 	int total_results;
 	int total_fails;
 	int num_of_ignored; 
         int total_ignored;
+	int last_line_number; //Line of the last assertion of the module.
 } ctest_info_struct;
 
 typedef long long int integer;
@@ -31,6 +35,11 @@ typedef double floating_point;
 //Declare global Variables:
 extern bool ignore;
 extern int verbose;
+extern int result_pipe_fd; //If >= 0, each result is also sent to this pipe (child processes).
+extern int max_failures_per_site; //Fails reported per site (assert name and line) of a module; the next ones are only counted (<= 0: no limit).
+extern int assert_num_of_threads; //Threads of the scans of large arrays (0: one per online CPU; 1: serial), see parallel.c.
+extern size_t assert_parallel_threshold; //Minimum number of elements of an array scanned by several threads.
+extern bool collect_assert_stats; //If true when the suite starts, the statistics of each call site are collected (see assert_stats.c).
 extern ctest_info_struct ctest_info;
 
 #endif
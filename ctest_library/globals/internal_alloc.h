@@ -0,0 +1,20 @@
+#ifndef _CTEST_INTERNAL_ALLOC_H
+#define _CTEST_INTERNAL_ALLOC_H
+
+/**
+ * Description: This header makes the allocations of a source file of ctest
+ * invisible to the allocation hooks (see alloc_hooks.c). It must be the last
+ * include of the file, after every system header, and it must not be included
+ * by the tests.
+ */
+
+//Includes:
+#include <stdlib.h>
+#include "alloc_hooks.h"
+
+//Macros:
+#define malloc(SIZE) ctest_internal_malloc(SIZE)
+#define calloc(NUM_OF_ELEMENTS, SIZE) ctest_internal_calloc((NUM_OF_ELEMENTS), (SIZE))
+#define realloc(PTR, SIZE) ctest_internal_realloc((PTR), (SIZE))
+#define free(PTR) ctest_internal_free(PTR)
+#endif
@@ -0,0 +1,98 @@
+/**
+ * Description: This program compares the cost per module of the isolation modes
+ * of ctest: no isolation (start_module), in-process crash containment
+ * (CTEST_MODULE) and one child process per module (CTEST_FIXTURE_CHECKPOINT).
+ * The output of the suites is discarded and only the timings are printed.
+ */
+#define _GNU_SOURCE
+#include "ctest.h"
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NUM_OF_MODULES 2000
+
+typedef enum {NO_ISOLATION, CRASH_CONTAINMENT, FORK_PER_MODULE} isolation_mode;
+
+static double run_suite(isolation_mode mode);
+static double now();
+
+int main(void)
+{
+	double no_isolation, crash_containment, fork_per_module;
+	int stdout_fd, null_fd;
+
+	//Discard the output of the suites:
+	fflush(stdout);
+	stdout_fd = dup(STDOUT_FILENO);
+	null_fd = open("/dev/null", O_WRONLY);
+	if(stdout_fd < 0 || null_fd < 0)
+	{
+		fprintf(stderr, "Error while redirecting stdout.\n");
+		exit(EXIT_FAILURE);
+	}
+	dup2(null_fd, STDOUT_FILENO);
+
+	no_isolation      = run_suite(NO_ISOLATION);
+	crash_containment = run_suite(CRASH_CONTAINMENT);
+	fork_per_module   = run_suite(FORK_PER_MODULE);
+
+	fflush(stdout);
+	dup2(stdout_fd, STDOUT_FILENO);
+	close(null_fd);
+	close(stdout_fd);
+
+	printf("Cost per module (%d modules with one assert each):\n", NUM_OF_MODULES);
+	printf("    no isolation      (start_module)             : %10.3f us\n", no_isolation * 1e6);
+	printf("    crash containment (CTEST_MODULE)             : %10.3f us (+%.3f us)\n", crash_containment * 1e6, (crash_containment - no_isolation) * 1e6);
+	printf("    fork per module   (CTEST_FIXTURE_CHECKPOINT) : %10.3f us (+%.3f us)\n", fork_per_module * 1e6, (fork_per_module - no_isolation) * 1e6);
+	return 0;
+}
+
+
+static double run_suite(isolation_mode mode)
+/**
+ * Description: This function executes NUM_OF_MODULES modules in 'mode' and
+ * returns the mean time per module in seconds.
+ */
+{
+	double start, time_per_module;
+	int i;
+
+	start_suite("Benchmark", "Isolation modes.", NULL);
+	if(mode == FORK_PER_MODULE) CTEST_FIXTURE_CHECKPOINT();
+
+	start = now();
+	for(i = 0; i < NUM_OF_MODULES; i++)
+	{
+		if(mode == CRASH_CONTAINMENT)
+		{
+			CTEST_MODULE("Module", "Benchmark module.", NULL)
+			{
+				assert_integer_equal(i, i, __LINE__, NULL);
+			}
+			end_module();
+		}
+		else
+		{
+			if(start_module("Module", "Benchmark module.", NULL))
+			{
+				assert_integer_equal(i, i, __LINE__, NULL);
+			}
+			end_module();
+		}
+	}
+	time_per_module = (now() - start) / NUM_OF_MODULES;
+
+	end_suite();
+	return time_per_module;
+}
+
+
+static double now()
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
@@ -1,4 +1,8 @@
 #include "ctest.h"
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #define UI (unsigned int[])
 #define UC (unsigned char[])
@@ -10,6 +14,75 @@
 #define ASC true
 #define DSC false
 
+//Generator of the streaming reference: the bytes i * 131 + 7 up to *(size_t *) limit.
+static size_t generate_stream(void *buffer, size_t size, size_t offset, void *limit)
+{
+	size_t i;
+
+	for(i = 0; i < size && offset + i < *(size_t *) limit; i++) ((unsigned char *) buffer)[i] = (unsigned char) ((offset + i) * 131 + 7);
+	return i;
+}
+
+//Checks a TAP report like a TAP parser: the test points are numbered from 1 in order and the plan is their number. Returns the number of test points (-1 if the report is not valid).
+static int check_tap_report(const char path[])
+{
+	char line[1 << 10];
+	int num_of_points = 0, number, plan = -1;
+	bool is_valid = true;
+	FILE *file = fopen(path, "r");
+
+	if(file == NULL) return -1;
+	while(fgets(line, sizeof line, file) != NULL)
+	{
+		if(sscanf(line, "ok %d", &number) == 1 || sscanf(line, "not ok %d", &number) == 1) is_valid = is_valid && number == ++num_of_points;
+		else if(sscanf(line, "1..%d", &plan) == 1) is_valid = is_valid && plan == num_of_points;
+	}
+	fclose(file);
+	return is_valid && plan == num_of_points ? num_of_points : -1;
+}
+
+//Counts the <testcase> elements of a JUnit report and reads the counter 'tests' of its first <testsuite>:
+static int count_junit_testcases(const char path[], int *tests)
+{
+	static char report[1 << 16];
+	char *position;
+	int num_of_testcases = 0;
+	FILE *file = fopen(path, "r");
+
+	*tests = -1;
+	if(file == NULL) return -1;
+	report[fread(report, 1, sizeof report - 1, file)] = '\0';
+	fclose(file);
+	for(position = strstr(report, "<testcase "); position != NULL; position = strstr(position + 1, "<testcase ")) num_of_testcases++;
+	position = strstr(report, " tests=\"");
+	if(position != NULL) *tests = atoi(position + strlen(" tests=\""));
+	return num_of_testcases;
+}
+
+//Functions for CTEST_BENCH_COMPARE:
+static void loop_10(void *input)
+{
+	for(volatile int i = 0; i < 10; i++);
+}
+
+static void loop_1000(void *input)
+{
+	for(volatile int i = 0; i < 1000; i++);
+}
+
+//Functions for ASSERT_COMPLEXITY:
+static void linear_loop(void *input, size_t n)
+{
+	for(volatile size_t i = 0; i < n; i++);
+}
+
+static void quadratic_loop(void *input, size_t n)
+{
+	for(volatile size_t i = 0; i < n; i++)
+		for(volatile size_t j = 0; j < n; j++);
+}
+
+
 int main(void)
 {
 
@@ -26,6 +99,41 @@ int main(void)
 		"ASSERT_UI_ARRAY_NOT_IS_PP",
 		"ASSERT_UI_ARRAY_HAS_PP",
 		"ASSERT_UI_ARRAY_NOT_HAS_PP",
+		//I/O:
+		"WITH_ASSERT_STDOUT_EQUAL",
+		"WITH_ASSERT_STDERR_EQUAL",
+		"WITH_ASSERT_STREAM_OUT_EQUAL",
+		"WITH_ASSERT_EXIT_STATUS_EQUAL",
+		"WITH_ASSERT_EXIT_STATUS_NOT_EQUAL",
+		"WITH_ASSERT_SIGNAL_EQUAL",
+		//Allocations:
+		"WITH_ASSERT_MAX_ALLOCATIONS",
+		"WITH_ASSERT_MAX_BYTES_ALLOCATED",
+		"CTEST_FAIL_ON_LEAK",
+		//Benchmarks:
+		"CTEST_BENCH (baseline)",
+		"ASSERT_FASTER_BY",
+		"ASSERT_COMPLEXITY",
+		"assert_latency_percentileLess",
+		"ASSERT_INSTRUCTIONS_PER_ITEM_LESS",
+		//Failures:
+		"max_failures_per_site",
+		//Batches:
+		"CTEST_BATCH_BEGIN",
+		"CTEST_BATCH_END",
+		//Digests:
+		"assert_buffer_digestEqual",
+		"assert_digest_equal",
+		//Streams:
+		"ctest_stream_begin",
+		"ctest_stream_feed",
+		"ctest_stream_end",
+		//Matrices:
+		"assert_integerMatrix_equal",
+		"assert_floating_pointMatrix_almostEqual",
+		//Fixtures:
+		"CTEST_FIXTURE_CHECKPOINT",
+		"CTEST_MODULE",
 		//integer type:
 		//floating_point type:
 		//bool type:
@@ -278,6 +386,485 @@ int main(void)
 
 
 
+		/*I/O*/
+		//---------------------------WITH_ASSERT_STDOUT_EQUAL-------------------------
+		//Tests that will fail:
+		start_module("WITH STDOUT-equal", "Every assert in this module must fail.", (char *[]){"WITH_ASSERT_STDOUT_EQUAL", NULL});
+
+			verbose = LOW;
+			WITH_ASSERT_STDOUT_EQUAL("Hello world!\n", __LINE__, NULL)
+			{
+				printf("Hello World!\n");
+			}END_WITH;
+
+			verbose = MEDIUM;
+			WITH_ASSERT_STDOUT_EQUAL("Hello world!\n", __LINE__, "Wrong case")
+			{
+				printf("Hello World!\n");
+			}END_WITH;
+
+			verbose = HIGH;
+			WITH_ASSERT_STDOUT_EQUAL("Hello world!\n", __LINE__, "Wrong case")
+			{
+				printf("Hello World!\n");
+			}END_WITH;
+			WITH_ASSERT_STDOUT_EQUAL("Hello world!\n", __LINE__, "Missing output")
+			{
+			}END_WITH;
+			WITH_ASSERT_STDOUT_EQUAL("The first line is equal.\nThe second\tone is not.\n", __LINE__, "Long output")
+			{
+				printf("The first line is equal.\nThe second one is not.\nAnd there is a third line.\n");
+			}END_WITH;
+			WITH_ASSERT_STDOUT_EQUAL("before break and after break", __LINE__, "Early exit with break")
+			{
+				printf("before break");
+				break;
+				printf(" and after break");
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------------WITH_ASSERT_STDERR_EQUAL-------------------------
+		//Tests that will fail:
+		start_module("WITH STDERR-equal", "Every assert in this module must fail.", (char *[]){"WITH_ASSERT_STDERR_EQUAL", NULL});
+
+			WITH_ASSERT_STDERR_EQUAL("Error: 42.\n", __LINE__, NULL)
+			{
+				fprintf(stderr, "Error: %d.\n", 43);
+			}END_WITH;
+			WITH_ASSERT_STDERR_EQUAL("", __LINE__, "Nothing should be written")
+			{
+				fprintf(stderr, "\a\x01");
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-------------------------WITH_ASSERT_STREAM_OUT_EQUAL-----------------------
+		//Tests that will fail:
+		start_module("WITH STREAM_OUT-equal", "Every assert in this module must fail.", (char *[]){"WITH_ASSERT_STREAM_OUT_EQUAL", NULL});
+
+			char fmem_buffer[64];
+			FILE *fmem_stream = fmemopen(fmem_buffer, sizeof fmem_buffer, "w");
+			WITH_ASSERT_STREAM_OUT_EQUAL(fmem_stream, "memory stream\n", __LINE__, "Stream without file descriptor")
+			{
+				fprintf(fmem_stream, "memory\n");
+			}END_WITH;
+			fclose(fmem_stream);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Exit status and signals*/
+		//-----------------------WITH_ASSERT_EXIT_STATUS_EQUAL------------------------
+		//Tests that will fail:
+		start_module("WITH EXIT_STATUS-equal", "Every assert in this module must fail.", (char *[]){"WITH_ASSERT_EXIT_STATUS_EQUAL", NULL});
+
+			verbose = LOW;
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_FAILURE, __LINE__, NULL)
+			{
+			}END_WITH;
+
+			verbose = MEDIUM;
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_FAILURE, __LINE__, "The end of the block is reached")
+			{
+			}END_WITH;
+
+			verbose = HIGH;
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_FAILURE, __LINE__, "The end of the block is reached")
+			{
+			}END_WITH;
+			WITH_ASSERT_EXIT_STATUS_EQUAL(2, __LINE__, "Assertion inside the block fails too")
+			{
+				assert_integer_equal(1, 2, __LINE__, "Made by the child");
+				exit(3);
+			}END_WITH;
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_SUCCESS, __LINE__, "Terminated by a signal")
+			{
+				abort();
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------WITH_ASSERT_EXIT_STATUS_NOT_EQUAL----------------------
+		//Tests that will fail:
+		start_module("WITH EXIT_STATUS-notEqual", "Every assert in this module must fail.", (char *[]){"WITH_ASSERT_EXIT_STATUS_NOT_EQUAL", NULL});
+
+			WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(EXIT_SUCCESS, __LINE__, NULL)
+			{
+			}END_WITH;
+			WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(EXIT_SUCCESS, __LINE__, "Terminated by a signal")
+			{
+				raise(SIGTERM);
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//--------------------------WITH_ASSERT_SIGNAL_EQUAL--------------------------
+		//Tests that will fail:
+		start_module("WITH SIGNAL-equal", "Every assert in this module must fail.", (char *[]){"WITH_ASSERT_SIGNAL_EQUAL", NULL});
+
+			WITH_ASSERT_SIGNAL_EQUAL(SIGSEGV, __LINE__, NULL)
+			{
+			}END_WITH;
+			WITH_ASSERT_SIGNAL_EQUAL(SIGSEGV, __LINE__, "Wrong signal")
+			{
+				abort();
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Failures*/
+		//----------------------------max_failures_per_site---------------------------
+		//Tests that will fail:
+		ctest_reporter *dedup_tap_reporter = reporter_tap_create("test_tmp/dedup.tap");
+		ctest_reporter *dedup_junit_reporter = reporter_junit_create("test_tmp/dedup.xml");
+
+		reporter_add(dedup_tap_reporter);
+		reporter_add(dedup_junit_reporter);
+		start_module("FAILURE DEDUP", "Every assert in this module must fail. Only the first fails of each line are printed.", (char *[]){"max_failures_per_site", NULL});
+
+			for(int i = 0; i < 1000; i++) assert_integer_equal(i, -1, __LINE__, "Failed in a loop");
+			WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(EXIT_SUCCESS, __LINE__, "The child reports its own sites")
+			{
+				for(int i = 0; i < 20; i++) assert_integer_equal(i, -1, __LINE__, NULL);
+			}END_WITH;
+
+		end_module();
+		reporter_delete(dedup_tap_reporter);
+		reporter_delete(dedup_junit_reporter);
+
+		start_module("FAILURE DEDUP-reports", "Every assert in this module must fail. The reports of the previous module have a test point per printed fail.", (char *[]){"max_failures_per_site", "reporter_tap_create", "reporter_junit_create", NULL});
+
+			int dedup_junit_tests;
+
+			assert_integer_notEqual(check_tap_report("test_tmp/dedup.tap"), 21, __LINE__, "10 + 10 printed fails and the WITH block");
+			assert_integer_notEqual(count_junit_testcases("test_tmp/dedup.xml", &dedup_junit_tests), 21, __LINE__, NULL);
+			assert_integer_notEqual(dedup_junit_tests, 21, __LINE__, "tests is the number of testcases");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Batches*/
+		//------------------------------CTEST_BATCH_BEGIN-----------------------------
+		//Tests that will fail:
+		start_module("CTEST_BATCH", "Every assert in this module must fail. Each failing expectation is one result.", (char *[]){"CTEST_BATCH_BEGIN", "CTEST_BATCH_END", NULL});
+
+			CTEST_BATCH_BEGIN();
+			for(int i = 0; i < 2 * CTEST_BATCH_SIZE; i++) BATCH_EXPECT_UNSIGNED_INTEGER_LESS(i, 2 * CTEST_BATCH_SIZE - 1, __LINE__);
+			BATCH_EXPECT_INTEGER_GREATER(-1, 1, __LINE__);
+			for(int i = 0; i < 5; i++) BATCH_EXPECT_INTEGER_EQUAL(i, 2, __LINE__);
+			CTEST_BATCH_END(__LINE__, "Only the failing expectations are reported");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Digests*/
+		//----------------------------------DIGESTS-----------------------------------
+		//Tests that will fail:
+		start_module("DIGESTS", "Every assert in this module must fail. The details show the computed digest.", (char *[]){"assert_buffer_digestEqual", "assert_digest_equal", NULL});
+
+			ctest_digest digest;
+
+			assert_buffer_digestEqual("abd", 3, "8f7aaae8f97cd64d417ad8ffc542ef16", __LINE__, "Other bytes");
+			assert_buffer_digestEqual("abc", 3, "8f7aaae8f97cd64d417ad8ffc542ef1", __LINE__, "Not a digest (31 digits)");
+			digest_init(&digest, DIGEST_SHA256);
+			digest_update(&digest, "abc", 3);
+			assert_digest_equal(&digest, "8f7aaae8f97cd64d417ad8ffc542ef16", __LINE__, "The digest of another algorithm");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Streams*/
+		//--------------------------------CTEST_STREAM--------------------------------
+		//Tests that will fail:
+		start_module("CTEST_STREAM", "Every assert in this module must fail. The details show the offset of the first mismatch.", (char *[]){"ctest_stream_begin", "ctest_stream_feed", "ctest_stream_end", NULL});
+
+			size_t stream_size = 10;
+			unsigned char stream_chunk[12];
+			FILE *stream_file = fopen("test_tmp/stream_fail.bin", "wb");
+
+			fputs("abcdef", stream_file);
+			fclose(stream_file);
+			ctest_stream_begin(stream_source_memory("abcdef", 6));
+			ctest_stream_feed("abc", 3);
+			ctest_stream_feed("dXf", 3);
+			ctest_stream_feed("ghi", 3);
+			ctest_stream_end(__LINE__, "Mismatch at offset 4");
+			generate_stream(stream_chunk, sizeof stream_chunk, 0, &(size_t){sizeof stream_chunk});
+			ctest_stream_begin(stream_source_generator(generate_stream, &stream_size));
+			ctest_stream_feed(stream_chunk, sizeof stream_chunk);
+			ctest_stream_end(__LINE__, "The reference ends at offset 10");
+			ctest_stream_begin(stream_source_file("test_tmp/stream_fail.bin"));
+			ctest_stream_feed("abc", 3);
+			ctest_stream_end(__LINE__, "The stream ends at offset 3");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Matrices*/
+		//----------------------------------MATRICES----------------------------------
+		//Tests that will fail:
+		start_module("MATRICES", "Every assert in this module must fail. The mismatches are reported by (row, col).", (char *[]){"assert_integerMatrix_equal", "assert_floating_pointMatrix_almostEqual", NULL});
+
+			integer row_major[] = {1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11, -12};
+			integer col_major[] = {1, 5, 9, -2, -6, 10, 3, 7, 11, -4, -8, 12};
+			floating_point matrix[100 * 70] = {0}, zeros[100 * 70] = {0}, nan = 0.0 / 0.0;
+
+			assert_integerMatrix_equal(MATRIX_VIEW(row_major, 3, 4, 4), MATRIX_STRIDED_VIEW(col_major, 3, 4, 1, 3), __LINE__, "Mismatches at (2, 1) and (2, 3)");
+			assert_integerMatrix_equal(MATRIX_VIEW(row_major, 3, 4, 4), MATRIX_VIEW(row_major, 4, 3, 3), __LINE__, "Different sizes");
+			for(size_t i = 0; i < 100; i++) matrix[i * 70 + i * 7 % 70] = 1e-3 * i;
+			matrix[1] = nan;
+			assert_floating_pointMatrix_almostEqual(MATRIX_VIEW(matrix, 100, 70, 70), MATRIX_STRIDED_VIEW(zeros, 100, 70, 1, 100), 1e-9, __LINE__, "99 differences and a NaN");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Crash containment*/
+		//--------------------------------CTEST_MODULE--------------------------------
+		//Tests that will fail:
+		CTEST_MODULE("CONTAINED-segfault", "Every assert in this module must fail. The module crashes.", ((char *[]){"CTEST_MODULE", NULL}))
+		{
+			volatile int *null_pointer = NULL;
+			assert_integer_equal(1, 2, __LINE__, "Failed before the crash");
+			*null_pointer = 1;
+			assert_integer_equal(1, 1, __LINE__, "Never executed");
+		}
+		end_module();
+
+		CTEST_MODULE("CONTAINED-abort", "Every assert in this module must fail. The module crashes.", ((char *[]){"CTEST_MODULE", NULL}))
+		{
+			abort();
+		}
+		end_module();
+
+		CTEST_MODULE("CONTAINED-fpe", "Every assert in this module must fail. The module crashes.", ((char *[]){"CTEST_MODULE", NULL}))
+		{
+			raise(SIGFPE);
+		}
+		end_module();
+
+		struct stat original_stdout, current_stdout;
+		fstat(STDOUT_FILENO, &original_stdout);
+		CTEST_MODULE("CONTAINED-capture", "Every assert in this module must fail. The module crashes inside a capture block.", ((char *[]){"CTEST_MODULE", "WITH_ASSERT_STDOUT_EQUAL", NULL}))
+		{
+			WITH_ASSERT_STDOUT_EQUAL("Never compared", __LINE__, NULL)
+			{
+				printf("Discarded by the crash");
+				raise(SIGSEGV);
+			}END_WITH;
+		}
+		end_module();
+
+		start_module("CONTAINED-capture-2", "Every assert in this module must fail. The crash of the previous module restored stdout.", (char *[]){"CTEST_MODULE", "WITH_ASSERT_STDOUT_EQUAL", NULL});
+
+			fstat(STDOUT_FILENO, &current_stdout);
+			assert_bool_false(current_stdout.st_dev == original_stdout.st_dev && current_stdout.st_ino == original_stdout.st_ino, __LINE__, "fd 1 is the original stdout again");
+			WITH_ASSERT_STDOUT_EQUAL("", __LINE__, "Only the output of this block is captured")
+			{
+				printf("After the crash");
+			}END_WITH;
+		end_module();
+
+		CTEST_MODULE("CONTAINED-batch", "Every assert in this module must fail. The module crashes inside a batch.", ((char *[]){"CTEST_MODULE", "CTEST_BATCH_BEGIN", NULL}))
+		{
+			CTEST_BATCH_BEGIN();
+			BATCH_EXPECT_INTEGER_EQUAL(1, 2, __LINE__);
+			raise(SIGSEGV);
+			CTEST_BATCH_END(__LINE__, NULL);
+		}
+		end_module();
+
+		start_module("CONTAINED-batch-2", "Every assert in this module must fail. The batch left open by the crash of the previous module was discarded.", (char *[]){"CTEST_MODULE", "CTEST_BATCH_BEGIN", "CTEST_BATCH_END", NULL});
+
+			CTEST_BATCH_BEGIN();
+			BATCH_EXPECT_INTEGER_EQUAL(3, 4, __LINE__);
+			CTEST_BATCH_END(__LINE__, "Only the expectation of this batch is reported");
+
+		end_module();
+
+		CTEST_MODULE("CONTAINED-stream", "Every assert in this module must fail. The module crashes inside a streaming session.", ((char *[]){"CTEST_MODULE", "ctest_stream_begin", NULL}))
+		{
+			ctest_stream_begin(stream_source_file("test_tmp/stream_fail.bin"));
+			ctest_stream_feed("abc", 3);
+			raise(SIGSEGV);
+			ctest_stream_end(__LINE__, NULL);
+		}
+		end_module();
+
+		start_module("CONTAINED-stream-2", "Every assert in this module must fail. The session left open by the crash of the previous module was closed.", (char *[]){"CTEST_MODULE", "ctest_stream_begin", "ctest_stream_end", NULL});
+
+			ctest_stream_begin(stream_source_memory("abc", 3));
+			ctest_stream_feed("abX", 3);
+			ctest_stream_end(__LINE__, "Only the chunk of this session is compared");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Allocations*/
+		//------------------------WITH_ASSERT_MAX_ALLOCATIONS-------------------------
+		//Tests that will fail:
+		start_module("WITH MAX-allocations", "Every assert in this module must fail.", (char *[]){"WITH_ASSERT_MAX_ALLOCATIONS", "WITH_ASSERT_MAX_BYTES_ALLOCATED", NULL});
+
+			WITH_ASSERT_MAX_ALLOCATIONS(0, __LINE__, NULL)
+			{
+				free(malloc(1));
+			}END_WITH;
+			WITH_ASSERT_MAX_BYTES_ALLOCATED(100, __LINE__, NULL)
+			{
+				char *buffer = malloc(64);
+				buffer = realloc(buffer, 128);
+				free(buffer);
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-----------------------------CTEST_FAIL_ON_LEAK-----------------------------
+		//Tests that will fail:
+		suite_ctest_info.fail_on_leak = true;
+		start_module("HEAP-leak", "Every assert in this module must fail. It leaks 100 bytes.", (char *[]){"CTEST_FAIL_ON_LEAK", NULL});
+
+			static void *leaked_block;
+			leaked_block = malloc(100);
+
+		end_module();
+		suite_ctest_info.fail_on_leak = false;
+
+		start_module("HEAP-failure sites", "Every assert in this module must fail. The table of the failure sites grows.", (char *[]){"CTEST_FAIL_ON_LEAK", NULL});
+
+			for(int i = 0; i < 100; i++) assert_integer_equal(i, -1, 100000 + i, "A new failure site");
+
+		end_module();
+
+		ctest_module_stats sites_module_stats = get_last_module_stats();
+		start_module("HEAP-failure sites stats", "Every assert in this module must fail. It checks the heap of the previous module.", (char *[]){"CTEST_FAIL_ON_LEAK", NULL});
+
+			assert_integer_notEqual(sites_module_stats.heap_delta, 0, __LINE__, "The table of the failure sites is not charged to the module");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Benchmarks*/
+		//---------------------------CTEST_BENCH (baseline)---------------------------
+		//Tests that will fail:
+		start_module("BENCH-baseline", "Every assert in this module must fail. The second run is slower than the baseline.", (char *[]){"CTEST_BENCH (baseline)", NULL});
+
+			bench_config.baseline_path = "test_tmp/bench_baseline.txt";
+			bench_config.update_baseline = true;
+			CTEST_BENCH("Loop")
+			{
+				for(volatile int i = 0; i < 10; i++);
+			}
+			bench_config.update_baseline = false;
+			CTEST_BENCH("Loop")
+			{
+				for(volatile int i = 0; i < 1000; i++);
+			}
+			bench_config.baseline_path = NULL;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//------------------------------ASSERT_FASTER_BY------------------------------
+		//Tests that will fail:
+		start_module("BENCH-compare", "Every assert in this module must fail.", (char *[]){"ASSERT_FASTER_BY", NULL});
+
+			CTEST_BENCH_COMPARE(loop_10, loop_1000, NULL);
+			ASSERT_FASTER_BY(1);
+			CTEST_BENCH_COMPARE(loop_1000, loop_10, NULL);
+			ASSERT_FASTER_BY(1000);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-----------------------------ASSERT_COMPLEXITY------------------------------
+		//Tests that will fail:
+		start_module("BENCH-complexity", "Every assert in this module must fail.", (char *[]){"ASSERT_COMPLEXITY", NULL});
+
+			ASSERT_COMPLEXITY(linear_loop, NULL, 256, 1 << 16, COMPLEXITY_O_LOG_N);
+			ASSERT_COMPLEXITY(quadratic_loop, NULL, 64, 1024, COMPLEXITY_O_N_LOG_N);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-----------------------assert_latency_percentileLess------------------------
+		//Tests that will fail:
+		start_module("LATENCY", "Every assert in this module must fail.", (char *[]){"assert_latency_percentileLess", NULL});
+
+			ctest_latency_recorder *recorder = latency_recorder_create();
+
+			assert_latency_percentileLess(recorder, 50, 1000, __LINE__, NULL); //No samples.
+			for(uint64_t i = 1; i <= 100000; i++) latency_recorder_record(recorder, i * i % 1000003);
+			latency_recorder_record(recorder, 5000000000);
+			assert_latency_percentileLess(recorder, 99, 500000, __LINE__, NULL);
+			assert_latency_percentileLess(recorder, 100, 5000000000, __LINE__, NULL);
+			latency_recorder_delete(recorder);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------ASSERT_INSTRUCTIONS_PER_ITEM_LESS----------------------
+		//Tests that will fail:
+		bench_config.perf_counters = true;
+		start_module("BENCH-perf counters", "Every assert in this module must fail. It is empty if the hardware counters are not available.", (char *[]){"ASSERT_INSTRUCTIONS_PER_ITEM_LESS", NULL});
+
+			CTEST_BENCH("Loop of 100 items")
+			{
+				CTEST_BENCH_SET_ITEMS(100);
+				for(volatile int i = 0; i < 100; i++);
+			}
+			if(get_last_bench_stats()->perf.is_available[PERF_COUNTER_INSTRUCTIONS])
+				ASSERT_INSTRUCTIONS_PER_ITEM_LESS(0.5);
+
+		end_module();
+		bench_config.perf_counters = false;
+		//----------------------------------------------------------------------------
+
+		/*Fixtures*/
+		//--------------------------CTEST_FIXTURE_CHECKPOINT--------------------------
+		//Tests that will fail:
+		CTEST_FIXTURE_CHECKPOINT();
+
+		if(start_module("FIXTURE CHECKPOINT-1", "Every assert in this module must fail. The module crashes.", (char *[]){"CTEST_FIXTURE_CHECKPOINT", NULL}))
+		{
+			assert_integer_equal(1, 2, __LINE__, "Failed before the crash");
+			raise(SIGSEGV);
+		}
+		end_module();
+
+		if(start_module("FIXTURE CHECKPOINT-2", "Every assert in this module must fail. The module exits.", (char *[]){"CTEST_FIXTURE_CHECKPOINT", NULL}))
+		{
+			exit(EXIT_FAILURE);
+		}
+		end_module();
+
+		CTEST_MODULE("FIXTURE CHECKPOINT-3", "Every assert in this module must fail. The crash is contained in the child.", ((char *[]){"CTEST_FIXTURE_CHECKPOINT", "CTEST_MODULE", NULL}))
+		{
+			assert_integer_equal(1, 2, __LINE__, NULL);
+			raise(SIGBUS);
+		}
+		end_module();
+
+		suite_ctest_info.fail_on_leak = true;
+		if(start_module("FIXTURE CHECKPOINT-4", "Every assert in this module must fail. The child leaks 100 bytes.", (char *[]){"CTEST_FIXTURE_CHECKPOINT", "CTEST_FAIL_ON_LEAK", NULL}))
+		{
+			leaked_block = malloc(100);
+		}
+		end_module();
+		suite_ctest_info.fail_on_leak = false;
+
+		if(start_module("FIXTURE CHECKPOINT-5", "Every assert in this module must fail. The child prints the first fails of the line.", (char *[]){"CTEST_FIXTURE_CHECKPOINT", "max_failures_per_site", NULL}))
+		{
+			for(int i = 0; i < 100; i++) assert_integer_equal(i, -1, __LINE__, NULL);
+		}
+		end_module();
+		//----------------------------------------------------------------------------
+
 	end_suite();
 	//----------------------------------------------------------------------------
 
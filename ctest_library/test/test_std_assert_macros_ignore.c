@@ -10,6 +10,13 @@
 #define ASC true
 #define DSC false
 
+//Functions for ASSERT_COMPLEXITY:
+static void linear_loop(void *input, size_t n)
+{
+	for(volatile size_t i = 0; i < n; i++);
+}
+
+
 int main(void)
 {
 	char *functions_tested[] = {
@@ -23,6 +30,21 @@ int main(void)
 		"ASSERT_UNSIGNED_INTEGER_ARRAY_NOT_PERMUTATION",
 		"ASSERT_UI_ARRAY_HAS_PP",
 		"ASSERT_UI_ARRAY_NOT_HAS_PP",
+		//I/O:
+		"WITH_ASSERT_STDOUT_EQUAL",
+		"WITH_ASSERT_STDERR_EQUAL",
+		"WITH_ASSERT_STREAM_OUT_EQUAL",
+		"WITH_ASSERT_EXIT_STATUS_EQUAL",
+		"WITH_ASSERT_EXIT_STATUS_NOT_EQUAL",
+		"WITH_ASSERT_SIGNAL_EQUAL",
+		//Allocations:
+		"WITH_ASSERT_MAX_ALLOCATIONS",
+		"WITH_ASSERT_MAX_BYTES_ALLOCATED",
+		//Benchmarks:
+		"ASSERT_FASTER_BY",
+		"ASSERT_COMPLEXITY",
+		"assert_latency_percentileLess",
+		"ASSERT_INSTRUCTIONS_PER_ITEM_LESS",
 		//integer type:
 		//floating_point type:
 		//bool type:
@@ -46,6 +68,21 @@ ignore = true;
 			ASSERT_UNSIGNED_INTEGER_ARRAY_NOT_IS_PARTIAL_PERMUTATION( (UI{1}), 1, (UI{2, 3, 4, 1}), 4, __LINE__, NULL);
 			ASSERT_UNSIGNED_INTEGER_ARRAY_HAS_PARTIAL_PERMUTATION( (ULI{1, 2, 3}), 3, (UC{1, 2, 3}), 3, __LINE__, NULL);
 			ASSERT_UNSIGNED_INTEGER_ARRAY_NOT_HAS_PARTIAL_PERMUTATION( (UC{1, 2, 3}), 3, (UC{1, 3, 29}), 3, __LINE__, NULL);
+			WITH_ASSERT_STDOUT_EQUAL("", __LINE__, NULL)
+			{
+				printf("(Ignored blocks are executed without capturing the output) ");
+			}END_WITH;
+			WITH_ASSERT_STDERR_EQUAL("", __LINE__, NULL){}END_WITH;
+			WITH_ASSERT_STREAM_OUT_EQUAL(stdout, "", __LINE__, NULL){}END_WITH;
+			WITH_ASSERT_EXIT_STATUS_EQUAL(1, __LINE__, NULL){ printf("(Ignored block executed)"); }END_WITH;
+			WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(0, __LINE__, NULL){ printf("(Ignored block executed)"); }END_WITH;
+			WITH_ASSERT_SIGNAL_EQUAL(6, __LINE__, NULL){ printf("(Ignored block executed)"); }END_WITH;
+			WITH_ASSERT_MAX_ALLOCATIONS(0, __LINE__, NULL){ free(malloc(1)); }END_WITH;
+			WITH_ASSERT_MAX_BYTES_ALLOCATED(0, __LINE__, NULL){ free(malloc(1)); }END_WITH;
+			ASSERT_FASTER_BY(1.2);
+			ASSERT_COMPLEXITY(linear_loop, NULL, 1, 1024, COMPLEXITY_O_1);
+			assert_latency_percentileLess(NULL, 99, 0, __LINE__, NULL);
+			ASSERT_INSTRUCTIONS_PER_ITEM_LESS(0);
 ignore = false;
 		end_module();
 		//----------------------------------------------------------------------------
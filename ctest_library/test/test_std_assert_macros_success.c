@@ -1,4 +1,14 @@
+#define _GNU_SOURCE
 #include "ctest.h"
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include "array.h"
+#include "text_formatting.h"
+#include "ctest_trace.h"
+#include "ctest_log.h"
 
 #define UI (unsigned int[])
 #define UC (unsigned char[])
@@ -10,6 +20,101 @@
 #define ASC true
 #define DSC false
 
+//Functions for CTEST_BENCH_COMPARE:
+static void loop_10(void *input)
+{
+	for(volatile int i = 0; i < 10; i++);
+}
+
+static void loop_1000(void *input)
+{
+	for(volatile int i = 0; i < 1000; i++);
+}
+
+//Functions for ASSERT_COMPLEXITY:
+static void linear_loop(void *input, size_t n)
+{
+	for(volatile size_t i = 0; i < n; i++);
+}
+
+static void quadratic_loop(void *input, size_t n)
+{
+	for(volatile size_t i = 0; i < n; i++)
+		for(volatile size_t j = 0; j < n; j++);
+}
+
+static void constant_loop(void *input, size_t n)
+{
+	for(volatile int i = 0; i < 100; i++);
+}
+
+static void merge_n_str(void *input, size_t n)
+{
+	char **str_arr = input, *saved_str = str_arr[n];
+
+	str_arr[n] = NULL;
+	free(merge_str(str_arr, ", ", "."));
+	str_arr[n] = saved_str;
+}
+
+//Function for the latency recorder:
+static void *record_latencies(void *recorder)
+{
+	for(uint64_t i = 1; i <= 1000; i++) latency_recorder_record(recorder, 10000 + i);
+	return NULL;
+}
+
+//Function for the binary log:
+static void check_binlog_result(const ctest_log_result *result, void *line_number)
+{
+	if(result->line_number == *(int *) line_number && strcmp(result->assert_name, "assert_integer_equal") == 0 && result->details == NULL) *(int *) line_number = 0;
+}
+
+//Reporter of the assert stats:
+static assert_site_stats reported_site;
+static size_t num_of_reported_sites = 0;
+static void save_assert_stats(ctest_reporter *reporter, const assert_site_stats sites[], size_t num_of_sites)
+{
+	num_of_reported_sites = num_of_sites;
+	for(size_t i = 0; i < num_of_sites; i++) if(sites[i].line_number == *(int *) reporter->data) reported_site = sites[i];
+}
+
+//Arrays of the parallel scans (too large for the stack of the macros):
+#define PARALLEL_ARR_SZ (1 << 17)
+static unsigned_integer parallel_target[PARALLEL_ARR_SZ], parallel_reference[PARALLEL_ARR_SZ];
+
+//Buffer of the digests (3 leaves and 5 bytes):
+#define DIGEST_BUFFER_SZ (3 * (1 << 20) + 5)
+static unsigned char digest_buffer[DIGEST_BUFFER_SZ];
+
+//Generator of the streaming reference: the bytes i * 131 + 7 up to *(size_t *) limit.
+static size_t generate_stream(void *buffer, size_t size, size_t offset, void *limit)
+{
+	size_t i;
+
+	for(i = 0; i < size && offset + i < *(size_t *) limit; i++) ((unsigned char *) buffer)[i] = (unsigned char) ((offset + i) * 131 + 7);
+	return i;
+}
+
+
+//Checks a TAP report like a TAP parser: the test points are numbered from 1 in order and the plan is their number. Returns the number of test points (-1 if the report is not valid).
+static int check_tap_report(const char path[])
+{
+	char line[1 << 10];
+	int num_of_points = 0, number, plan = -1;
+	bool is_valid = true;
+	FILE *file = fopen(path, "r");
+
+	if(file == NULL) return -1;
+	while(fgets(line, sizeof line, file) != NULL)
+	{
+		if(sscanf(line, "ok %d", &number) == 1 || sscanf(line, "not ok %d", &number) == 1) is_valid = is_valid && number == ++num_of_points;
+		else if(sscanf(line, "1..%d", &plan) == 1) is_valid = is_valid && plan == num_of_points;
+	}
+	fclose(file);
+	return is_valid && plan == num_of_points ? num_of_points : -1;
+}
+
 int main(void)
 {
 	char *functions_tested[] = {
@@ -25,6 +130,59 @@ int main(void)
 		"ASSERT_UI_ARRAY_NOT_IS_PP",
 		"ASSERT_UI_ARRAY_HAS_PP",
 		"ASSERT_UI_ARRAY_NOT_HAS_PP",
+		//I/O:
+		"WITH_ASSERT_STDOUT_EQUAL",
+		"WITH_ASSERT_STDERR_EQUAL",
+		"WITH_ASSERT_STREAM_OUT_EQUAL",
+		"WITH_ASSERT_EXIT_STATUS_EQUAL",
+		"WITH_ASSERT_EXIT_STATUS_NOT_EQUAL",
+		"WITH_ASSERT_SIGNAL_EQUAL",
+		//Allocations:
+		"WITH_ASSERT_MAX_ALLOCATIONS",
+		"WITH_ASSERT_MAX_BYTES_ALLOCATED",
+		"CTEST_FAIL_ON_LEAK",
+		//Fixtures:
+		"CTEST_FIXTURE_CHECKPOINT",
+		"CTEST_MODULE",
+		"get_last_module_stats",
+		//Benchmarks:
+		"CTEST_BENCH",
+		"CTEST_BENCH (baseline)",
+		"ASSERT_FASTER_BY",
+		"ASSERT_COMPLEXITY",
+		"assert_latency_percentileLess",
+		"ASSERT_INSTRUCTIONS_PER_ITEM_LESS",
+		"bench_get_perf_iterations",
+		"CTEST_BENCH (noise control)",
+		//Trace:
+		"CTEST_TRACE",
+		//Reporters:
+		"reporter_jsonl_create",
+		"reporter_junit_create",
+		"reporter_binlog_create",
+		"ctest_log_open",
+		//Verbosity:
+		"verbose = SILENT",
+		//Statistics:
+		"collect_assert_stats",
+		//Batches:
+		"CTEST_BATCH_BEGIN",
+		"CTEST_BATCH_END",
+		//Threads:
+		"assert_num_of_threads",
+		//Digests:
+		"assert_buffer_digestEqual",
+		"assert_unsigned_integerArray_digestEqual",
+		"assert_digest_equal",
+		"ASSERT_ARRAY_DIGEST_EQUAL",
+		//Streams:
+		"ctest_stream_begin",
+		"ctest_stream_feed",
+		"ctest_stream_end",
+		//Matrices:
+		"assert_unsigned_integerMatrix_equal",
+		"assert_integerMatrix_equal",
+		"assert_floating_pointMatrix_almostEqual",
 		//integer type:
 		//floating_point type:
 		//bool type:
@@ -32,6 +190,7 @@ int main(void)
 	};
 
 	//----------------------------------------------------------------------------
+	setenv("CTEST_TRACE", "test_tmp/trace.json", 0);
 	start_suite("SUCCESS", "ALL tests in this suite must be successful.", functions_tested);
 
 		/*Arrays*/
@@ -191,6 +350,771 @@ int main(void)
 		end_module();
 		//----------------------------------------------------------------------------
 
+		/*I/O*/
+		//---------------------------WITH_ASSERT_STDOUT_EQUAL-------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("WITH STDOUT-equal", "Every assert in this module must pass.", (char *[]){"WITH_ASSERT_STDOUT_EQUAL", NULL});
+
+			WITH_ASSERT_STDOUT_EQUAL("Hello world!\n", __LINE__, NULL)
+			{
+				printf("Hello world!\n");
+			}END_WITH;
+			WITH_ASSERT_STDOUT_EQUAL("", __LINE__, "Nothing is written")
+			{
+			}END_WITH;
+			WITH_ASSERT_STDOUT_EQUAL("abc123", __LINE__, "FILE and file descriptor")
+			{
+				fputs("abc", stdout);
+				fflush(stdout);
+				write(STDOUT_FILENO, "123", 3);
+			}END_WITH;
+			WITH_ASSERT_STDOUT_EQUAL("before break", __LINE__, "Early exit with break")
+			{
+				printf("before break");
+				break;
+				printf("after break");
+			}END_WITH;
+			size_t big_size = 1 << 20;
+			char *big_content = malloc(big_size + 1);
+			memset(big_content, 'x', big_size);
+			big_content[big_size] = '\0';
+			WITH_ASSERT_STDOUT_EQUAL(big_content, __LINE__, "1 MB of output")
+			{
+				fwrite(big_content, 1, big_size, stdout);
+			}END_WITH;
+			free(big_content);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------------WITH_ASSERT_STDERR_EQUAL-------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("WITH STDERR-equal", "Every assert in this module must pass.", (char *[]){"WITH_ASSERT_STDERR_EQUAL", NULL});
+
+			WITH_ASSERT_STDERR_EQUAL("Error: 42.\n", __LINE__, NULL)
+			{
+				fprintf(stderr, "Error: %d.\n", 42);
+			}END_WITH;
+			WITH_ASSERT_STDERR_EQUAL("outer\n", __LINE__, "Nested blocks")
+			{
+				fprintf(stderr, "outer\n");
+				WITH_ASSERT_STDOUT_EQUAL("inner\n", __LINE__, NULL)
+				{
+					printf("inner\n");
+				}END_WITH;
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-------------------------WITH_ASSERT_STREAM_OUT_EQUAL-----------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("WITH STREAM_OUT-equal", "Every assert in this module must pass.", (char *[]){"WITH_ASSERT_STREAM_OUT_EQUAL", NULL});
+
+			char fmem_buffer[64];
+			FILE *fmem_stream = fmemopen(fmem_buffer, sizeof fmem_buffer, "w");
+			WITH_ASSERT_STREAM_OUT_EQUAL(fmem_stream, "memory stream\n", __LINE__, "Stream without file descriptor")
+			{
+				fprintf(fmem_stream, "memory stream\n");
+			}END_WITH;
+			fclose(fmem_stream);
+			WITH_ASSERT_STREAM_OUT_EQUAL(stdout, "stdout as a stream", __LINE__, "Stream with file descriptor")
+			{
+				printf("stdout as a stream");
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Exit status and signals*/
+		//-----------------------WITH_ASSERT_EXIT_STATUS_EQUAL------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("WITH EXIT_STATUS-equal", "Every assert in this module must pass.", (char *[]){"WITH_ASSERT_EXIT_STATUS_EQUAL", NULL});
+
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_SUCCESS, __LINE__, "The end of the block is reached")
+			{
+			}END_WITH;
+			WITH_ASSERT_EXIT_STATUS_EQUAL(3, __LINE__, NULL)
+			{
+				exit(3);
+			}END_WITH;
+			T_array *empty_array = A_create_array();
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_FAILURE, __LINE__, "A_pop exits with EXIT_FAILURE")
+			{
+				fclose(stderr);
+				A_pop(empty_array);
+			}END_WITH;
+			A_delete_array(&empty_array);
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_FAILURE, __LINE__, "Assertions inside the block are merged")
+			{
+				assert_integer_equal(1, 1, __LINE__, NULL);
+				assert_integer_less(1, 2, __LINE__, NULL);
+				exit(EXIT_FAILURE);
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------WITH_ASSERT_EXIT_STATUS_NOT_EQUAL----------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("WITH EXIT_STATUS-notEqual", "Every assert in this module must pass.", (char *[]){"WITH_ASSERT_EXIT_STATUS_NOT_EQUAL", NULL});
+
+			WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(EXIT_SUCCESS, __LINE__, NULL)
+			{
+				exit(EXIT_FAILURE);
+			}END_WITH;
+			WITH_ASSERT_EXIT_STATUS_NOT_EQUAL(EXIT_FAILURE, __LINE__, "The end of the block is reached")
+			{
+				assert_bool_true(true, __LINE__, NULL);
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//--------------------------WITH_ASSERT_SIGNAL_EQUAL--------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("WITH SIGNAL-equal", "Every assert in this module must pass.", (char *[]){"WITH_ASSERT_SIGNAL_EQUAL", NULL});
+
+			WITH_ASSERT_SIGNAL_EQUAL(SIGABRT, __LINE__, NULL)
+			{
+				abort();
+			}END_WITH;
+			WITH_ASSERT_SIGNAL_EQUAL(SIGSEGV, __LINE__, "NULL dereference")
+			{
+				volatile int *null_pointer = NULL;
+				*null_pointer = 1;
+			}END_WITH;
+			WITH_ASSERT_SIGNAL_EQUAL(SIGKILL, __LINE__, "Output of assertions made before the signal is kept")
+			{
+				assert_integer_equal(1, 1, __LINE__, NULL);
+				raise(SIGKILL);
+			}END_WITH;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Crash containment*/
+		//--------------------------------CTEST_MODULE--------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		CTEST_MODULE("CONTAINED", "Every assert in this module must pass.", ((char *[]){"CTEST_MODULE", NULL}))
+		{
+			assert_integer_equal(1, 1, __LINE__, NULL);
+			WITH_ASSERT_SIGNAL_EQUAL(SIGSEGV, __LINE__, "The child is not contained")
+			{
+				volatile int *null_pointer = NULL;
+				*null_pointer = 1;
+			}END_WITH;
+		}
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------------get_last_module_stats---------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		ctest_module_stats last_module_stats = get_last_module_stats();
+		start_module("MODULE STATS", "Every assert in this module must pass. It checks the stats of the previous module.", (char *[]){"get_last_module_stats", NULL});
+
+			assert_string_equal(last_module_stats.module_name, "CONTAINED", false, __LINE__, NULL);
+			assert_integer_equal(last_module_stats.num_of_results, 2, __LINE__, NULL);
+			assert_integer_equal(last_module_stats.num_of_fails, 0, __LINE__, NULL);
+			assert_floating_point_greater(last_module_stats.wall_time, 0, __LINE__, NULL);
+			assert_floating_point_greater(last_module_stats.cpu_time, 0, __LINE__, "Includes the child of WITH_ASSERT_SIGNAL_EQUAL");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Allocations*/
+		//------------------------WITH_ASSERT_MAX_ALLOCATIONS-------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("WITH MAX-allocations", "Every assert in this module must pass.", (char *[]){"WITH_ASSERT_MAX_ALLOCATIONS", "WITH_ASSERT_MAX_BYTES_ALLOCATED", NULL});
+
+			alloc_counters_struct initial_alloc_counters = get_alloc_counters();
+			unsigned int values[] = {3, 1, 2};
+			char *allocated;
+
+			WITH_ASSERT_MAX_ALLOCATIONS(0, __LINE__, NULL)
+			{
+				for(size_t i = 1; i < ARR_SZ(values); i++) values[0] += values[i];
+			}END_WITH;
+			WITH_ASSERT_MAX_ALLOCATIONS(0, __LINE__, "The allocations of ctest are not counted")
+			{
+				ASSERT_UNSIGNED_INTEGER_ARRAY_PERMUTATION(values, 3, (UI{2, 1, 6}), 3, __LINE__, NULL);
+				allocated = merge_str((char *[]){"a", "b", NULL}, ", ", NULL);
+			}END_WITH;
+			free(allocated);
+			WITH_ASSERT_MAX_ALLOCATIONS(2, __LINE__, NULL)
+			{
+				free(malloc(10));
+				free(calloc(2, 8));
+			}END_WITH;
+			WITH_ASSERT_MAX_BYTES_ALLOCATED(26, __LINE__, NULL)
+			{
+				free(malloc(10));
+				free(calloc(2, 8));
+			}END_WITH;
+			assert_unsigned_integer_equal(get_alloc_counters().num_of_allocations - initial_alloc_counters.num_of_allocations, 4, __LINE__, NULL);
+			assert_unsigned_integer_equal(get_alloc_counters().num_of_frees - initial_alloc_counters.num_of_frees, 5, __LINE__, NULL);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-----------------------------CTEST_FAIL_ON_LEAK-----------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		char *leaked_block;
+		start_module("HEAP-leak", "Every assert in this module must pass. It leaks 1000 bytes.", (char *[]){"CTEST_FAIL_ON_LEAK", NULL});
+
+			leaked_block = malloc(1000);
+			assert_bool_true(leaked_block != NULL, __LINE__, NULL);
+
+		end_module();
+
+		ctest_module_stats leak_module_stats = get_last_module_stats();
+		suite_ctest_info.fail_on_leak = true;
+		start_module("HEAP-no leak", "Every assert in this module must pass. The leaks fail, but the heap does not grow.", (char *[]){"CTEST_FAIL_ON_LEAK", "get_last_module_stats", NULL});
+
+			assert_integer_greaterEqual(leak_module_stats.heap_delta, 1000, __LINE__, NULL);
+			assert_unsigned_integer_greater(leak_module_stats.peak_rss, 0, __LINE__, NULL);
+			free(leaked_block);
+			free(malloc(100));
+			free(merge_str((char *[]){"a", "b", NULL}, ", ", NULL));
+			ASSERT_UNSIGNED_INTEGER_ARRAY_PERMUTATION((UI{1, 2, 2}), 3, (UI{2, 1, 2}), 3, __LINE__, "The counter of the elements does not leak");
+
+		end_module();
+
+		start_module("HEAP-stream capture", "Every assert in this module must pass. The capture of a stream without descriptor does not change the heap.", (char *[]){"CTEST_FAIL_ON_LEAK", "WITH_ASSERT_STREAM_OUT_EQUAL", NULL});
+
+			static char capture_buffer[4096], capture_expected[2001];
+			FILE *capture_stream = fmemopen(capture_buffer, sizeof capture_buffer, "w");
+
+			memset(capture_expected, 'a', 2000);
+			WITH_ASSERT_STREAM_OUT_EQUAL(capture_stream, capture_expected, __LINE__, "The buffer of open_memstream is freed by ctest")
+			{
+				for(int i = 0; i < 2000; i++) fputc('a', capture_stream);
+			}END_WITH;
+			fclose(capture_stream);
+
+		end_module();
+		suite_ctest_info.fail_on_leak = false;
+
+		start_module("HEAP-stream capture stats", "Every assert in this module must pass. It checks the heap of the previous module.", (char *[]){"get_last_module_stats", NULL});
+
+			assert_integer_equal(get_last_module_stats().heap_delta, 0, __LINE__, NULL);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Benchmarks*/
+		//--------------------------------CTEST_BENCH---------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("BENCH", "Every assert in this module must pass.", (char *[]){"CTEST_BENCH", NULL});
+
+			unsigned char bench_buffer[4096];
+			const ctest_bench_stats *bench_stats;
+			memset(bench_buffer, 1, sizeof bench_buffer);
+			CTEST_BENCH("Sum of 4096 bytes")
+			{
+				unsigned sum = 0;
+				CTEST_BENCH_SET_BYTES(sizeof bench_buffer);
+				for(size_t i = 0; i < sizeof bench_buffer; i++) sum += bench_buffer[i];
+				ctest_do_not_optimize(sum);
+			}
+			bench_stats = get_last_bench_stats();
+			assert_string_equal(bench_stats->name, "Sum of 4096 bytes", false, __LINE__, NULL);
+			assert_unsigned_integer_equal(bench_stats->num_of_samples, bench_config.num_of_samples, __LINE__, NULL);
+			assert_unsigned_integer_greater(bench_stats->iterations_per_sample, 0, __LINE__, NULL);
+			assert_floating_point_lessEqual(bench_stats->min, bench_stats->median, __LINE__, NULL);
+			assert_floating_point_lessEqual(bench_stats->median, bench_stats->p99, __LINE__, NULL);
+			assert_floating_point_greater(bench_stats->bytes_per_second, 0, __LINE__, NULL);
+			assert_floating_point_lessEqual(bench_stats->items_per_second, 0, __LINE__, "Items were not set");
+
+			CTEST_BENCH("Empty body")
+			{
+				ctest_clobber_memory();
+			}
+			assert_unsigned_integer_greater(get_last_bench_stats()->iterations_per_sample, 1, __LINE__, "Calibrated");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------------CTEST_BENCH (baseline)---------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("BENCH-baseline", "Every assert in this module must pass. The second run is faster than the baseline.", (char *[]){"CTEST_BENCH (baseline)", NULL});
+
+			bench_config.baseline_path = "test_tmp/bench_baseline.txt";
+			bench_config.update_baseline = true;
+			CTEST_BENCH("Loop")
+			{
+				for(volatile int i = 0; i < 1000; i++);
+			}
+			bench_config.update_baseline = false;
+			CTEST_BENCH("Loop")
+			{
+				for(volatile int i = 0; i < 10; i++);
+			}
+			bench_config.baseline_path = NULL;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//------------------------------ASSERT_FASTER_BY------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("BENCH-compare", "Every assert in this module must pass.", (char *[]){"ASSERT_FASTER_BY", NULL});
+
+			CTEST_BENCH_COMPARE(loop_1000, loop_10, NULL);
+			ASSERT_FASTER_BY(2);
+			ASSERT_FASTER_BY(1);
+			assert_floating_point_lessEqual(get_last_bench_comparison()->speedup_low, get_last_bench_comparison()->speedup, __LINE__, NULL);
+			assert_floating_point_lessEqual(get_last_bench_comparison()->speedup, get_last_bench_comparison()->speedup_high, __LINE__, NULL);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-----------------------------ASSERT_COMPLEXITY------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("BENCH-complexity", "Every assert in this module must pass.", (char *[]){"ASSERT_COMPLEXITY", NULL});
+
+			char *str_arr[(1 << 14) + 1];
+			for(size_t i = 0; i < ARR_SZ(str_arr); i++) str_arr[i] = "ab";
+
+			ASSERT_COMPLEXITY(constant_loop, NULL, 16, 1 << 14, COMPLEXITY_O_1);
+			ASSERT_COMPLEXITY(linear_loop, NULL, 256, 1 << 16, COMPLEXITY_O_N);
+			assert_integer_equal(COMPLEXITY_O_N, get_last_complexity_fit()->best_fit, __LINE__, NULL);
+			ASSERT_COMPLEXITY(linear_loop, NULL, 256, 1 << 16, COMPLEXITY_O_N3);
+			ASSERT_COMPLEXITY(quadratic_loop, NULL, 64, 1024, COMPLEXITY_O_N2);
+			assert_integer_equal(COMPLEXITY_O_N2, get_last_complexity_fit()->best_fit, __LINE__, NULL);
+			ASSERT_COMPLEXITY(merge_n_str, str_arr, 64, 1 << 14, COMPLEXITY_O_N);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-----------------------assert_latency_percentileLess------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("LATENCY", "Every assert in this module must pass.", (char *[]){"assert_latency_percentileLess", NULL});
+
+			ctest_latency_recorder *recorder = latency_recorder_create();
+			pthread_t threads[4];
+
+			for(uint64_t i = 1; i <= 1000; i++) latency_recorder_record(recorder, i);
+			assert_latency_percentileLess(recorder, 50, 506, __LINE__, NULL);
+			assert_latency_percentileLess(recorder, 99, 1000, __LINE__, NULL);
+			assert_latency_percentileLess(recorder, 100, 1001, __LINE__, NULL);
+			assert_unsigned_integer_lessEqual(500, latency_recorder_percentile(recorder, 50), __LINE__, NULL);
+			assert_unsigned_integer_equal(1, latency_recorder_percentile(recorder, 0), __LINE__, NULL);
+
+			//Per-thread histograms are merged:
+			for(size_t i = 0; i < ARR_SZ(threads); i++) pthread_create(&threads[i], NULL, record_latencies, recorder);
+			for(size_t i = 0; i < ARR_SZ(threads); i++) pthread_join(threads[i], NULL);
+			assert_unsigned_integer_equal(5000, latency_recorder_count(recorder), __LINE__, NULL);
+			assert_latency_percentileLess(recorder, 20, 1010, __LINE__, NULL); //1000 is in the bucket [1000, 1003].
+			assert_latency_percentileLess(recorder, 99.9, 11100, __LINE__, NULL);
+
+			latency_recorder_reset(recorder);
+			CTEST_LATENCY_MEASURE(recorder)
+			{
+				for(volatile int i = 0; i < 1000; i++);
+			}
+			assert_unsigned_integer_equal(1, latency_recorder_count(recorder), __LINE__, NULL);
+			assert_latency_percentileLess(recorder, 99, 1000000000, __LINE__, NULL);
+			latency_recorder_delete(recorder);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------ASSERT_INSTRUCTIONS_PER_ITEM_LESS----------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		bench_config.perf_counters = true;
+		start_module("BENCH-perf counters", "Every assert in this module must pass. The hardware counters may not be available.", (char *[]){"ASSERT_INSTRUCTIONS_PER_ITEM_LESS", "bench_get_perf_iterations", NULL});
+
+			ctest_bench_stats discarded_stats = {.num_of_samples = 4, .num_of_discarded = 2, .iterations_per_sample = 10};
+			char *touched_pages;
+			CTEST_BENCH("Loop of 100 items")
+			{
+				CTEST_BENCH_SET_ITEMS(100);
+				for(volatile int i = 0; i < 100; i++);
+			}
+			assert_bool_true(get_last_bench_stats()->has_perf_counters, __LINE__, NULL);
+			if(get_last_bench_stats()->perf.is_available[PERF_COUNTER_INSTRUCTIONS])
+				ASSERT_INSTRUCTIONS_PER_ITEM_LESS(1000);
+			assert_floating_point_almostEqual(bench_get_perf_iterations(&discarded_stats), 60, 1e-9, __LINE__, "The counters also run during the discarded samples");
+			touched_pages = malloc(1 << 20);
+			memset(touched_pages, 1, 1 << 20);
+			free(touched_pages);
+
+		end_module();
+		bench_config.perf_counters = false;
+
+		ctest_module_stats perf_module_stats = get_last_module_stats();
+		start_module("BENCH-perf module stats", "Every assert in this module must pass. It checks the counters of the previous module.", (char *[]){"ASSERT_INSTRUCTIONS_PER_ITEM_LESS", NULL});
+
+			assert_bool_true(!perf_module_stats.perf.is_available[PERF_COUNTER_PAGE_FAULTS] || perf_module_stats.perf.values[PERF_COUNTER_PAGE_FAULTS] >= 256, __LINE__, "1 MiB was touched");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//------------------------------Noise control mode----------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("BENCH-noise control", "Every assert in this module must pass. The thread is pinned during each measure.", (char *[]){"CTEST_BENCH (noise control)", "ASSERT_FASTER_BY", "ASSERT_COMPLEXITY", NULL});
+
+			cpu_set_t affinity_before, affinity_after;
+
+			sched_getaffinity(0, sizeof affinity_before, &affinity_before);
+			bench_config.noise_control = true;
+			CTEST_BENCH("Loop (noise control)")
+			{
+				for(volatile int i = 0; i < 100; i++);
+			}
+			assert_integer_greater(get_last_bench_stats()->cpu, -1, __LINE__, "the thread was pinned");
+			assert_unsigned_integer_equal(get_last_bench_stats()->num_of_samples, bench_config.num_of_samples, __LINE__, NULL);
+			assert_unsigned_integer_lessEqual(get_last_bench_stats()->num_of_discarded, bench_config.num_of_samples, __LINE__, NULL);
+			assert_integer_equal(bench_noise_get_cpu(), -1, __LINE__, "the thread is not pinned after the benchmark");
+
+			CTEST_BENCH_COMPARE(loop_1000, loop_10, NULL);
+			ASSERT_FASTER_BY(2);
+			assert_integer_greater(get_last_bench_comparison()->cpu, -1, __LINE__, NULL);
+			assert_unsigned_integer_lessEqual(get_last_bench_comparison()->num_of_discarded, bench_config.num_of_samples, __LINE__, NULL);
+
+			ASSERT_COMPLEXITY(linear_loop, NULL, 256, 1 << 16, COMPLEXITY_O_N);
+			bench_config.noise_control = false;
+
+			sched_getaffinity(0, sizeof affinity_after, &affinity_after);
+			assert_bool_true(CPU_EQUAL(&affinity_before, &affinity_after), __LINE__, "the affinity was restored");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------------------CTEST_TRACE--------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("TRACE", "Every assert in this module must pass. The events recorded so far are written to the trace.", (char *[]){"CTEST_TRACE", NULL});
+
+			static char trace_str[1 << 16];
+			char *trace_header = "[\n{\"name\":\"process_name\",\"ph\":\"M\"";
+			FILE *trace_file;
+
+			assert_bool_true(trace_is_enabled(), __LINE__, NULL);
+			trace_flush();
+			trace_file = fopen(getenv("CTEST_TRACE"), "r");
+			if(trace_file != NULL)
+			{
+				fread(trace_str, 1, sizeof trace_str - 1, trace_file);
+				fclose(trace_file);
+			}
+			assert_integer_equal(strncmp(trace_str, trace_header, strlen(trace_header)), 0, __LINE__, NULL);
+			assert_bool_true(strstr(trace_str, "\"name\":\"BENCH-noise control\",\"cat\":\"module\",\"ph\":\"X\"") != NULL, __LINE__, NULL);
+			assert_bool_true(strstr(trace_str, "\"cat\":\"benchmark\"") != NULL, __LINE__, NULL);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//---------------------------------REPORTERS----------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("REPORTERS", "Every assert in this module must pass. The reports of the first asserts are read back.", (char *[]){"reporter_jsonl_create", "reporter_junit_create", NULL});
+
+			static char report_str[1 << 12];
+			ctest_reporter *jsonl_reporter = reporter_jsonl_create("test_tmp/report.jsonl");
+			ctest_reporter *junit_reporter = reporter_junit_create("test_tmp/report.xml");
+			int report_line;
+			FILE *report_file;
+
+			reporter_add(jsonl_reporter);
+			reporter_add(junit_reporter);
+			report_line = __LINE__; assert_integer_equal(1, 1, __LINE__, NULL);
+			reporter_delete(jsonl_reporter);
+			reporter_delete(junit_reporter);
+
+			report_file = fopen("test_tmp/report.jsonl", "r");
+			assert_bool_true(report_file != NULL && fgets(report_str, sizeof report_str, report_file) != NULL, __LINE__, NULL);
+			if(report_file != NULL) fclose(report_file);
+			assert_bool_true(strstr(report_str, "{\"event\":\"assert\",\"suite\":\"SUCCESS\",\"module\":\"REPORTERS\"") == report_str, __LINE__, NULL);
+			assert_bool_true(strstr(report_str, "\"status\":\"success\",\"assert\":\"assert_integer_equal\"") != NULL, __LINE__, NULL);
+			assert_integer_equal(atoi(strstr(report_str, "\"line\":") + strlen("\"line\":")), report_line, __LINE__, NULL);
+
+			memset(report_str, 0, sizeof report_str);
+			report_file = fopen("test_tmp/report.xml", "r");
+			if(report_file != NULL)
+			{
+				fread(report_str, 1, sizeof report_str - 1, report_file);
+				fclose(report_file);
+			}
+			assert_bool_true(strstr(report_str, "<testsuite name=\"REPORTERS\" package=\"SUCCESS\" tests=\"0000000001\"") != NULL, __LINE__, NULL);
+			assert_bool_true(strstr(report_str, "<testcase name=\"assert_integer_equal (line ") != NULL, __LINE__, NULL);
+			assert_bool_true(strstr(report_str, "</testsuite>\n</testsuites>\n") != NULL, __LINE__, NULL);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//----------------------------------BINLOG------------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		ctest_reporter *binlog_reporter = reporter_binlog_create("test_tmp/report.bin");
+
+		reporter_add(binlog_reporter);
+		start_module("BINLOG-WRITE", "Every assert in this module must pass. Its results are read back by the module BINLOG.", (char *[]){"reporter_binlog_create", NULL});
+
+			assert_integer_equal(1, 1, __LINE__, NULL);
+			assert_bool_true(true, __LINE__, "read back");
+			report_line = __LINE__; assert_integer_equal(2, 2, __LINE__, NULL);
+
+		end_module();
+		reporter_delete(binlog_reporter);
+
+		start_module("BINLOG", "Every assert in this module must pass. The binary log of the module BINLOG-WRITE is read back.", (char *[]){"ctest_log_open", NULL});
+
+			ctest_log *binlog = ctest_log_open("test_tmp/report.bin");
+			ctest_log_module binlog_module;
+			size_t binlog_index;
+
+			assert_integer_equal(ctest_log_get_num_of_modules(binlog), 1, __LINE__, NULL);
+			binlog_index = ctest_log_find_module(binlog, "BINLOG-WRITE");
+			assert_integer_equal(binlog_index, 0, __LINE__, NULL);
+			assert_integer_equal(ctest_log_find_module(binlog, "BINLOG"), LOG_NOT_FOUND, __LINE__, NULL);
+			binlog_module = ctest_log_get_module(binlog, binlog_index);
+			assert_string_equal((char *) binlog_module.suite_name, "SUCCESS", false, __LINE__, NULL);
+			assert_integer_equal(binlog_module.num_of_results, 3, __LINE__, NULL);
+			assert_integer_equal(binlog_module.num_of_fails, 0, __LINE__, NULL);
+			assert_integer_equal(ctest_log_for_each_result(binlog, binlog_index, REPORT_SUCCESS, check_binlog_result, &report_line), 3, __LINE__, NULL);
+			assert_integer_equal(report_line, 0, __LINE__, "the last result was read back");
+			assert_integer_equal(ctest_log_for_each_result(binlog, binlog_index, REPORT_FAIL, check_binlog_result, &report_line), 0, __LINE__, NULL);
+			ctest_log_close(binlog);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//----------------------------------SILENT------------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		ctest_reporter *silent_tap_reporter = reporter_tap_create("test_tmp/silent.tap");
+
+		reporter_add(silent_tap_reporter);
+		verbose = SILENT;
+		start_module("SILENT", "Every assert in this module must pass. The successes are only counted, beyond MAX_RESULTS.", (char *[]){"verbose = SILENT", NULL});
+
+			WITH_ASSERT_STDOUT_EQUAL("", __LINE__, "Nothing is written for a success")
+			{
+				for(int i = 0; i <= MAX_RESULTS; i++) assert_integer_equal(i, i, __LINE__, NULL);
+			}END_WITH;
+			assert_integer_equal(ctest_info.num_of_results, MAX_RESULTS + 2, __LINE__, NULL);
+			assert_integer_equal(ctest_info.num_of_fails, 0, __LINE__, NULL);
+			assert_string_equal(ctest_info.progress, "", false, __LINE__, "The progress is not kept");
+
+		end_module();
+		verbose = HIGH;
+
+		start_module("SILENT-TAP", "Every assert in this module must pass. The successes only counted by the module SILENT have no test point.", (char *[]){"verbose = SILENT", "reporter_tap_create", NULL});
+
+			assert_integer_equal(1, 1, __LINE__, "test point 1");
+			assert_integer_equal(2, 2, __LINE__, "test point 2");
+			reporter_delete(silent_tap_reporter);
+			assert_integer_equal(check_tap_report("test_tmp/silent.tap"), 2, __LINE__, "Numbered from 1, with the plan 1..2");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		//-------------------------------ASSERT STATS---------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("ASSERT STATS", "Every assert in this module must pass. The statistics of one site are collected and reported.", (char *[]){"collect_assert_stats", NULL});
+
+			ctest_reporter stats_reporter = {.on_assert_stats = save_assert_stats, .data = &report_line};
+
+			collect_assert_stats = true;
+			assert_stats_start_suite();
+			report_line = __LINE__; for(int i = 0; i < 4; i++) assert_integer_equal(i, i, __LINE__, NULL);
+			reporter_remove(reporter_console());
+			reporter_add(&stats_reporter);
+			assert_stats_end_suite();
+			reporter_remove(&stats_reporter);
+			reporter_add(reporter_console());
+			collect_assert_stats = false;
+			assert_integer_equal(num_of_reported_sites, 1, __LINE__, NULL);
+			assert_string_equal((char *) reported_site.assert_name, "assert_integer_equal", false, __LINE__, NULL);
+			assert_integer_equal(reported_site.num_of_hits, 4, __LINE__, NULL);
+			assert_integer_equal(reported_site.num_of_passes, 4, __LINE__, NULL);
+			assert_integer_equal(reported_site.num_of_fails + reported_site.num_of_ignored, 0, __LINE__, NULL);
+			assert_bool_true(reported_site.total_ns > 0, __LINE__, "The time inside the assertions is measured");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Batches*/
+		//------------------------------CTEST_BATCH_BEGIN-----------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("CTEST_BATCH", "Every assert in this module must pass. Each batch is one result.", (char *[]){"CTEST_BATCH_BEGIN", "CTEST_BATCH_END", NULL});
+
+			CTEST_BATCH_BEGIN();
+			for(int i = 0; i < 3 * CTEST_BATCH_SIZE + 1; i++)
+			{
+				BATCH_EXPECT_UNSIGNED_INTEGER_EQUAL(i * 2, i + i, __LINE__);
+				BATCH_EXPECT_UNSIGNED_INTEGER_GREATER(i + 1, i, __LINE__);
+			}
+			CTEST_BATCH_END(__LINE__, "Automatic flushes");
+			CTEST_BATCH_BEGIN();
+			for(int i = -10; i < 10; i++) BATCH_EXPECT_INTEGER_LESS(i, 10, __LINE__);
+			BATCH_EXPECT_INTEGER_GREATER_EQUAL(-1, -2, __LINE__);
+			BATCH_EXPECT_UNSIGNED_INTEGER_NOT_EQUAL(-1, 1, __LINE__);
+			BATCH_EXPECT_UNSIGNED_INTEGER_LESS_EQUAL(1, 1, __LINE__);
+			BATCH_EXPECT_INTEGER_NOT_EQUAL(-1, 1, __LINE__);
+			CTEST_BATCH_END(__LINE__, "Signed comparisons");
+			CTEST_BATCH_BEGIN();
+			CTEST_BATCH_END(__LINE__, "An empty batch passes");
+			assert_integer_equal(ctest_info.num_of_results, 3, __LINE__, NULL);
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Threads*/
+		//----------------------------PARALLEL ARRAY SCANS----------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("PARALLEL ARRAY SCANS", "Every assert in this module must pass. The arrays are scanned by 4 threads.", (char *[]){"assert_num_of_threads", NULL});
+
+			assert_num_of_threads = 4;
+			assert_parallel_threshold = 1000;
+			for(size_t i = 0; i < PARALLEL_ARR_SZ; i++) parallel_target[i] = parallel_reference[i] = i;
+			assert_unsigned_integerArray_equal(parallel_target, PARALLEL_ARR_SZ, parallel_reference, PARALLEL_ARR_SZ, __LINE__, NULL);
+			assert_unsigned_integerArray_sorted(parallel_target, PARALLEL_ARR_SZ, ASC, __LINE__, NULL);
+			parallel_reference[PARALLEL_ARR_SZ - 1] = 0;
+			assert_unsigned_integerArray_notEqual(parallel_target, PARALLEL_ARR_SZ, parallel_reference, PARALLEL_ARR_SZ, __LINE__, "The difference is in the last chunk");
+			parallel_target[PARALLEL_ARR_SZ / 2] = 0;
+			assert_unsigned_integerArray_notSorted(parallel_target, PARALLEL_ARR_SZ, ASC, __LINE__, "The inversion is in a middle chunk");
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_SUCCESS, __LINE__, "The pool is created again in a child process")
+			{
+				assert_unsigned_integerArray_notEqual(parallel_target, PARALLEL_ARR_SZ, parallel_reference, PARALLEL_ARR_SZ, __LINE__, NULL);
+			}END_WITH;
+			assert_num_of_threads = 0;
+			assert_parallel_threshold = 1 << 20;
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Digests*/
+		//----------------------------------DIGESTS-----------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("DIGESTS", "Every assert in this module must pass. The digests do not depend on the threads nor on the updates.", (char *[]){"assert_buffer_digestEqual", "assert_unsigned_integerArray_digestEqual", "assert_digest_equal", "ASSERT_ARRAY_DIGEST_EQUAL", NULL});
+
+			ctest_digest digest;
+
+			assert_buffer_digestEqual("abc", 3, "8f7aaae8f97cd64d417ad8ffc542ef16", __LINE__, NULL);
+			assert_buffer_digestEqual("abc", 3, "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD", __LINE__, "SHA-256 of \"abc\"");
+			ASSERT_ARRAY_DIGEST_EQUAL((UI{1, 2, 3}), 3, "e4256095772c36db08ab411ef42d4b30", __LINE__, NULL);
+			assert_unsigned_integerArray_digestEqual((unsigned_integer[]){1, 2, 3}, 3, "e2e2033ae7e19d680599d4eb0a1359a2b48ec5baac75066c317fbf85159c54ef", __LINE__, NULL);
+			for(size_t i = 0; i < DIGEST_BUFFER_SZ; i++) digest_buffer[i] = (unsigned char) (i * 131 + 7);
+			assert_num_of_threads = 4;
+			assert_buffer_digestEqual(digest_buffer, DIGEST_BUFFER_SZ, "6e950863342def267b83988538e30839", __LINE__, "The leaves are hashed by 4 threads");
+			assert_buffer_digestEqual(digest_buffer, DIGEST_BUFFER_SZ, "75f7c4c5d93e2936828412115054a33bf774523cf18ea7bfdee5e4e259909e39", __LINE__, NULL);
+			assert_num_of_threads = 0;
+			digest_init(&digest, DIGEST_FAST128);
+			for(size_t i = 0; i < DIGEST_BUFFER_SZ; i += 100003) digest_update(&digest, &digest_buffer[i], DIGEST_BUFFER_SZ - i < 100003 ? DIGEST_BUFFER_SZ - i : 100003);
+			assert_digest_equal(&digest, "6e950863342def267b83988538e30839", __LINE__, "Incremental updates");
+			digest_init(&digest, DIGEST_SHA256);
+			assert_digest_equal(&digest, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", __LINE__, "Empty input");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Streams*/
+		//--------------------------------CTEST_STREAM--------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("CTEST_STREAM", "Every assert in this module must pass. The chunks are compared with each kind of reference.", (char *[]){"ctest_stream_begin", "ctest_stream_feed", "ctest_stream_end", NULL});
+
+			size_t stream_size = DIGEST_BUFFER_SZ;
+			FILE *stream_file = fopen("test_tmp/stream.bin", "wb");
+
+			fwrite(digest_buffer, 1, DIGEST_BUFFER_SZ, stream_file);
+			fclose(stream_file);
+			ctest_stream_begin(stream_source_memory("Hello, streaming world!", 23));
+			ctest_stream_feed("Hello, ", 7);
+			ctest_stream_feed("", 0);
+			ctest_stream_feed("streaming world!", 16);
+			assert_integer_equal(ctest_stream_get_mismatch_offset(), STREAM_NO_MISMATCH, __LINE__, NULL);
+			ctest_stream_end(__LINE__, "Reference in memory");
+			ctest_stream_begin(stream_source_file("test_tmp/stream.bin"));
+			for(size_t i = 0; i < DIGEST_BUFFER_SZ; i += 65536) ctest_stream_feed(&digest_buffer[i], DIGEST_BUFFER_SZ - i < 65536 ? DIGEST_BUFFER_SZ - i : 65536);
+			ctest_stream_end(__LINE__, "Reference file");
+			ctest_stream_begin(stream_source_generator(generate_stream, &stream_size));
+			for(size_t i = 0; i < DIGEST_BUFFER_SZ; i += 100003) ctest_stream_feed(&digest_buffer[i], DIGEST_BUFFER_SZ - i < 100003 ? DIGEST_BUFFER_SZ - i : 100003);
+			ctest_stream_end(__LINE__, "Generated reference");
+			ctest_stream_begin(stream_source_memory(NULL, 0));
+			ctest_stream_end(__LINE__, "Empty stream");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Matrices*/
+		//----------------------------------MATRICES----------------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		start_module("MATRICES", "Every assert in this module must pass. The views are compared without copies.", (char *[]){"assert_unsigned_integerMatrix_equal", "assert_integerMatrix_equal", "assert_floating_pointMatrix_almostEqual", NULL});
+
+			integer row_major[] = {1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11, -12};
+			integer col_major[] = {1, 5, 9, -2, -6, -10, 3, 7, 11, -4, -8, -12};
+			unsigned_integer buffer[] = {1, 2, 3, 0, 4, 5, 6, 0, 7, 8, 9, 0}; //3 x 3 matrix with a leading dimension of 4.
+			floating_point matrix[100 * 70], transposed[70 * 100];
+
+			assert_integerMatrix_equal(MATRIX_VIEW(row_major, 3, 4, 4), MATRIX_STRIDED_VIEW(col_major, 3, 4, 1, 3), __LINE__, "Row-major and column-major");
+			assert_integerMatrix_equal(MATRIX_VIEW(&row_major[5], 2, 2, 4), MATRIX_VIEW(((integer []){-6, 7, -10, 11}), 2, 2, 2), __LINE__, "Submatrix");
+			assert_unsigned_integerMatrix_equal(MATRIX_COLUMN_VIEW(buffer, 3, 4, 1), MATRIX_VIEW(((unsigned_integer []){2, 5, 8}), 3, 1, 1), __LINE__, "Column of a row-major buffer");
+			assert_unsigned_integerMatrix_equal(MATRIX_VIEW(buffer, 0, 3, 4), MATRIX_VIEW(buffer, 0, 3, 4), __LINE__, "Empty matrices");
+			for(size_t i = 0; i < 100; i++)
+				for(size_t j = 0; j < 70; j++)
+				{
+					matrix[i * 70 + j] = i * 0.5 - j * 0.25;
+					transposed[j * 100 + i] = matrix[i * 70 + j] + 1e-10;
+				}
+			assert_floating_pointMatrix_almostEqual(MATRIX_VIEW(matrix, 100, 70, 70), MATRIX_STRIDED_VIEW(transposed, 100, 70, 1, 100), 1e-9, __LINE__, "Several blocks");
+
+		end_module();
+		//----------------------------------------------------------------------------
+
+		/*Fixtures*/
+		//--------------------------CTEST_FIXTURE_CHECKPOINT--------------------------
+		//----------------------------------------------------------------------------
+		//Tests that will be successful:
+		unsigned int fixture[] = {1, 2, 3, 4, 5};
+		size_t fixture_size = sizeof fixture / sizeof *fixture;
+		CTEST_FIXTURE_CHECKPOINT();
+
+		if(start_module("FIXTURE CHECKPOINT-1", "Every assert in this module must pass. It changes the fixture.", (char *[]){"CTEST_FIXTURE_CHECKPOINT", NULL}))
+		{
+			ASSERT_UNSIGNED_INTEGER_ARRAY_EQUAL(fixture, fixture_size, (UI{1, 2, 3, 4, 5}), 5, __LINE__, NULL);
+			fixture[0] = 100;
+			fixture_size = 0;
+			assert_unsigned_integer_equal(fixture[0], 100, __LINE__, NULL);
+		}
+		end_module();
+
+		if(start_module("FIXTURE CHECKPOINT-2", "Every assert in this module must pass. The fixture is not changed by the previous module.", (char *[]){"CTEST_FIXTURE_CHECKPOINT", NULL}))
+		{
+			assert_unsigned_integer_equal(fixture_size, 5, __LINE__, NULL);
+			ASSERT_UNSIGNED_INTEGER_ARRAY_EQUAL(fixture, fixture_size, (UI{1, 2, 3, 4, 5}), 5, __LINE__, NULL);
+			WITH_ASSERT_EXIT_STATUS_EQUAL(EXIT_SUCCESS, __LINE__, "WITH blocks work inside checkpointed modules")
+			{
+				assert_unsigned_integer_equal(fixture[4], 5, __LINE__, NULL);
+			}END_WITH;
+		}
+		end_module();
+		//----------------------------------------------------------------------------
+
 	end_suite();
 	//----------------------------------------------------------------------------
 
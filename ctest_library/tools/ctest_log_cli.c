@@ -0,0 +1,124 @@
+/**
+ * Title: CTEST LOG CLI
+ */
+
+/**
+ * Description: This file contains the command line tool ctest_log, which reads
+ * a binary result log (see ctest_log.h) written with CTEST_BINLOG:
+ *
+ * 	ctest_log LOG                     prints the summary of each suite;
+ * 	ctest_log LOG modules             prints the counters of each module;
+ * 	ctest_log LOG failures [MODULE]   prints the fails and errors (of MODULE).
+ *
+ * It is built by 'make tools' (build/ctest_lib/bin/ctest_log).
+ */
+
+//Includes:
+#include "ctest.h"
+#include "ctest_log.h"
+#include "text_formatting.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Local auxiliary functions:
+static void print_usage(char program[]);
+static void print_modules(const ctest_log *log);
+static size_t print_failures(const ctest_log *log, size_t index);
+static void print_failure(const ctest_log_result *result, void *arg);
+
+
+int main(int argc, char *argv[])
+{
+	ctest_log *log;
+	size_t index, num_of_failures = 0;
+
+	if(argc < 2 || argc > 4)
+	{
+		print_usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	log = ctest_log_open(argv[1]);
+
+	if(argc == 2) ctest_log_print_summary(log);
+	else if(strcmp(argv[2], "modules") == 0 && argc == 3) print_modules(log);
+	else if(strcmp(argv[2], "failures") == 0)
+	{
+		if(argc == 4)
+		{
+			index = ctest_log_find_module(log, argv[3]);
+			if(index == LOG_NOT_FOUND)
+			{
+				fprintf(stderr, "Error: the log has no module '%s'.\n", argv[3]);
+				ctest_log_close(log);
+				return EXIT_FAILURE;
+			}
+			num_of_failures = print_failures(log, index);
+		}
+		else for(index = 0; index < ctest_log_get_num_of_modules(log); index++) num_of_failures += print_failures(log, index);
+		fprintf(stdout, "%zu failure(s).\n", num_of_failures);
+	}
+	else
+	{
+		print_usage(argv[0]);
+		ctest_log_close(log);
+		return EXIT_FAILURE;
+	}
+	ctest_log_close(log);
+	return EXIT_SUCCESS;
+}
+
+
+
+//Definitions of the local auxiliary functions:
+static void print_usage(char program[])
+{
+	fprintf(stderr, "Usage: %s LOG [modules | failures [MODULE]]\n", program);
+}
+
+
+static void print_modules(const ctest_log *log)
+{
+	ctest_log_module module;
+	char time_str[32];
+	size_t i;
+
+	for(i = 0; i < ctest_log_get_num_of_modules(log); i++)
+	{
+		module = ctest_log_get_module(log, i);
+		fprintf(stdout, "%s/%s: cases: %d fails: %d ignored: %d wall: %s\n", module.suite_name != NULL ? module.suite_name : "",
+				module.module_name, module.num_of_results, module.num_of_fails, module.num_of_ignored,
+				TF_time_to_str(module.wall_time, time_str, sizeof time_str));
+	}
+}
+
+
+static size_t print_failures(const ctest_log *log, size_t index)
+/**
+ * Description: This function prints the fails and the errors of the module
+ * 'index' and returns their number. The module is read only if it has some.
+ */
+{
+	ctest_log_module module = ctest_log_get_module(log, index);
+	size_t num_of_failures = 0;
+
+	if(module.num_of_fails == 0) return 0;
+	fprintf(stdout, "MODULE: %s\n", module.module_name);
+	ctest_log_for_each_result(log, index, '\0', print_failure, &num_of_failures);
+	return num_of_failures;
+}
+
+
+static void print_failure(const ctest_log_result *result, void *arg)
+/**
+ * Description: This function prints 'result' if it is a fail or an error, and
+ * counts it in '*arg' (a size_t).
+ */
+{
+	if(result->status != REPORT_FAIL && result->status != REPORT_ERROR) return;
+	(*(size_t *) arg)++;
+	fprintf(stdout, "\nFAILURE MESSAGE (LINE %d):\n<assert name> --> %s\n<std msg>     --> %s\n", result->line_number,
+			result->assert_name, result->std_message != NULL ? result->std_message : "");
+	if(result->custom_message != NULL) fprintf(stdout, "<custom msg>  --> %s\n", result->custom_message);
+	fprintf(stdout, "<details>     -->\n%s\n\n", result->details != NULL ? result->details : "");
+}